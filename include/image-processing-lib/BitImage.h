@@ -0,0 +1,85 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#ifndef BITIMAGE_H
+#define BITIMAGE_H
+#include <cstdint>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+
+/**
+ * Binary image storing 64 pixels per word. Every row starts at a new word, pixel y of a row is bit y % 64
+ * of word y / 64, and the bits after the last pixel of a row are always zero, so rows can be combined
+ * and compared a word at a time.
+ */
+class BitImage {
+    int rows_ = 0;
+    int cols_ = 0;
+    int wordsPerRow_ = 0;
+    std::vector<uint64_t> words_;
+
+public:
+    static constexpr int WORD_BITS = 64;
+
+    BitImage() = default;
+
+    /**
+     * Create an image with every pixel set to background.
+     */
+    BitImage(int rows, int cols);
+
+    /**
+     * Pack a binary image.
+     * @param image CV_8UC1 image, every non-zero pixel is foreground
+     * @return Packed image
+     */
+    static BitImage fromMat(const cv::Mat &image);
+
+    /**
+     * Unpack the image.
+     * @return CV_8UC1 image with foreground pixels set to 255 and background pixels to 0
+     */
+    [[nodiscard]] cv::Mat toMat() const;
+
+    [[nodiscard]] int rows() const {
+        return rows_;
+    }
+
+    [[nodiscard]] int cols() const {
+        return cols_;
+    }
+
+    [[nodiscard]] int wordsPerRow() const {
+        return wordsPerRow_;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return rows_ == 0 || cols_ == 0;
+    }
+
+    [[nodiscard]] uint64_t *row(const int x) {
+        return words_.data() + static_cast<size_t>(x) * wordsPerRow_;
+    }
+
+    [[nodiscard]] const uint64_t *row(const int x) const {
+        return words_.data() + static_cast<size_t>(x) * wordsPerRow_;
+    }
+
+    [[nodiscard]] bool get(const int x, const int y) const {
+        return row(x)[y / WORD_BITS] >> (y % WORD_BITS) & 1;
+    }
+
+    void set(int x, int y, bool value);
+
+    /**
+     * Bits of the last word of a row which hold pixels, the others have to stay zero.
+     */
+    [[nodiscard]] uint64_t lastWordMask() const;
+
+    bool operator==(const BitImage &other) const = default;
+};
+
+
+#endif //BITIMAGE_H
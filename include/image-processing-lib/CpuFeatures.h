@@ -0,0 +1,27 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+
+namespace CpuFeatures {
+    /**
+     * Widest instruction set the vectorized kernels of the library can use.
+     */
+    enum class SimdLevel {
+        SCALAR,
+        SSE4,
+        AVX2
+    };
+
+    /**
+     * Get the widest instruction set supported by the processor. Detected once per process.
+     * @return Supported instruction set (SCALAR on processors other than x86)
+     */
+    SimdLevel simdLevel();
+}
+
+
+#endif //CPUFEATURES_H
@@ -0,0 +1,45 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#ifndef FFTKERNELS_H
+#define FFTKERNELS_H
+
+
+/**
+ * Radix-4 stage kernels of the single precision FFT, one per instruction set, each in its own translation unit
+ * compiled with the matching target flags. The kernels work on interleaved complex floats (the layout of
+ * std::complex<float>). Like StencilRowKernels.h, the header holds no inline code, so including it in those
+ * translation units emits nothing the linker could also pick for code running on other processors.
+ */
+namespace FFTKernels {
+    /**
+     * Kernel running one radix-4 stage of the Stockham FFT (see FourierProcessor::BasicFFTPlan).
+     * In complex values, group g and offset k < stride read source[g * stride + k + r * groupCount * stride]
+     * for r = 0..3 and write target[g * stride * 4 + k + r * stride]. Twiddles of the stage are stored as
+     * twiddles[(r - 1) * stride + k], r = 1..3.
+     */
+    using Radix4Function = void (*)(const float *source, float *target, const float *twiddles, int groupCount,
+                                    int stride, bool inverse);
+
+    /**
+     * Radix-4 kernel of plain scalar code (defined in FFTScalar.cpp).
+     * @return Kernel
+     */
+    Radix4Function scalarRadix4Function();
+
+    /**
+     * Radix-4 kernel compiled for SSE4.1 (defined in FFTSse4.cpp).
+     * @return Kernel or nullptr if the library was built without SSE4.1 support
+     */
+    Radix4Function sse4Radix4Function();
+
+    /**
+     * Radix-4 kernel compiled for AVX2 (defined in FFTAvx2.cpp).
+     * @return Kernel or nullptr if the library was built without AVX2 support
+     */
+    Radix4Function avx2Radix4Function();
+}
+
+
+#endif //FFTKERNELS_H
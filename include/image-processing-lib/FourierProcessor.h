@@ -5,10 +5,132 @@
 #ifndef FOURIERPROCESSOR_H
 #define FOURIERPROCESSOR_H
 #include <opencv2/opencv.hpp>
+#include <complex>
+#include <memory>
 #include <numbers>
+#include <vector>
 
 
 namespace FourierProcessor {
+    /**
+     * Floating-point precision of the fast Fourier transforms.
+     */
+    enum class FFTPrecision {
+        FLOAT, // CV_32FC2 spectra, radix-4 stages are vectorized (SSE4.1 or AVX2 when the processor supports it)
+        DOUBLE // CV_64FC2 spectra
+    };
+
+    /**
+     * Precomputed 1D FFT of one length and direction. Lengths whose prime factors are all 2, 3, 5 or 7
+     * use a mixed-radix Stockham FFT (no bit-reversal, every stage reads one buffer and writes the other)
+     * with a twiddle table per stage, the others Bluestein's algorithm, which turns the transform into
+     * a circular convolution of a fast length with a precomputed chirp spectrum.
+     * Plans are immutable, so one plan can be executed by many threads at once.
+     * @tparam T float or double
+     */
+    template<typename T>
+    class BasicFFTPlan {
+        int length_;
+        bool inverse_;
+        std::vector<int> radices_;
+        // Twiddles of a stage are stored as [(r - 1) * stride + k], so every radix reads them contiguously
+        std::vector<std::complex<T> > twiddles_;
+
+        int convolutionLength_ = 0;
+        std::shared_ptr<const BasicFFTPlan> forwardConvolution_;
+        std::shared_ptr<const BasicFFTPlan> inverseConvolution_;
+        std::vector<std::complex<T> > chirp_;
+        std::vector<std::complex<T> > chirpSpectrum_;
+
+        void mixedRadix(std::complex<T> *data, std::complex<T> *scratch) const;
+
+        void bluestein(std::complex<T> *data, std::complex<T> *scratch) const;
+
+    public:
+        /**
+         * Build a plan. Prefer get, which builds every plan only once per process.
+         * @param length Transform length
+         * @param inverse Use positive exponents (the result is not divided by the length)
+         */
+        BasicFFTPlan(int length, bool inverse);
+
+        /**
+         * Get the plan of a length and direction from the process-wide cache, building it on the first request.
+         * Safe to call from many threads.
+         * @param length Transform length
+         * @param inverse Use positive exponents (the result is not divided by the length)
+         * @return Shared plan
+         */
+        static std::shared_ptr<const BasicFFTPlan> get(int length, bool inverse);
+
+        [[nodiscard]] int length() const;
+
+        [[nodiscard]] bool isInverse() const;
+
+        /**
+         * Number of values the scratch buffer passed to execute has to hold.
+         */
+        [[nodiscard]] int scratchSize() const;
+
+        /**
+         * Transform values in place.
+         * @param data Values to transform
+         * @param scratch Buffer of at least scratchSize() values, owned by the calling thread
+         */
+        void execute(std::complex<T> *data, std::complex<T> *scratch) const;
+    };
+
+    using FFTPlan = BasicFFTPlan<double>;
+    using FFTPlanFloat = BasicFFTPlan<float>;
+
+    /**
+     * Non-redundant half of the spectrum of a real image. The spectrum of a real image is Hermitian
+     * (F(-u, -v) = conj(F(u, v))), so only the columns 0 to cols / 2 are stored.
+     * The zero frequency is at (0, 0), the spectrum is not shifted.
+     */
+    struct HalfSpectrum {
+        cv::Mat values; // CV_32FC2 or CV_64FC2 of size rows x (cols / 2 + 1)
+        int cols = 0; // Number of columns of the transformed image
+    };
+
+    /**
+     * Kind of frequencies a filter passes.
+     */
+    enum class FilterType {
+        LOW_PASS,
+        HIGH_PASS,
+        BAND_PASS,
+        BAND_CUT,
+        DIRECTIONAL_HIGH_PASS // High-pass restricted to a wedge of frequency directions
+    };
+
+    /**
+     * Frequency response of a radial filter (given for the low-pass filter, D is the distance
+     * from the zero frequency and D0 the cutoff).
+     */
+    enum class FilterShape {
+        IDEAL, // 1 if D < D0, else 0 (rings around edges)
+        BUTTERWORTH, // 1 / (1 + (D / D0)^(2 * order))
+        GAUSSIAN // exp(-D^2 / (2 * D0^2))
+    };
+
+    /**
+     * Filter of a spectrum. High-pass filters have the response 1 - low-pass, band-pass filters
+     * the product of a high-pass and a low-pass and band-cut filters 1 - band-pass. Directional high-pass
+     * filters pass the high-pass response only in the wedge of frequency directions perpendicular
+     * to the edges of the chosen angle (and its mirror, so the image stays real).
+     * High-pass, band-cut and directional filters always pass the zero frequency (mean brightness).
+     */
+    struct FrequencyFilter {
+        FilterType type = FilterType::LOW_PASS;
+        FilterShape shape = FilterShape::IDEAL;
+        int cutoff = 0; // Cutoff of low-pass and high-pass filters, lower cutoff of band filters
+        int upperCutoff = 0; // Upper cutoff of band filters
+        int order = 2; // Order of Butterworth filters
+        double angle = 0; // Edge angle of directional filters in degrees, counter-clockwise from horizontal
+        double angularWidth = 0; // Width of the wedge of directional filters in degrees
+    };
+
     /**
      * Visualize Fourier transform result.
      * @param fourierImage Fourier transform result
@@ -17,55 +139,242 @@ namespace FourierProcessor {
     void visualizeFourier(cv::Mat fourierImage, const std::string &fourierVisPath);
 
     /**
-     * Compute Fourier transform.
+     * Visualize the whole spectrum of a real image, with the zero frequency in the center.
+     * @param spectrum Half spectrum of the image
+     * @param fourierVisPath Path to save visualization
+     */
+    void visualizeFourier(const HalfSpectrum &spectrum, const std::string &fourierVisPath);
+
+    /**
+     * Compute Fourier transform by direct summation, separably over the rows and the columns
+     * (O(rows * cols * (rows + cols))). Exact for every size, serves as the reference of the fast transforms.
      * @param image Input image
      * @return Fourier transformed image
      */
     cv::Mat fourierTransform(cv::Mat image);
 
     /**
-     * Compute Fast Fourier Transform.
+     * Find the smallest length not less than the given one whose prime factors are all 2, 3, 5 or 7,
+     * i.e. which the mixed-radix FFT handles without Bluestein's algorithm.
+     * @param length Minimum length
+     * @return Fast transform length
+     */
+    int fastFFTLength(int length);
+
+    /**
+     * Compute an unshifted, unnormalized 2D Fast Fourier Transform in place. Any size is supported:
+     * lengths with prime factors 2, 3, 5 and 7 use a mixed-radix FFT and the others Bluestein's algorithm.
+     * @param complexImage CV_32FC2 or CV_64FC2 image to transform
+     * @param inverse Compute the inverse transform (without dividing by the number of pixels)
+     */
+    void fastFourierTransform2D(cv::Mat &complexImage, bool inverse);
+
+    /**
+     * Compute Fast Fourier Transform. The zero frequency is moved to (rows / 2, cols / 2).
      * @param image Input image
-     * @return FFT transformed image
+     * @param padToFastSize Pad the image with zeros to the next fast length in both dimensions (see fastFFTLength)
+     * @param precision Precision of the transform
+     * @return FFT transformed image (CV_32FC2 or CV_64FC2 depending on the precision)
      */
-    cv::Mat fastFourierTransform(cv::Mat image);
+    cv::Mat fastFourierTransform(cv::Mat image, bool padToFastSize = false,
+                                 FFTPrecision precision = FFTPrecision::DOUBLE);
+
+    /**
+     * Compute the half spectrum of an image with a real-to-complex FFT. Pairs of rows are transformed
+     * as the real and imaginary part of one complex row and separated using the Hermitian symmetry,
+     * and only the stored half of the columns is transformed, which halves the work and the memory
+     * of fastFourierTransform.
+     * @param image Input image
+     * @param padToFastSize Pad the image with zeros to the next fast length in both dimensions (see fastFFTLength)
+     * @param precision Precision of the transform
+     * @return Half spectrum of the image
+     */
+    HalfSpectrum realFastFourierTransform(const cv::Mat &image, bool padToFastSize = false,
+                                          FFTPrecision precision = FFTPrecision::DOUBLE);
+
+    /**
+     * Compute the half spectra of the channels of an image in one batch. The two-for-one row packing
+     * of realFastFourierTransform runs over the rows of all channels, so a row pair can span two channels,
+     * and the columns of all channels are transformed together.
+     * @param channels CV_8UC1 channels of the same size
+     * @param padToFastSize Pad the channels with zeros to the next fast length in both dimensions
+     * @param precision Precision of the transform
+     * @return Half spectrum of every channel
+     */
+    std::vector<HalfSpectrum> realFastFourierTransform(const std::vector<cv::Mat> &channels,
+                                                       bool padToFastSize = false,
+                                                       FFTPrecision precision = FFTPrecision::DOUBLE);
+
+    /**
+     * Reconstruct the whole shifted spectrum (as returned by fastFourierTransform) from a half spectrum.
+     * @param spectrum Half spectrum of an image
+     * @return Spectrum of the same precision with the zero frequency at (rows / 2, cols / 2)
+     */
+    cv::Mat expandHalfSpectrum(const HalfSpectrum &spectrum);
+
+    /**
+     * Get the gains of a filter for a spectrum layout. A mask is computed once per filter and layout
+     * and cached for the whole process. The cache holds at most 256 MiB of masks and is emptied when
+     * a new mask would exceed that.
+     * @param filter Filter to evaluate
+     * @param rows Number of rows of the spectrum
+     * @param cols Number of columns of the transformed image
+     * @param halfSpectrum Layout of a HalfSpectrum (otherwise of a shifted spectrum)
+     * @return Shared CV_64FC1 mask of the size of the spectrum (must not be modified)
+     */
+    cv::Mat filterMask(const FrequencyFilter &filter, int rows, int cols, bool halfSpectrum);
+
+    /**
+     * Multiply a shifted spectrum by the cached mask of a filter.
+     * @param fourierImage Shifted CV_32FC2 or CV_64FC2 spectrum
+     * @param filter Filter to apply
+     * @return Filtered spectrum
+     */
+    cv::Mat applyFilter(const cv::Mat &fourierImage, const FrequencyFilter &filter);
+
+    /**
+     * Multiply a half spectrum by the cached mask of a filter.
+     */
+    HalfSpectrum applyFilter(const HalfSpectrum &spectrum, const FrequencyFilter &filter);
 
     /**
      * Apply low-pass filter in the frequency domain.
      * @param fourierImage Fourier transformed image
      * @param lowPassBandSize Filter cutoff frequency
+     * @param shape Frequency response of the filter
+     * @param order Order of the Butterworth filter
      * @return Filtered image
      */
-    cv::Mat fftLowPass(const cv::Mat &fourierImage, int lowPassBandSize);
+    cv::Mat fftLowPass(const cv::Mat &fourierImage, int lowPassBandSize, FilterShape shape = FilterShape::IDEAL,
+                       int order = 2);
+
+    /**
+     * Apply the filter of fftLowPass to a half spectrum.
+     */
+    HalfSpectrum fftLowPass(const HalfSpectrum &spectrum, int lowPassBandSize,
+                            FilterShape shape = FilterShape::IDEAL, int order = 2);
 
     /**
      * Apply high-pass filter in the frequency domain.
      * @param fourierImage Fourier transformed image
      * @param highPassBandSize Filter cutoff frequency
+     * @param shape Frequency response of the filter
+     * @param order Order of the Butterworth filter
      * @return Filtered image
      */
-    cv::Mat fftHighPass(cv::Mat fourierImage, int highPassBandSize);
+    cv::Mat fftHighPass(cv::Mat fourierImage, int highPassBandSize, FilterShape shape = FilterShape::IDEAL,
+                        int order = 2);
+
+    /**
+     * Apply the filter of fftHighPass to a half spectrum.
+     */
+    HalfSpectrum fftHighPass(const HalfSpectrum &spectrum, int highPassBandSize,
+                             FilterShape shape = FilterShape::IDEAL, int order = 2);
 
     /**
      * Apply band-pass filter in the frequency domain.
      * @param fourierImage Fourier transformed image
      * @param lowCut Lower cutoff frequency
      * @param highCut Higher cutoff frequency
+     * @param shape Frequency response of the filter
+     * @param order Order of the Butterworth filter
      * @return Filtered image
      */
-    cv::Mat fftBandPass(const cv::Mat &fourierImage, int lowCut, int highCut);
+    cv::Mat fftBandPass(const cv::Mat &fourierImage, int lowCut, int highCut, FilterShape shape = FilterShape::IDEAL,
+                        int order = 2);
+
+    /**
+     * Apply the filter of fftBandPass to a half spectrum.
+     */
+    HalfSpectrum fftBandPass(const HalfSpectrum &spectrum, int lowCut, int highCut,
+                             FilterShape shape = FilterShape::IDEAL, int order = 2);
 
     /**
      * Apply band-cut filter in the frequency domain.
      * @param fourierImage Fourier transformed image
      * @param lowPass Lower cutoff frequency
      * @param highPass Higher cutoff frequency
+     * @param shape Frequency response of the filter
+     * @param order Order of the Butterworth filter
      * @return Filtered image
      */
-    cv::Mat fftBandCut(cv::Mat fourierImage, int lowPass, int highPass);
+    cv::Mat fftBandCut(cv::Mat fourierImage, int lowPass, int highPass, FilterShape shape = FilterShape::IDEAL,
+                       int order = 2);
 
     /**
-     * Modify phase in frequency domain.
+     * Apply the filter of fftBandCut to a half spectrum.
+     */
+    HalfSpectrum fftBandCut(const HalfSpectrum &spectrum, int lowPass, int highPass,
+                            FilterShape shape = FilterShape::IDEAL, int order = 2);
+
+    /**
+     * Apply a directional high-pass filter, which keeps the high frequencies of the edges running
+     * at an angle and removes the others.
+     * @param fourierImage Fourier transformed image
+     * @param highPassBandSize Filter cutoff frequency
+     * @param angle Edge angle in degrees, counter-clockwise from horizontal (0 keeps horizontal edges)
+     * @param angularWidth Width of the wedge of passed frequency directions in degrees
+     * @param shape Frequency response of the high-pass part
+     * @param order Order of the Butterworth filter
+     * @return Filtered image
+     */
+    cv::Mat fftHighPassDirection(const cv::Mat &fourierImage, int highPassBandSize, double angle, double angularWidth,
+                                 FilterShape shape = FilterShape::IDEAL, int order = 2);
+
+    /**
+     * Apply the filter of fftHighPassDirection to a half spectrum.
+     */
+    HalfSpectrum fftHighPassDirection(const HalfSpectrum &spectrum, int highPassBandSize, double angle,
+                                      double angularWidth, FilterShape shape = FilterShape::IDEAL, int order = 2);
+
+    /**
+     * Apply directional high-pass filters of several angles to the channels of an image. The channels are
+     * transformed once in one batch, every orientation is filtered with its cached wedge mask and all of them
+     * are transformed back in one batch.
+     * @param channels CV_8UC1 channels of the same size
+     * @param highPassBandSize Filter cutoff frequency
+     * @param angles Edge angles in degrees (see fftHighPassDirection)
+     * @param angularWidth Width of the wedges in degrees
+     * @param shape Frequency response of the high-pass part
+     * @param order Order of the Butterworth filter
+     * @param precision Precision of the transforms
+     * @return Filtered channels of every angle
+     */
+    std::vector<std::vector<cv::Mat> > highPassDirections(const std::vector<cv::Mat> &channels, int highPassBandSize,
+                                                          const std::vector<double> &angles, double angularWidth,
+                                                          FilterShape shape = FilterShape::IDEAL, int order = 2,
+                                                          FFTPrecision precision = FFTPrecision::DOUBLE);
+
+    /**
+     * Compute the impulse response of a filter designed for an image size, truncated to a square around its
+     * center. The filter is sampled in the frequencies of the image on a grid of twice the kernel size
+     * (or on the image grid when it is smaller) and transformed back.
+     * @param filter Filter to evaluate
+     * @param imageSize Size of the image the cutoffs refer to
+     * @param radius Kernel radius, limited to (size - 1) / 2 in every dimension; a kernel covering the whole
+     * image is the exact impulse response of the whole-image filter
+     * @return CV_64FC1 kernel of size (2 * radius + 1) x (2 * radius + 1)
+     */
+    cv::Mat filterKernel(const FrequencyFilter &filter, cv::Size imageSize, int radius);
+
+    /**
+     * Apply a filter to an image tile by tile, so the memory of the spectra depends on the tile size and not
+     * on the image size. The truncated impulse response of the filter (see filterKernel) is circularly convolved
+     * with the image by overlap-save, the result equals that convolution computed on the whole image.
+     * The radius has to cover the impulse response of the filter, which grows with image size / cutoff,
+     * so Butterworth and Gaussian filters are much better suited than ideal ones.
+     * @param image CV_8UC1 image
+     * @param filter Filter to apply
+     * @param kernelRadius Radius of the truncated impulse response (the halo of the tiles)
+     * @param tileSize Maximum side of a tile without the halo
+     * @param precision Precision of the transforms
+     * @return Filtered image
+     */
+    cv::Mat tiledFilter(const cv::Mat &image, const FrequencyFilter &filter, int kernelRadius, int tileSize = 512,
+                        FFTPrecision precision = FFTPrecision::DOUBLE);
+
+    /**
+     * Modify phase in frequency domain. The phase ramp is applied from one precomputed table per axis.
      * @param fourierImage Fourier transformed image
      * @param verticalShift Phase modification parameter k (vertical offset)
      * @param horizontalShift Phase modification parameter l (horizontal offset)
@@ -74,7 +383,67 @@ namespace FourierProcessor {
     cv::Mat fftPhaseModifying(cv::Mat fourierImage, int verticalShift, int horizontalShift);
 
     /**
-     * Compute inverse Fourier transform.
+     * Translate the image of a shifted spectrum by a possibly fractional offset (Fourier shift theorem).
+     * The phase ramp is applied from one precomputed table per axis. The image is translated circularly,
+     * pixels leaving one side enter on the opposite side.
+     * @param fourierImage Shifted CV_32FC2 or CV_64FC2 spectrum
+     * @param verticalShift Offset in rows (positive moves the image down)
+     * @param horizontalShift Offset in columns (positive moves the image right)
+     * @return Spectrum of the translated image
+     */
+    cv::Mat fftTranslate(const cv::Mat &fourierImage, double verticalShift, double horizontalShift);
+
+    /**
+     * Translate the image of a half spectrum (see the shifted spectrum overload).
+     */
+    HalfSpectrum fftTranslate(const HalfSpectrum &spectrum, double verticalShift, double horizontalShift);
+
+    /**
+     * Translate an image circularly by a possibly fractional offset through its half spectrum.
+     * @param image Input image
+     * @param verticalShift Offset in rows (positive moves the image down)
+     * @param horizontalShift Offset in columns (positive moves the image right)
+     * @param precision Precision of the transforms
+     * @return Translated image
+     */
+    cv::Mat translate(const cv::Mat &image, double verticalShift, double horizontalShift,
+                      FFTPrecision precision = FFTPrecision::DOUBLE);
+
+    /**
+     * Location of a template in an image.
+     */
+    struct TemplateMatch {
+        int x = 0; // Row of the top left corner of the matched window
+        int y = 0; // Column of the top left corner of the matched window
+        double score = 0; // Normalized cross-correlation of the window with the template
+    };
+
+    /**
+     * Compute the normalized cross-correlation of a template with every window of an image. The correlations
+     * come from one FFT of the image and the zero mean template packed into one complex image and one inverse FFT
+     * of their cross-power spectrum, the window norms from integral images, so the cost does not depend on
+     * the template size.
+     * @param image CV_8UC1 image
+     * @param templ CV_8UC1 template which is not constant and not larger than the image
+     * @return CV_64FC1 map of size (image.rows - templ.rows + 1) x (image.cols - templ.cols + 1), the value
+     * at (x, y) is the score in [-1, 1] of the window with the top left corner (x, y) (0 for constant windows)
+     */
+    cv::Mat matchTemplate(const cv::Mat &image, const cv::Mat &templ);
+
+    /**
+     * Find the best matches in a response map of matchTemplate. Matches are local maxima taken in descending
+     * order of their score, skipping the ones whose window overlaps the window of a better match.
+     * @param response Response map returned by matchTemplate
+     * @param templateSize Size of the matched template
+     * @param maxCount Maximum number of matches
+     * @param minScore Minimum score of a match
+     * @return Matches sorted by descending score
+     */
+    std::vector<TemplateMatch> findMatches(const cv::Mat &response, cv::Size templateSize, int maxCount,
+                                           double minScore = 0);
+
+    /**
+     * Compute inverse Fourier transform by direct summation (see fourierTransform).
      * @param fourierImage Vector of Fourier transformed image components
      * @return Reconstructed spatial domain image
      */
@@ -83,9 +452,29 @@ namespace FourierProcessor {
     /**
     * Compute inverse Fast Fourier transform.
     * @param fourierImage Vector of Fourier transformed image components
+    * @param outputSize Size of the reconstructed image, used to crop the zero padding added by fastFourierTransform
+    * (the whole transform is reconstructed when empty)
     * @return Reconstructed spatial domain image
     */
-    cv::Mat inverseFastFourierTransform(const cv::Mat &fourierImage);
+    cv::Mat inverseFastFourierTransform(const cv::Mat &fourierImage, cv::Size outputSize = cv::Size());
+
+    /**
+     * Compute the inverse of realFastFourierTransform with a complex-to-real FFT.
+     * @param spectrum Half spectrum of an image
+     * @param outputSize Size of the reconstructed image, used to crop the zero padding added by
+     * realFastFourierTransform (the whole transform is reconstructed when empty)
+     * @return Reconstructed spatial domain image
+     */
+    cv::Mat inverseRealFastFourierTransform(const HalfSpectrum &spectrum, cv::Size outputSize = cv::Size());
+
+    /**
+     * Compute the inverse of the batched realFastFourierTransform.
+     * @param spectra Half spectra of the same type and size
+     * @param outputSize Size of the reconstructed channels (the whole transform is reconstructed when empty)
+     * @return Reconstructed channels
+     */
+    std::vector<cv::Mat> inverseRealFastFourierTransform(const std::vector<HalfSpectrum> &spectra,
+                                                         cv::Size outputSize = cv::Size());
 }
 
 
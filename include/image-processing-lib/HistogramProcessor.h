@@ -35,6 +35,39 @@ namespace HistogramProcessor {
     cv::Mat histogramEqualization(const cv::Mat &image, const std::array<uint, UCHAR_MAX + 1> &imageHistogram, int gMax,
                              int gMin);
 
+    /**
+     * Create a lookup table performing histogram equalization.
+     * @param imageHistogram Histogram of the image the table will be applied to
+     * @param gMax Maximum output intensity
+     * @param gMin Minimum output intensity
+     * @return Lookup table of the histogram equalization
+     */
+    std::array<uchar, UCHAR_MAX + 1> equalizationLookupTable(const std::array<uint, UCHAR_MAX + 1> &imageHistogram,
+                                                             int gMax, int gMin);
+
+    /**
+     * Compute histogram of the image after mapping it through a lookup table without touching the image.
+     * @param imageHistogram Histogram of the image before the mapping
+     * @param lookupTable Lookup table applied to the image
+     * @return Histogram of the mapped image
+     */
+    std::array<uint, UCHAR_MAX + 1> transformHistogram(const std::array<uint, UCHAR_MAX + 1> &imageHistogram,
+                                                       const std::array<uchar, UCHAR_MAX + 1> &lookupTable);
+
+    /**
+     * Find the lowest intensity present in the histogram.
+     * @param imageHistogram Input a histogram array
+     * @return Minimum intensity (UCHAR_MAX for an empty histogram)
+     */
+    int minimumIntensity(const std::array<uint, UCHAR_MAX + 1> &imageHistogram);
+
+    /**
+     * Find the highest intensity present in the histogram.
+     * @param imageHistogram Input a histogram array
+     * @return Maximum intensity (0 for an empty histogram)
+     */
+    int maximumIntensity(const std::array<uint, UCHAR_MAX + 1> &imageHistogram);
+
     /**
      * Calculate mean value from histogram.
      * @param imageHistogram Input a histogram array
@@ -4,10 +4,11 @@
 
 #ifndef MORPHOLOGICALPROCESSOR_H
 #define MORPHOLOGICALPROCESSOR_H
-#include <unordered_map>
+#include <span>
 #include <vector>
 #include <opencv2/opencv.hpp>
 
+#include "BitImage.h"
 #include "input-processing-lib/Masks.h"
 
 
@@ -21,6 +22,19 @@ using Masks::hmtMaskMap;
 using Masks::hmtComplementMaskMap;
 
 namespace MorphologicalProcessor {
+    /**
+     * Statistics of a single connected component.
+     */
+    struct ComponentStats {
+        int area = 0;
+        int top = 0;
+        int left = 0;
+        int height = 0;
+        int width = 0;
+        double centroidX = 0; // row of the centroid
+        double centroidY = 0; // column of the centroid
+    };
+
     /**
      * Compute complement (negative) of binary image.
      * @param image Input binary image
@@ -48,41 +62,41 @@ namespace MorphologicalProcessor {
      * Apply dilation morphological operation.
      * @param image Input binary image
      * @param maskNumber Structural element number
-     * @param maskMapping Map of available structural elements
+     * @param maskMapping Set of available structural elements
      * @return Dilated image
      */
     cv::Mat dilation(cv::Mat image, int maskNumber,
-                     const std::unordered_map<int, std::vector<std::vector<FieldType> > > &maskMapping = maskMap);
+                     std::span<const Masks::StructuringElement> maskMapping = maskMap);
 
     /**
      * Apply erosion morphological operation.
      * @param image Input binary image
      * @param maskNumber Structural element number
-     * @param maskMapping Map of available structural elements
+     * @param maskMapping Set of available structural elements
      * @return Eroded image
      */
     cv::Mat erosion(cv::Mat image, int maskNumber,
-                    const std::unordered_map<int, std::vector<std::vector<FieldType> > > &maskMapping = maskMap);
+                    std::span<const Masks::StructuringElement> maskMapping = maskMap);
 
     /**
      * Apply opening morphological operation.
      * @param image Input binary image
      * @param maskNumber Structural element number
-     * @param maskMapping Map of available structural elements
+     * @param maskMapping Set of available structural elements
      * @return Opened image
      */
     cv::Mat opening(const cv::Mat &image, int maskNumber,
-                    const std::unordered_map<int, std::vector<std::vector<FieldType> > > &maskMapping = maskMap);
+                    std::span<const Masks::StructuringElement> maskMapping = maskMap);
 
     /**
      * Apply closing morphological operation.
      * @param image Input binary image
      * @param maskNumber Structural element number
-     * @param maskMapping Map of available structural elements
+     * @param maskMapping Set of available structural elements
      * @return Closed image
      */
     cv::Mat closing(const cv::Mat &image, int maskNumber,
-                    const std::unordered_map<int, std::vector<std::vector<FieldType> > > &maskMapping = maskMap);
+                    std::span<const Masks::StructuringElement> maskMapping = maskMap);
 
     /**
      * Apply hit-or-miss transform.
@@ -91,6 +105,67 @@ namespace MorphologicalProcessor {
      * @return Transformed image
      */
     cv::Mat hmt(const cv::Mat &image, int maskNumber);
+
+    /**
+     * Compute complement of a packed binary image.
+     */
+    BitImage complement(const BitImage &image);
+
+    /**
+     * Compute the union of two packed binary images of the same size.
+     */
+    BitImage imagesUnion(const BitImage &image1, const BitImage &image2);
+
+    /**
+     * Check if two packed binary images are equal.
+     */
+    bool areEqual(const BitImage &image1, const BitImage &image2);
+
+    /**
+     * Apply dilation to a packed binary image. Every active field of the structural element shifts whole rows
+     * of words and the shifted rows are combined with OR, 64 pixels per operation. The cv::Mat overloads of
+     * the morphological operations use the packed ones for images holding only the values 0 and 255.
+     * @param image Input binary image
+     * @param maskNumber Structural element number
+     * @param maskMapping Set of available structural elements
+     * @return Dilated image
+     */
+    BitImage dilation(const BitImage &image, int maskNumber,
+                      std::span<const Masks::StructuringElement> maskMapping = maskMap);
+
+    /**
+     * Apply erosion to a packed binary image (see the packed dilation, the shifted rows are combined with AND).
+     */
+    BitImage erosion(const BitImage &image, int maskNumber,
+                     std::span<const Masks::StructuringElement> maskMapping = maskMap);
+
+    /**
+     * Apply opening to a packed binary image.
+     */
+    BitImage opening(const BitImage &image, int maskNumber,
+                     std::span<const Masks::StructuringElement> maskMapping = maskMap);
+
+    /**
+     * Apply closing to a packed binary image.
+     */
+    BitImage closing(const BitImage &image, int maskNumber,
+                     std::span<const Masks::StructuringElement> maskMapping = maskMap);
+
+    /**
+     * Apply hit-or-miss transform to a packed binary image.
+     */
+    BitImage hmt(const BitImage &image, int maskNumber);
+
+    /**
+     * Label 8-connected components of a binary image (every non-zero pixel is foreground).
+     * Horizontal strips are scanned in parallel with a decision table on the already visited neighbours,
+     * each strip recording label equivalences in its own range of a shared union-find forest.
+     * The strips are then merged across their borders and relabeled in a second pass.
+     * @param image Input binary image
+     * @param stats Output statistics of the components, stats[label - 1] describes the component with the label
+     * @return CV_32SC1 label map with consecutive component labels starting at 1 (0 means background)
+     */
+    cv::Mat connectedComponents(const cv::Mat &image, std::vector<ComponentStats> &stats);
 }
 
 
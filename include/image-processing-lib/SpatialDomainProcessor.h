@@ -5,9 +5,32 @@
 #ifndef IMAGEPROCESSOR_H
 #define IMAGEPROCESSOR_H
 
+#include <array>
+#include <istream>
 #include <opencv2/opencv.hpp>
 
 namespace SpatialDomainProcessor {
+    /**
+     * Resampling filter used when resizing an image.
+     */
+    enum class InterpolationMethod {
+        NEAREST,
+        BILINEAR,
+        BICUBIC,
+        LANCZOS,
+        AREA
+    };
+
+    /**
+     * Extrapolation of pixels lying outside the image.
+     */
+    enum class BorderType {
+        CONSTANT, // zero outside the image
+        REPLICATE, // aaa|abcd|ddd
+        REFLECT, // cb|abcd|cb
+        WRAP // cd|abcd|ab
+    };
+
     /**
     * Modify the brightness of an image by a constant factor.
     * @param image image to modify
@@ -40,6 +63,112 @@ namespace SpatialDomainProcessor {
      */
     cv::Mat negative(const cv::Mat &image);
 
+    /**
+     * Create a lookup table which maps every intensity to itself.
+     * @return identity lookup table
+     */
+    std::array<uchar, UCHAR_MAX + 1> identityLookupTable();
+
+    /**
+     * Create a lookup table of the brightness modification.
+     * @param modVal brightness modification value (see modifyBrightness)
+     * @return lookup table of the brightness modification
+     */
+    std::array<uchar, UCHAR_MAX + 1> brightnessLookupTable(int modVal);
+
+    /**
+     * Create a lookup table of the linear contrast stretching.
+     * @param modVal contrast stretch modification value (see modifyContrastLinear)
+     * @param min minimum intensity of the image the table will be applied to
+     * @param max maximum intensity of the image the table will be applied to
+     * @return lookup table of the linear contrast stretching
+     */
+    std::array<uchar, UCHAR_MAX + 1> contrastLinearLookupTable(int modVal, int min, int max);
+
+    /**
+     * Create a lookup table of the gamma contrast correction.
+     * @param modVal floating-point value indicating value of gamma
+     * @return lookup table of the gamma contrast correction
+     */
+    std::array<uchar, UCHAR_MAX + 1> contrastGammaLookupTable(float modVal);
+
+    /**
+     * Create a lookup table of the negative.
+     * @return lookup table of the negative
+     */
+    std::array<uchar, UCHAR_MAX + 1> negativeLookupTable();
+
+    /**
+     * Compose two lookup tables into one.
+     * @param first lookup table applied first
+     * @param second lookup table applied to the result of the first one
+     * @return lookup table equivalent to applying first and then second
+     */
+    std::array<uchar, UCHAR_MAX + 1> composeLookupTables(const std::array<uchar, UCHAR_MAX + 1> &first,
+                                                         const std::array<uchar, UCHAR_MAX + 1> &second);
+
+    /**
+     * Map every pixel of an image through a lookup table in a single pass.
+     * @param image image to transform
+     * @param lookupTable table of output intensities indexed by input intensity
+     * @return transformed image
+     */
+    cv::Mat applyLookupTable(const cv::Mat &image, const std::array<uchar, UCHAR_MAX + 1> &lookupTable);
+
+    /**
+     * Element of the symmetry group of a rectangle: an optional transposition followed by
+     * optional reversals of the row and column order. Every flip and right-angle rotation is one of the eight
+     * elements, and a sequence of them composes into a single element, so it can be materialized in one pass.
+     */
+    struct GeometricTransform {
+        bool transpose = false;
+        bool flipRows = false;
+        bool flipCols = false;
+
+        /**
+         * Compose with a transform applied after this one.
+         * @param next transform applied to the result of this one
+         * @return transform equivalent to applying this one and then next
+         */
+        [[nodiscard]] GeometricTransform then(const GeometricTransform &next) const;
+
+        /**
+         * Whether the transform leaves every image unchanged.
+         */
+        [[nodiscard]] bool isIdentity() const;
+
+        /**
+         * Clockwise rotation by a multiple of 90 degrees.
+         * @param degrees rotation angle (can be negative)
+         * @return rotation transform
+         */
+        static GeometricTransform rotation(int degrees);
+    };
+
+    /**
+     * Materialize a geometric transform. Transforms swapping the axes use a cache-blocked transpose kernel,
+     * the others copy whole rows.
+     * @param image to be transformed
+     * @param transform geometric transform to apply
+     * @return transformed image
+     */
+    cv::Mat applyGeometricTransform(const cv::Mat &image, const GeometricTransform &transform);
+
+    /**
+     * Transpose the image (swap rows with columns).
+     * @param image to be transposed
+     * @return transposed image
+     */
+    cv::Mat transpose(const cv::Mat &image);
+
+    /**
+     * Rotate the image clockwise by a multiple of 90 degrees.
+     * @param image to be rotated
+     * @param degrees rotation angle (can be negative)
+     * @return rotated image
+     */
+    cv::Mat rotate(const cv::Mat &image, int degrees);
+
     /**
      * Flip the image horizontally.
      * @param image to be flipped
@@ -62,15 +191,38 @@ namespace SpatialDomainProcessor {
     cv::Mat flipDiagonally(const cv::Mat &image);
 
     /**
-     * Resize an image by a factor.
+     * Resize an image by a factor. Apart from the nearest neighbour method, the image is resampled
+     * separably (rows, then columns) with precomputed coefficient tables. The interpolation filters use
+     * fixed-point weights and are widened by 1 / factor when shrinking, so they also average out the detail
+     * which cannot be represented. The area method sums the covered source area exactly in double precision.
      * @param image to be resized
      * @param factor of the resize operation
+     * @param method resampling filter
      * @return image of size = oldImage * factor
      */
-    cv::Mat resize(cv::Mat image, float factor);
+    cv::Mat resize(cv::Mat image, float factor, InterpolationMethod method = InterpolationMethod::NEAREST);
 
     /**
-     * Apply a midpoint filter.
+     * Compute the minimum of every square window (separable van Herk/Gil-Werman algorithm,
+     * cost does not depend on the kernel size). Windows are clipped to the image.
+     * @param image to apply filter to
+     * @param kernelSize side of the window
+     * @return image of window minima
+     */
+    cv::Mat minimumFilter(const cv::Mat &image, int kernelSize);
+
+    /**
+     * Compute the maximum of every square window (separable van Herk/Gil-Werman algorithm,
+     * cost does not depend on the kernel size). Windows are clipped to the image.
+     * @param image to apply filter to
+     * @param kernelSize side of the window
+     * @return image of window maxima
+     */
+    cv::Mat maximumFilter(const cv::Mat &image, int kernelSize);
+
+    /**
+     * Apply a midpoint filter built on minimumFilter and maximumFilter.
+     * Near the border the window is clipped to the image.
      * @param image to apply filter to
      * @param kernelSize of the filter
      * @return image after applying the filter
@@ -78,7 +230,8 @@ namespace SpatialDomainProcessor {
     cv::Mat midpointFilter(cv::Mat image, int kernelSize);
 
     /**
-     * Apply an arithmetic filter.
+     * Apply an arithmetic mean filter using running sums (cost does not depend on the kernel size).
+     * Near the border the mean is taken over the part of the window which lies inside the image.
      * @param image to apply filter to
      * @param kernelSize of the filter
      * @return image after applying the filter
@@ -86,7 +239,27 @@ namespace SpatialDomainProcessor {
     cv::Mat arithmeticMeanFilter(cv::Mat image, int kernelSize);
 
     /**
-     * Apply Laplacian-edge detection filter.
+     * Convolve an image with an arbitrary kernel. Rank-1 kernels are applied as two 1D passes,
+     * small kernels with a direct stencil and large kernels through the FFT, whichever is estimated to be cheapest.
+     * The kernel anchor is at (kernel.rows / 2, kernel.cols / 2). Results are rounded and clamped to [0, 255].
+     * @param image Input grayscale image
+     * @param kernel CV_64FC1 convolution kernel
+     * @param borderType Extrapolation of pixels outside the image
+     * @return Convolved image
+     */
+    cv::Mat convolve(const cv::Mat &image, const cv::Mat &kernel, BorderType borderType = BorderType::REPLICATE);
+
+    /**
+     * Read a convolution kernel written as whitespace separated numbers, one kernel row per line.
+     * Empty lines are skipped.
+     * @param stream Stream to read the kernel from
+     * @return CV_64FC1 kernel
+     */
+    cv::Mat parseKernel(std::istream &stream);
+
+    /**
+     * Apply Laplacian-edge detection filter. Every mask has its own vectorized stencil kernel
+     * (SSE4.1 or AVX2 when the processor supports it), pixels outside the image are zero.
      * @param image Input image
      * @param laplaceMask Type of Laplacian mask to use
      * @return Edge detected image
@@ -94,24 +267,27 @@ namespace SpatialDomainProcessor {
     cv::Mat laplacianFilter(const cv::Mat &image, int laplaceMask);
 
     /**
-     * Apply optimized Laplacian filter for edge detection.
+     * Apply optimized Laplacian filter for edge detection (the 4-neighbourhood mask of laplacianFilter).
      * @param image Input image
      * @return Edge detected image
      */
     cv::Mat optimizedLaplacianFilter(cv::Mat image);
 
     /**
-     * Apply Roberts cross gradient operator for edge detection.
+     * Apply Roberts cross gradient operator for edge detection with a vectorized stencil kernel.
+     * The last row and column are left unchanged.
      * @param image Input image
      * @return Edge detected image
      */
     cv::Mat robertsOperator1(cv::Mat image);
 
     /**
-     * Perform region growing segmentation.
+     * Perform region growing segmentation from a regular grid of seeds. Regions are grown with a span fill
+     * in parallel horizontal strips and merged across the strip borders.
      * @param image Input image
-     * @param criterion Region growing criterion value
-     * @return Segmented image
+     * @param criterion Region growing criterion value (0- adaptive mean distance, 1- fixed mean distance,
+     * 2- absolute distance from the seed)
+     * @return CV_32SC1 label map with consecutive region labels starting at 1 (0 means unlabeled)
      */
     template<typename TPixel>
     cv::Mat regionGrowing(cv::Mat image, int criterion);
@@ -123,9 +299,10 @@ namespace SpatialDomainProcessor {
     std::vector<cv::Vec3b> createColorMap();
 
     /**
-     * Apply a color map to grayscale image.
-     * @param grayscaleMask Input grayscale image
-     * @param colorMap Color map to apply
+     * Apply a color map to grayscale image or label map. Labels beyond the size of the color map
+     * cycle through its non-zero entries.
+     * @param grayscaleMask Input CV_8UC1 grayscale image or CV_32SC1 label map
+     * @param colorMap Color map to apply (at least two colors, the first one for the background)
      * @return Colored image
      */
     cv::Mat applyColorMap(const cv::Mat &grayscaleMask, const std::vector<cv::Vec3b> &colorMap);
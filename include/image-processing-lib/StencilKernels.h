@@ -0,0 +1,203 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#ifndef STENCILKERNELS_H
+#define STENCILKERNELS_H
+
+#include <cmath>
+#include <opencv2/opencv.hpp>
+
+#include "StencilRowKernels.h"
+
+/**
+ * Scalar 3x3 stencil engine behind the Laplacian filters and the Roberts cross. A stencil is written once
+ * against a small set of lane operations (load, add, multiply, ...) and instantiated for scalar code here.
+ * The kernels for other instruction sets are written with intrinsics in their own translation units,
+ * which only include StencilRowKernels.h, so none of these inline functions is ever compiled with target flags.
+ */
+namespace StencilKernels {
+    namespace detail {
+        inline uchar clampToUchar(const int value) {
+            return static_cast<uchar>(value < 0 ? 0 : value > UCHAR_MAX ? UCHAR_MAX : value);
+        }
+
+        /**
+         * Lane operations of plain scalar code, used for the scalar row kernel and the image border.
+         */
+        struct ScalarLanes {
+            using Vector = int;
+            static constexpr int LANES = 1;
+
+            static Vector zero() {
+                return 0;
+            }
+
+            static Vector load(const uchar *pixels) {
+                return *pixels;
+            }
+
+            static Vector add(const Vector first, const Vector second) {
+                return first + second;
+            }
+
+            static Vector subtract(const Vector first, const Vector second) {
+                return first - second;
+            }
+
+            static Vector multiply(const Vector value, const int factor) {
+                return value * factor;
+            }
+
+            static Vector absolute(const Vector value) {
+                return value < 0 ? -value : value;
+            }
+
+            /**
+             * Rounded length of the vector (first, second). Its square is an integer,
+             * so the root is never exactly halfway between two integers.
+             */
+            static Vector magnitude(const Vector first, const Vector second) {
+                return static_cast<int>(std::sqrt(static_cast<float>(first * first + second * second)) + 0.5f);
+            }
+
+            static void store(uchar *result, const Vector low, const Vector high) {
+                result[0] = clampToUchar(low);
+                result[1] = clampToUchar(high);
+            }
+        };
+
+        template<typename TLanes, int Coefficient>
+        typename TLanes::Vector accumulate(const typename TLanes::Vector sum, const uchar *pixels) {
+            if constexpr (Coefficient == 0) {
+                return sum;
+            } else if constexpr (Coefficient == 1) {
+                return TLanes::add(sum, TLanes::load(pixels));
+            } else if constexpr (Coefficient == -1) {
+                return TLanes::subtract(sum, TLanes::load(pixels));
+            } else {
+                return TLanes::add(sum, TLanes::multiply(TLanes::load(pixels), Coefficient));
+            }
+        }
+
+        constexpr int maskAbsoluteSum(const StencilMask &mask) {
+            int sum = 0;
+            for (const auto &row: mask) {
+                for (const int coefficient: row) {
+                    sum += coefficient < 0 ? -coefficient : coefficient;
+                }
+            }
+            return sum;
+        }
+
+        /**
+         * Absolute value of the correlation with a 3x3 mask known at compile time (zero terms are dropped).
+         * Pixels outside the image are zero.
+         */
+        template<StencilMask Mask>
+        struct MaskStencil {
+            static_assert(maskAbsoluteSum(Mask) * UCHAR_MAX <= SHRT_MAX, "Mask sums have to fit 16-bit lanes");
+
+            // Rows and columns at the edges of the image the stencil reaches out of
+            static constexpr int TOP = 1;
+            static constexpr int BOTTOM = 1;
+            static constexpr int LEFT = 1;
+            static constexpr int RIGHT = 1;
+            // Whether edge pixels keep their input value instead of being evaluated with zero padding
+            static constexpr bool COPY_BORDER = false;
+
+            template<typename TLanes>
+            static typename TLanes::Vector evaluate(const uchar *above, const uchar *row, const uchar *below) {
+                auto sum = TLanes::zero();
+                sum = accumulate<TLanes, Mask[0][0]>(sum, above - 1);
+                sum = accumulate<TLanes, Mask[0][1]>(sum, above);
+                sum = accumulate<TLanes, Mask[0][2]>(sum, above + 1);
+                sum = accumulate<TLanes, Mask[1][0]>(sum, row - 1);
+                sum = accumulate<TLanes, Mask[1][1]>(sum, row);
+                sum = accumulate<TLanes, Mask[1][2]>(sum, row + 1);
+                sum = accumulate<TLanes, Mask[2][0]>(sum, below - 1);
+                sum = accumulate<TLanes, Mask[2][1]>(sum, below);
+                sum = accumulate<TLanes, Mask[2][2]>(sum, below + 1);
+                return TLanes::absolute(sum);
+            }
+        };
+
+        /**
+         * Rounded gradient magnitude of the Roberts cross. The last row and column keep their input value.
+         */
+        struct RobertsStencil {
+            static constexpr int TOP = 0;
+            static constexpr int BOTTOM = 1;
+            static constexpr int LEFT = 0;
+            static constexpr int RIGHT = 1;
+            static constexpr bool COPY_BORDER = true;
+
+            template<typename TLanes>
+            static typename TLanes::Vector evaluate([[maybe_unused]] const uchar *above, const uchar *row,
+                                                    const uchar *below) {
+                return TLanes::magnitude(TLanes::subtract(TLanes::load(row), TLanes::load(below + 1)),
+                                         TLanes::subtract(TLanes::load(row + 1), TLanes::load(below)));
+            }
+        };
+
+        template<StencilType Type>
+        struct StencilFor;
+
+        template<>
+        struct StencilFor<StencilType::LAPLACIAN_0> {
+            using type = MaskStencil<LAPLACIAN_MASKS[0]>;
+        };
+
+        template<>
+        struct StencilFor<StencilType::LAPLACIAN_1> {
+            using type = MaskStencil<LAPLACIAN_MASKS[1]>;
+        };
+
+        template<>
+        struct StencilFor<StencilType::LAPLACIAN_2> {
+            using type = MaskStencil<LAPLACIAN_MASKS[2]>;
+        };
+
+        template<>
+        struct StencilFor<StencilType::ROBERTS_CROSS> {
+            using type = RobertsStencil;
+        };
+
+        /**
+         * Evaluate a stencil over a part of a row, two vectors of lanes at a time, and finish the tail pixel by pixel.
+         */
+        template<typename TStencil, typename TLanes>
+        void stencilRow(const uchar *above, const uchar *row, const uchar *below, uchar *result,
+                        const int begin, const int end) {
+            int y = begin;
+            for (; y + 2 * TLanes::LANES <= end; y += 2 * TLanes::LANES) {
+                const auto low = TStencil::template evaluate<TLanes>(above + y, row + y, below + y);
+                const auto high = TStencil::template evaluate<TLanes>(above + y + TLanes::LANES,
+                                                                      row + y + TLanes::LANES,
+                                                                      below + y + TLanes::LANES);
+                TLanes::store(result + y, low, high);
+            }
+            for (; y < end; y++) {
+                result[y] = clampToUchar(TStencil::template evaluate<ScalarLanes>(above + y, row + y, below + y));
+            }
+        }
+
+        template<typename TLanes>
+        RowFunction rowFunction(const StencilType type) {
+            switch (type) {
+                case StencilType::LAPLACIAN_0:
+                    return &stencilRow<StencilFor<StencilType::LAPLACIAN_0>::type, TLanes>;
+                case StencilType::LAPLACIAN_1:
+                    return &stencilRow<StencilFor<StencilType::LAPLACIAN_1>::type, TLanes>;
+                case StencilType::LAPLACIAN_2:
+                    return &stencilRow<StencilFor<StencilType::LAPLACIAN_2>::type, TLanes>;
+                case StencilType::ROBERTS_CROSS:
+                    return &stencilRow<StencilFor<StencilType::ROBERTS_CROSS>::type, TLanes>;
+            }
+            return nullptr;
+        }
+    }
+}
+
+
+#endif //STENCILKERNELS_H
@@ -0,0 +1,57 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#ifndef STENCILROWKERNELS_H
+#define STENCILROWKERNELS_H
+
+#include <array>
+
+/**
+ * Interface of the 3x3 stencil row kernels compiled for specific instruction sets. It holds no inline code,
+ * so the translation units compiled with target flags can include it without emitting functions the linker
+ * could also pick for code running on a processor without the instruction set.
+ */
+namespace StencilKernels {
+    /**
+     * Stencils known to the engine.
+     */
+    enum class StencilType {
+        LAPLACIAN_0, // 4-neighbourhood Laplacian
+        LAPLACIAN_1, // 8-neighbourhood Laplacian
+        LAPLACIAN_2, // diagonal Laplacian
+        ROBERTS_CROSS
+    };
+
+    /**
+     * Kernel filling result[begin, end) of one row. The row pointers point to the start of the rows above,
+     * at and below the processed one (the missing ones are replaced with the processed row).
+     */
+    using RowFunction = void (*)(const unsigned char *above, const unsigned char *row, const unsigned char *below,
+                                 unsigned char *result, int begin, int end);
+
+    /**
+     * Row kernel compiled for SSE4.1 (defined in StencilSse4.cpp).
+     * @param type Stencil to get the kernel of
+     * @return Kernel or nullptr if the library was built without SSE4.1 support
+     */
+    RowFunction sse4RowFunction(StencilType type);
+
+    /**
+     * Row kernel compiled for AVX2 (defined in StencilAvx2.cpp).
+     * @param type Stencil to get the kernel of
+     * @return Kernel or nullptr if the library was built without AVX2 support
+     */
+    RowFunction avx2RowFunction(StencilType type);
+
+    using StencilMask = std::array<std::array<int, 3>, 3>;
+
+    constexpr std::array<StencilMask, 3> LAPLACIAN_MASKS = {{
+        {{{0, -1, 0}, {-1, 4, -1}, {0, -1, 0}}},
+        {{{-1, -1, -1}, {-1, 8, -1}, {-1, -1, -1}}},
+        {{{1, -2, 1}, {-2, 4, -2}, {1, -2, 1}}}
+    }};
+}
+
+
+#endif //STENCILROWKERNELS_H
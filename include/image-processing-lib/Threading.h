@@ -0,0 +1,24 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#ifndef THREADING_H
+#define THREADING_H
+
+
+namespace Threading {
+    /**
+     * Set the number of threads used by all parallel regions of the library.
+     * @param threadCount Number of threads (has to be positive)
+     */
+    void setThreadCount(int threadCount);
+
+    /**
+     * Get the number of threads used by parallel regions of the library.
+     * @return Number of threads (1 if the library was built without OpenMP)
+     */
+    int getThreadCount();
+}
+
+
+#endif //THREADING_H
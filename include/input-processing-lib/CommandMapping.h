@@ -6,6 +6,9 @@
 #define COMMANDMAPPING_H
 #include <string>
 #include <unordered_map>
+
+#include "../image-processing-lib/FourierProcessor.h"
+#include "../image-processing-lib/SpatialDomainProcessor.h"
 /**
  * @brief Command type enumeration for argument parsing
  */
@@ -20,9 +23,12 @@ enum class CommandType {
     HORIZONTAL_FLIP,
     VERTICAL_FLIP,
     DIAGONAL_FLIP,
+    TRANSPOSE,
+    ROTATE,
     RESIZE,
     MIDPOINT_FILTER,
     ARITHMETIC_MEAN_FILTER,
+    CONVOLVE,
     COMPARE_IMAGES,
     HISTOGRAM,
     HISTOGRAM_UNIFORM,
@@ -35,6 +41,7 @@ enum class CommandType {
     OPENING,
     CLOSING,
     HMT,
+    CONNECTED_COMPONENTS,
     REGION_GROWING,
     FOURIER_TRANSFORM,
     FAST_FOURIER_TRANSFORM,
@@ -44,6 +51,11 @@ enum class CommandType {
     FFT_BAND_CUT,
     FFT_HIGH_PASS_DIRECTION,
     FFT_PHASE_MODIFYING,
+    TRANSLATE,
+    FFT_PRECISION,
+    FFT_TILED,
+    MATCH_TEMPLATE,
+    THREADS,
     UNKNOWN // For unrecognized commands
 };
 
@@ -61,9 +73,12 @@ const std::unordered_map<std::string, CommandType> commandMap = {
     {"--hflip", CommandType::HORIZONTAL_FLIP},
     {"--vflip", CommandType::VERTICAL_FLIP},
     {"--dflip", CommandType::DIAGONAL_FLIP},
+    {"--transpose", CommandType::TRANSPOSE},
+    {"--rotate", CommandType::ROTATE},
     {"--shrink", CommandType::RESIZE},
     {"--mid", CommandType::MIDPOINT_FILTER},
     {"--amean", CommandType::ARITHMETIC_MEAN_FILTER},
+    {"--convolve", CommandType::CONVOLVE},
     {"--compareImages", CommandType::COMPARE_IMAGES},
     {"--histogram", CommandType::HISTOGRAM},
     {"--huniform", CommandType::HISTOGRAM_UNIFORM},
@@ -76,6 +91,7 @@ const std::unordered_map<std::string, CommandType> commandMap = {
     {"--opening", CommandType::OPENING},
     {"--closing", CommandType::CLOSING},
     {"--hmt", CommandType::HMT},
+    {"--ccl", CommandType::CONNECTED_COMPONENTS},
     {"--regionGrowing", CommandType::REGION_GROWING},
     {"--fourierTransform", CommandType::FOURIER_TRANSFORM},
     {"--fastFourierTransform", CommandType::FAST_FOURIER_TRANSFORM},
@@ -85,6 +101,11 @@ const std::unordered_map<std::string, CommandType> commandMap = {
     {"--fftBandCut", CommandType::FFT_BAND_CUT},
     {"--fftHighPassDirection", CommandType::FFT_HIGH_PASS_DIRECTION},
     {"--fftPhaseModifying", CommandType::FFT_PHASE_MODIFYING},
+    {"--translate", CommandType::TRANSLATE},
+    {"--fftPrecision", CommandType::FFT_PRECISION},
+    {"--fftTiled", CommandType::FFT_TILED},
+    {"--matchTemplate", CommandType::MATCH_TEMPLATE},
+    {"--threads", CommandType::THREADS},
 };
 
 /**
@@ -101,9 +122,12 @@ const std::unordered_map<CommandType, std::string> commandToStringMap = {
     {CommandType::HORIZONTAL_FLIP, "--hflip"},
     {CommandType::VERTICAL_FLIP, "--vflip"},
     {CommandType::DIAGONAL_FLIP, "--dflip"},
+    {CommandType::TRANSPOSE, "--transpose"},
+    {CommandType::ROTATE, "--rotate"},
     {CommandType::RESIZE, "--shrink"},
     {CommandType::MIDPOINT_FILTER, "--mid"},
     {CommandType::ARITHMETIC_MEAN_FILTER, "--amean"},
+    {CommandType::CONVOLVE, "--convolve"},
     {CommandType::COMPARE_IMAGES, "--compareImages"},
     {CommandType::HISTOGRAM, "--histogram"},
     {CommandType::HISTOGRAM_UNIFORM, "--huniform"},
@@ -116,6 +140,7 @@ const std::unordered_map<CommandType, std::string> commandToStringMap = {
     {CommandType::OPENING, "--opening"},
     {CommandType::CLOSING, "--closing"},
     {CommandType::HMT, "--hmt"},
+    {CommandType::CONNECTED_COMPONENTS, "--ccl"},
     {CommandType::REGION_GROWING, "--regionGrowing"},
     {CommandType::FOURIER_TRANSFORM, "--fourierTransform"},
     {CommandType::FAST_FOURIER_TRANSFORM, "--fastFourierTransform"},
@@ -125,5 +150,36 @@ const std::unordered_map<CommandType, std::string> commandToStringMap = {
     {CommandType::FFT_BAND_CUT, "--fftBandCut"},
     {CommandType::FFT_HIGH_PASS_DIRECTION, "--fftHighPassDirection"},
     {CommandType::FFT_PHASE_MODIFYING, "--fftPhaseModifying"},
+    {CommandType::TRANSLATE, "--translate"},
+    {CommandType::FFT_PRECISION, "--fftPrecision"},
+    {CommandType::FFT_TILED, "--fftTiled"},
+    {CommandType::MATCH_TEMPLATE, "--matchTemplate"},
+    {CommandType::THREADS, "--threads"},
+};
+
+/**
+ * @brief Maps resize method names to interpolation methods
+ */
+const std::unordered_map<std::string, SpatialDomainProcessor::InterpolationMethod> interpolationMethodMap = {
+    {"nearest", SpatialDomainProcessor::InterpolationMethod::NEAREST},
+    {"bilinear", SpatialDomainProcessor::InterpolationMethod::BILINEAR},
+    {"bicubic", SpatialDomainProcessor::InterpolationMethod::BICUBIC},
+    {"lanczos", SpatialDomainProcessor::InterpolationMethod::LANCZOS},
+    {"area", SpatialDomainProcessor::InterpolationMethod::AREA},
+};
+
+/**
+ * @brief Maps FFT precision names to FFT precisions
+ */
+const std::unordered_map<std::string, FourierProcessor::FFTPrecision> fftPrecisionMap = {
+    {"float", FourierProcessor::FFTPrecision::FLOAT},
+    {"double", FourierProcessor::FFTPrecision::DOUBLE},
 };
+
+const std::unordered_map<std::string, FourierProcessor::FilterShape> filterShapeMap = {
+    {"ideal", FourierProcessor::FilterShape::IDEAL},
+    {"butterworth", FourierProcessor::FilterShape::BUTTERWORTH},
+    {"gaussian", FourierProcessor::FilterShape::GAUSSIAN},
+};
+
 #endif //COMMANDMAPPING_H
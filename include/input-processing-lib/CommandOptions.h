@@ -5,9 +5,20 @@
 #ifndef COMMANDOPTIONS_H
 #define COMMANDOPTIONS_H
 #include <optional>
+#include <vector>
 #include <opencv2/opencv.hpp>
 
 #include "../Constants.h"
+#include "../image-processing-lib/FourierProcessor.h"
+#include "../image-processing-lib/SpatialDomainProcessor.h"
+
+/**
+ * Optional -shape= and -order= parameters of a frequency filter command.
+ */
+struct FilterShapeOptions {
+    FourierProcessor::FilterShape shape = FourierProcessor::FilterShape::IDEAL;
+    int order = 2;
+};
 
 struct CommandOptions {
 #pragma region Input/Output configuration parameters
@@ -16,6 +27,10 @@ struct CommandOptions {
     bool showHelp = false;
 #pragma endregion
 
+#pragma region Runtime configuration parameters
+    std::optional<int> threadCount;
+#pragma endregion
+
 #pragma region Basic image transformation parameters
     std::optional<int> brightnessModVal;
     std::optional<int> contrastLinearModVal;
@@ -24,12 +39,16 @@ struct CommandOptions {
     bool isHorizontalFlip = false;
     bool isVerticalFlip = false;
     bool isDiagonalFlip = false;
+    bool isTranspose = false;
+    std::optional<int> rotationAngle;
     std::optional<float> resizeModVal;
+    SpatialDomainProcessor::InterpolationMethod resizeMethod = SpatialDomainProcessor::InterpolationMethod::NEAREST;
 #pragma endregion
 
 #pragma region Spatial domain filtering parameters
     std::optional<int> midpointKernelSize;
     std::optional<int> arithmeticMeanKernelSize;
+    std::optional<std::string> convolutionKernelPath;
 #pragma endregion
 
 #pragma region Image comparison parameters
@@ -67,6 +86,7 @@ struct CommandOptions {
     std::optional<int> openingMask;
     std::optional<int> closingMask;
     std::optional<int> hmtMask;
+    bool isConnectedComponents = false;
 #pragma endregion
 
 #pragma region Segmentation parameters
@@ -77,13 +97,29 @@ struct CommandOptions {
     bool isFourierTransform = false;
     bool isFastFourierTransform = false;
     std::optional<int> lowPassBandSize;
+    FilterShapeOptions lowPassShape;
     std::optional<int> highPassBandSize;
+    FilterShapeOptions highPassShape;
     std::optional<int> lowCut;
     std::optional<int> highCut;
+    FilterShapeOptions bandPassShape;
     std::optional<int> lowPass;
     std::optional<int> highPass;
+    FilterShapeOptions bandCutShape;
+    std::optional<int> highPassDirectionBandSize;
+    std::vector<double> highPassDirectionAngles;
+    double highPassDirectionWidth = 15;
+    FilterShapeOptions highPassDirectionShape;
     std::optional<int> taskF6k;
     std::optional<int> taskF6l;
+    std::optional<float> translateX;
+    std::optional<float> translateY;
+    FourierProcessor::FFTPrecision fftPrecision = FourierProcessor::FFTPrecision::DOUBLE;
+    std::optional<int> fftTileSize;
+    std::optional<int> fftKernelRadius;
+    std::optional<std::string> templatePath;
+    int templateMatchCount = 1;
+    bool isTemplateResponseMap = false;
 #pragma endregion
 };
 
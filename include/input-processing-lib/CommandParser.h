@@ -15,6 +15,11 @@ class CommandParser {
     template<typename T>
     static bool readParam(const std::string &arg, const std::string &prefix, std::optional<T> &result,
                    const std::string &errorMsg);
+
+    /**
+     * @brief Read the optional -shape= and -order= parameters following a frequency filter command
+     */
+    static void readFilterShape(int argc, char **argv, int &i, FilterShapeOptions &result);
 public:
     static CommandOptions parse(int argc, char** argv);
 };
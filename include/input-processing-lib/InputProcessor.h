@@ -27,6 +27,9 @@ class InputProcessor {
     std::string inputImagePath_;
 
     void setupChannelProcessingPipeline();
+    void fusePointOperations();
+    void fuseGeometricOperations();
+    void fuseSpectralOperations();
     void setupImageProcessingPipeline();
     void setupStatsPipeline();
     void saveResults(const cv::Mat& image) const;
@@ -4,8 +4,9 @@
 #ifndef MASKS_H
 #define MASKS_H
 
-#include <unordered_map>
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 
 namespace Masks {
     enum class FieldType {
@@ -16,232 +17,234 @@ namespace Masks {
         INACTIVE
     };
 
-    const std::unordered_map<int, std::vector<std::vector<FieldType> > >
-    maskMap = {
-        {1, {{FieldType::WHITE_MARKER, FieldType::WHITE}}},
-        {
-            2, {
-                {FieldType::WHITE_MARKER},
-                {FieldType::WHITE}
-            }
-        },
-        {
-            3, {
-                {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE},
-                {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::WHITE},
-                {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE}
-            }
-        },
-        {
-            4, {
-                {FieldType::INACTIVE, FieldType::WHITE, FieldType::INACTIVE},
-                {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::WHITE},
-                {FieldType::INACTIVE, FieldType::WHITE, FieldType::INACTIVE}
-            }
-        },
-        {
-            5, {
-                {FieldType::WHITE_MARKER, FieldType::WHITE},
-                {FieldType::WHITE, FieldType::INACTIVE}
-            }
-        },
-        {
-            6, {
-                {FieldType::BLACK_MARKER, FieldType::WHITE},
-                {FieldType::WHITE, FieldType::INACTIVE}
-            }
-        },
-        {7, {{FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::WHITE}}},
-        {8, {{FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::WHITE}}},
-        {
-            9, {
-                {FieldType::WHITE, FieldType::WHITE_MARKER},
-                {FieldType::WHITE, FieldType::INACTIVE}
-            }
-        },
-        {
-            10, {
-                {FieldType::WHITE, FieldType::WHITE},
-                {FieldType::WHITE_MARKER, FieldType::INACTIVE}
-            }
-        },
+    /**
+     * Maximum number of active fields of a structuring element.
+     */
+    constexpr int MAX_FIELD_COUNT = 9;
+
+    /**
+     * Active field of a structuring element.
+     */
+    struct MaskOffset {
+        int row = 0; // Row offset from the marker
+        int col = 0; // Column offset from the marker
+        bool isBlack = false; // The field matches background instead of foreground
     };
 
-    const std::unordered_map<int, std::vector<std::vector<FieldType> > >
-    hmtMaskMap = {
-        {
-            1, {
-                {FieldType::WHITE, FieldType::INACTIVE, FieldType::INACTIVE},
-                {FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
-                {FieldType::WHITE, FieldType::INACTIVE, FieldType::INACTIVE}
-            }
-        },
-        {
-            2, {
-                {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE},
-                {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
-                {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::INACTIVE}
-            }
-        },
-        {
-            3, {
-                {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::WHITE},
-                {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::WHITE},
-                {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::WHITE}
-            }
-        },
-        {
-            4, {
-                {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::INACTIVE},
-                {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
-                {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE}
-            }
-        },
-        {
-            5, {
-                {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK},
-                {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::INACTIVE},
-                {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE}
-            }
-        },
-        {
-            6, {
-                {FieldType::INACTIVE, FieldType::BLACK, FieldType::BLACK},
-                {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::BLACK},
-                {FieldType::WHITE, FieldType::WHITE, FieldType::INACTIVE}
-            }
-        },
-        {
-            7, {
-                {FieldType::WHITE, FieldType::INACTIVE, FieldType::BLACK},
-                {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::BLACK},
-                {FieldType::WHITE, FieldType::INACTIVE, FieldType::BLACK}
-            }
-        },
-        {
-            8, {
-                {FieldType::WHITE, FieldType::WHITE, FieldType::INACTIVE},
-                {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::BLACK},
-                {FieldType::INACTIVE, FieldType::BLACK, FieldType::BLACK}
-            }
-        },
-        {
-            9, {
-                {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE},
-                {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::INACTIVE},
-                {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK}
-            }
-        },
-        {
-            10, {
-                {FieldType::INACTIVE, FieldType::WHITE, FieldType::WHITE},
-                {FieldType::BLACK, FieldType::WHITE_MARKER, FieldType::WHITE},
-                {FieldType::BLACK, FieldType::BLACK, FieldType::INACTIVE}
-            }
-        },
-        {
-            11, {
-                {FieldType::BLACK, FieldType::INACTIVE, FieldType::WHITE},
-                {FieldType::BLACK, FieldType::WHITE_MARKER, FieldType::WHITE},
-                {FieldType::BLACK, FieldType::INACTIVE, FieldType::WHITE}
-            }
-        },
-        {
-            12, {
-                {FieldType::BLACK, FieldType::BLACK, FieldType::INACTIVE},
-                {FieldType::BLACK, FieldType::WHITE_MARKER, FieldType::WHITE},
-                {FieldType::INACTIVE, FieldType::WHITE, FieldType::WHITE}
-            }
-        },
+    /**
+     * Structuring element reduced to the offsets of its active fields, resolved at compile time.
+     * Morphological operations get a kernel specialized for every element of the sets below.
+     */
+    struct StructuringElement {
+        std::array<MaskOffset, MAX_FIELD_COUNT> offsets{};
+        int size = 0; // Number of active fields
     };
 
-    const std::unordered_map<int, std::vector<std::vector<FieldType> > >
-    hmtComplementMaskMap = {
-        {
-            1, {
-                {FieldType::BLACK, FieldType::INACTIVE, FieldType::INACTIVE},
-                {FieldType::BLACK, FieldType::WHITE_MARKER, FieldType::INACTIVE},
-                {FieldType::BLACK, FieldType::INACTIVE, FieldType::INACTIVE}
-            }
-        },
-        {
-            2, {
-                {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK},
-                {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::INACTIVE},
-                {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::INACTIVE}
-            }
-        },
-        {
-            3, {
-                {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::BLACK},
-                {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::BLACK},
-                {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::BLACK}
-            }
-        },
-        {
-            4, {
-                {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::INACTIVE},
-                {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::INACTIVE},
-                {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK}
-            }
-        },
-        {
-            5, {
-                {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE},
-                {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
-                {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK}
-            }
-        },
-        {
-            6, {
-                {FieldType::INACTIVE, FieldType::WHITE, FieldType::WHITE},
-                {FieldType::BLACK, FieldType::BLACK_MARKER, FieldType::WHITE},
-                {FieldType::BLACK, FieldType::BLACK, FieldType::INACTIVE}
-            }
-        },
-        {
-            7, {
-                {FieldType::BLACK, FieldType::INACTIVE, FieldType::WHITE},
-                {FieldType::BLACK, FieldType::BLACK_MARKER, FieldType::WHITE},
-                {FieldType::BLACK, FieldType::INACTIVE, FieldType::WHITE}
-            }
-        },
-        {
-            8, {
-                {FieldType::BLACK, FieldType::BLACK, FieldType::INACTIVE},
-                {FieldType::BLACK, FieldType::BLACK_MARKER, FieldType::WHITE},
-                {FieldType::INACTIVE, FieldType::WHITE, FieldType::WHITE}
-            }
-        },
-        {
-            9, {
-                {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK},
-                {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
-                {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE}
-            }
-        },
-        {
-            10, {
-                {FieldType::INACTIVE, FieldType::BLACK, FieldType::BLACK},
-                {FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::BLACK},
-                {FieldType::WHITE, FieldType::WHITE, FieldType::INACTIVE}
-            }
-        },
-        {
-            11, {
-                {FieldType::WHITE, FieldType::INACTIVE, FieldType::BLACK},
-                {FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::BLACK},
-                {FieldType::WHITE, FieldType::INACTIVE, FieldType::BLACK}
-            }
-        },
-        {
-            12, {
-                {FieldType::WHITE, FieldType::WHITE, FieldType::INACTIVE},
-                {FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::BLACK},
-                {FieldType::INACTIVE, FieldType::BLACK, FieldType::BLACK}
-            }
-        },
+    /**
+     * Build a structuring element from a grid of fields. The offsets are relative to the first marker
+     * field in row-major order ((0, 0) when there is no marker).
+     */
+    template<size_t ROWS, size_t COLS>
+    consteval StructuringElement makeStructuringElement(const FieldType (&fields)[ROWS][COLS]) {
+        int markerRow = 0;
+        int markerCol = 0;
+        bool foundMarker = false;
+        for (int i = 0; i < static_cast<int>(ROWS) && !foundMarker; i++) {
+            for (int j = 0; j < static_cast<int>(COLS) && !foundMarker; j++) {
+                if (fields[i][j] == FieldType::WHITE_MARKER || fields[i][j] == FieldType::BLACK_MARKER) {
+                    markerRow = i;
+                    markerCol = j;
+                    foundMarker = true;
+                }
+            }
+        }
+
+        StructuringElement element;
+        for (int i = 0; i < static_cast<int>(ROWS); i++) {
+            for (int j = 0; j < static_cast<int>(COLS); j++) {
+                if (fields[i][j] == FieldType::INACTIVE) {
+                    continue;
+                }
+                if (element.size == MAX_FIELD_COUNT) {
+                    throw std::invalid_argument("Structuring element has too many active fields");
+                }
+                const bool isBlack = fields[i][j] == FieldType::BLACK || fields[i][j] == FieldType::BLACK_MARKER;
+                element.offsets[element.size++] = {i - markerRow, j - markerCol, isBlack};
+            }
+        }
+        return element;
+    }
+
+    /**
+     * Structuring elements of dilation, erosion, opening and closing, mask number n is element n - 1.
+     */
+    inline constexpr std::array<StructuringElement, 10> maskMap = {
+        makeStructuringElement({{FieldType::WHITE_MARKER, FieldType::WHITE}}),
+        makeStructuringElement({
+            {FieldType::WHITE_MARKER},
+            {FieldType::WHITE}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE},
+            {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::WHITE},
+            {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE}
+        }),
+        makeStructuringElement({
+            {FieldType::INACTIVE, FieldType::WHITE, FieldType::INACTIVE},
+            {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::WHITE},
+            {FieldType::INACTIVE, FieldType::WHITE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE_MARKER, FieldType::WHITE},
+            {FieldType::WHITE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::BLACK_MARKER, FieldType::WHITE},
+            {FieldType::WHITE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({{FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::WHITE}}),
+        makeStructuringElement({{FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::WHITE}}),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::WHITE_MARKER},
+            {FieldType::WHITE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::WHITE},
+            {FieldType::WHITE_MARKER, FieldType::INACTIVE}
+        })
+    };
+
+    /**
+     * Structuring elements matching the foreground of the hit-or-miss transform.
+     */
+    inline constexpr std::array<StructuringElement, 12> hmtMaskMap = {
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::INACTIVE, FieldType::INACTIVE},
+            {FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
+            {FieldType::WHITE, FieldType::INACTIVE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE},
+            {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
+            {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::WHITE},
+            {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::WHITE},
+            {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::WHITE}
+        }),
+        makeStructuringElement({
+            {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::INACTIVE},
+            {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
+            {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE}
+        }),
+        makeStructuringElement({
+            {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK},
+            {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::INACTIVE},
+            {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE}
+        }),
+        makeStructuringElement({
+            {FieldType::INACTIVE, FieldType::BLACK, FieldType::BLACK},
+            {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::BLACK},
+            {FieldType::WHITE, FieldType::WHITE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::INACTIVE, FieldType::BLACK},
+            {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::BLACK},
+            {FieldType::WHITE, FieldType::INACTIVE, FieldType::BLACK}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::WHITE, FieldType::INACTIVE},
+            {FieldType::WHITE, FieldType::WHITE_MARKER, FieldType::BLACK},
+            {FieldType::INACTIVE, FieldType::BLACK, FieldType::BLACK}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE},
+            {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::INACTIVE},
+            {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK}
+        }),
+        makeStructuringElement({
+            {FieldType::INACTIVE, FieldType::WHITE, FieldType::WHITE},
+            {FieldType::BLACK, FieldType::WHITE_MARKER, FieldType::WHITE},
+            {FieldType::BLACK, FieldType::BLACK, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::BLACK, FieldType::INACTIVE, FieldType::WHITE},
+            {FieldType::BLACK, FieldType::WHITE_MARKER, FieldType::WHITE},
+            {FieldType::BLACK, FieldType::INACTIVE, FieldType::WHITE}
+        }),
+        makeStructuringElement({
+            {FieldType::BLACK, FieldType::BLACK, FieldType::INACTIVE},
+            {FieldType::BLACK, FieldType::WHITE_MARKER, FieldType::WHITE},
+            {FieldType::INACTIVE, FieldType::WHITE, FieldType::WHITE}
+        })
+    };
+
+    /**
+     * Structuring elements matching the complement of the image in the hit-or-miss transform.
+     */
+    inline constexpr std::array<StructuringElement, 12> hmtComplementMaskMap = {
+        makeStructuringElement({
+            {FieldType::BLACK, FieldType::INACTIVE, FieldType::INACTIVE},
+            {FieldType::BLACK, FieldType::WHITE_MARKER, FieldType::INACTIVE},
+            {FieldType::BLACK, FieldType::INACTIVE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK},
+            {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::INACTIVE},
+            {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::BLACK},
+            {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::BLACK},
+            {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::BLACK}
+        }),
+        makeStructuringElement({
+            {FieldType::INACTIVE, FieldType::INACTIVE, FieldType::INACTIVE},
+            {FieldType::INACTIVE, FieldType::WHITE_MARKER, FieldType::INACTIVE},
+            {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE},
+            {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
+            {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK}
+        }),
+        makeStructuringElement({
+            {FieldType::INACTIVE, FieldType::WHITE, FieldType::WHITE},
+            {FieldType::BLACK, FieldType::BLACK_MARKER, FieldType::WHITE},
+            {FieldType::BLACK, FieldType::BLACK, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::BLACK, FieldType::INACTIVE, FieldType::WHITE},
+            {FieldType::BLACK, FieldType::BLACK_MARKER, FieldType::WHITE},
+            {FieldType::BLACK, FieldType::INACTIVE, FieldType::WHITE}
+        }),
+        makeStructuringElement({
+            {FieldType::BLACK, FieldType::BLACK, FieldType::INACTIVE},
+            {FieldType::BLACK, FieldType::BLACK_MARKER, FieldType::WHITE},
+            {FieldType::INACTIVE, FieldType::WHITE, FieldType::WHITE}
+        }),
+        makeStructuringElement({
+            {FieldType::BLACK, FieldType::BLACK, FieldType::BLACK},
+            {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::INACTIVE},
+            {FieldType::WHITE, FieldType::WHITE, FieldType::WHITE}
+        }),
+        makeStructuringElement({
+            {FieldType::INACTIVE, FieldType::BLACK, FieldType::BLACK},
+            {FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::BLACK},
+            {FieldType::WHITE, FieldType::WHITE, FieldType::INACTIVE}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::INACTIVE, FieldType::BLACK},
+            {FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::BLACK},
+            {FieldType::WHITE, FieldType::INACTIVE, FieldType::BLACK}
+        }),
+        makeStructuringElement({
+            {FieldType::WHITE, FieldType::WHITE, FieldType::INACTIVE},
+            {FieldType::WHITE, FieldType::BLACK_MARKER, FieldType::BLACK},
+            {FieldType::INACTIVE, FieldType::BLACK, FieldType::BLACK}
+        })
     };
 }
 
-#endif //MASKS_H
\ No newline at end of file
+#endif //MASKS_H
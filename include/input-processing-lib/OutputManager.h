@@ -15,6 +15,11 @@ public:
 
     static void saveFile(const std::string &filePath, const std::stringstream &contents);
 
+    /**
+     * Save a CV_32SC1 label map as a 16-bit PNG, or as a YAML matrix if a label does not fit into 16 bits.
+     */
+    static void saveLabels(const cv::Mat &labels, const std::string &baseName, const std::string &suffix);
+
     static std::string constructPath(const std::string &baseName, const std::string &suffix,
                                      const std::string &extension);
 };
@@ -0,0 +1,27 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#ifndef GEOMETRICOPERATION_H
+#define GEOMETRICOPERATION_H
+#include "ImageOperation.h"
+#include "image-processing-lib/SpatialDomainProcessor.h"
+
+/**
+ * @brief Operation rearranging pixels by a flip, transposition or right-angle rotation.
+ *
+ * Such an operation is fully described by a geometric transform, so consecutive geometric operations
+ * can be composed into one transform and materialized in a single pass (or skipped when they cancel out).
+ */
+class GeometricOperation : public ImageOperation {
+public:
+    /**
+     * @brief Geometric transform performed by the operation.
+     */
+    [[nodiscard]] virtual SpatialDomainProcessor::GeometricTransform transform() const = 0;
+
+    void apply(cv::Mat &image) const override {
+        image = SpatialDomainProcessor::applyGeometricTransform(image, transform());
+    }
+};
+#endif //GEOMETRICOPERATION_H
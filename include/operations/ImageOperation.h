@@ -11,5 +11,15 @@ public:
     virtual ~ImageOperation() = default;
 
     virtual void apply(cv::Mat &image) const = 0;
+
+    /**
+     * @brief Apply the operation to every channel of an image. Operations which can process
+     * the channels together override this, the others are applied to one channel at a time.
+     */
+    virtual void applyToChannels(std::vector<cv::Mat> &channels) const {
+        for (auto &channel: channels) {
+            apply(channel);
+        }
+    }
 };
 #endif //IMAGEOPERATION_H
@@ -0,0 +1,42 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#ifndef POINTOPERATION_H
+#define POINTOPERATION_H
+#include "ImageOperation.h"
+#include "image-processing-lib/HistogramProcessor.h"
+#include "image-processing-lib/SpatialDomainProcessor.h"
+
+/**
+ * @brief Operation mapping every intensity independently of its position.
+ *
+ * Such an operation is fully described by a lookup table, so consecutive point operations
+ * can be composed into one table and applied in a single pass over the image.
+ */
+class PointOperation : public ImageOperation {
+public:
+    /**
+     * @brief Build the lookup table of the operation.
+     * @param histogram Histogram of the image the operation is applied to
+     * (only filled in when needsHistogram() returns true)
+     */
+    [[nodiscard]] virtual std::array<uchar, UCHAR_MAX + 1> lookupTable(
+        const std::array<uint, UCHAR_MAX + 1> &histogram) const = 0;
+
+    /**
+     * @brief Whether the lookup table depends on the histogram of the image.
+     */
+    [[nodiscard]] virtual bool needsHistogram() const {
+        return false;
+    }
+
+    void apply(cv::Mat &image) const override {
+        std::array<uint, UCHAR_MAX + 1> histogram = {};
+        if (needsHistogram()) {
+            histogram = HistogramProcessor::computeHistogram(image);
+        }
+        image = SpatialDomainProcessor::applyLookupTable(image, lookupTable(histogram));
+    }
+};
+#endif //POINTOPERATION_H
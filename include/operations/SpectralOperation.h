@@ -0,0 +1,109 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#ifndef SPECTRALOPERATION_H
+#define SPECTRALOPERATION_H
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "ImageOperation.h"
+#include "image-processing-lib/FourierProcessor.h"
+#include "input-processing-lib/OutputManager.h"
+
+/**
+ * @brief Operation modifying the spectrum of an image.
+ *
+ * Applied on its own, the operation transforms the image, modifies the spectrum and transforms it back.
+ * Consecutive spectral operations can share a single round trip, so the image is quantized only once.
+ */
+class SpectralOperation : public ImageOperation {
+    FourierProcessor::FFTPrecision precision_;
+
+public:
+    explicit SpectralOperation(const FourierProcessor::FFTPrecision precision) : precision_(precision) {
+    }
+
+    /**
+     * @brief Precision of the fast Fourier transforms.
+     */
+    [[nodiscard]] FourierProcessor::FFTPrecision precision() const {
+        return precision_;
+    }
+
+    /**
+     * @brief Whether the operation needs the full spectrum (otherwise it also works on the half spectrum).
+     */
+    [[nodiscard]] virtual bool needsFullSpectrum() const {
+        return true;
+    }
+
+    /**
+     * @brief Filter the operation multiplies the spectrum by, if it is a plain frequency filter
+     * (such operations can also run tiled, see FourierProcessor::tiledFilter).
+     */
+    [[nodiscard]] virtual std::optional<FourierProcessor::FrequencyFilter> frequencyFilter() const {
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Modify a shifted full spectrum.
+     */
+    virtual void transformSpectrum(cv::Mat &fourierImage) const = 0;
+
+    /**
+     * @brief Modify a half spectrum (only called when needsFullSpectrum() returns false).
+     */
+    virtual void transformHalfSpectrum(FourierProcessor::HalfSpectrum &spectrum) const {
+        throw std::logic_error("Operation needs the full spectrum");
+    }
+
+    /**
+     * @brief Transform the channels of an image, run the operations on their spectra in order and transform
+     * them back. The half spectra of all channels are computed in one batch unless one of the operations needs
+     * the full spectrum. The final spectrum of the last channel is visualized.
+     */
+    static void applyInFrequencyDomain(std::vector<cv::Mat> &channels,
+                                       const std::vector<const SpectralOperation *> &operations,
+                                       const FourierProcessor::FFTPrecision precision) {
+        if (channels.empty()) {
+            return;
+        }
+        const std::string path = OutputManager::constructPath("image_fourier", "magnitude_spectrum", "bmp");
+        if (std::ranges::any_of(operations, [](const auto *op) { return op->needsFullSpectrum(); })) {
+            for (auto &channel: channels) {
+                cv::Mat fourierImage = FourierProcessor::fastFourierTransform(channel, false, precision);
+                for (const auto *op: operations) {
+                    op->transformSpectrum(fourierImage);
+                }
+                if (&channel == &channels.back()) {
+                    FourierProcessor::visualizeFourier(fourierImage, path);
+                }
+                channel = FourierProcessor::inverseFastFourierTransform(fourierImage);
+            }
+        } else {
+            std::vector<FourierProcessor::HalfSpectrum> spectra =
+                    FourierProcessor::realFastFourierTransform(channels, false, precision);
+            for (auto &spectrum: spectra) {
+                for (const auto *op: operations) {
+                    op->transformHalfSpectrum(spectrum);
+                }
+            }
+            FourierProcessor::visualizeFourier(spectra.back(), path);
+            channels = FourierProcessor::inverseRealFastFourierTransform(spectra);
+        }
+    }
+
+    void apply(cv::Mat &image) const override {
+        std::vector channels = {image};
+        applyToChannels(channels);
+        image = channels.front();
+    }
+
+    void applyToChannels(std::vector<cv::Mat> &channels) const override {
+        applyInFrequencyDomain(channels, {this}, precision_);
+    }
+};
+#endif //SPECTRALOPERATION_H
@@ -1,25 +1,33 @@
 //
 // Created by gluckasz on 2/4/25.
 //
+#include "../SpectralOperation.h"
 
-#include "../ImageOperation.h"
-#include "input-processing-lib/OutputManager.h"
-#include "image-processing-lib/FourierProcessor.h"
-
-class BandCutOperation final : public ImageOperation {
+class BandCutOperation final : public SpectralOperation {
     int low_;
     int high_;
+    FourierProcessor::FilterShape shape_;
+    int order_;
 
 public:
-    explicit BandCutOperation(const int low, const int high) : low_(low), high_(high) {
+    explicit BandCutOperation(const int low, const int high, const FourierProcessor::FilterShape shape,
+                              const int order, const FourierProcessor::FFTPrecision precision)
+        : SpectralOperation(precision), low_(low), high_(high), shape_(shape), order_(order) {
     }
 
-    void apply(cv::Mat &image) const override {
-        cv::Mat fourierImage = FourierProcessor::fastFourierTransform(image);
-        fourierImage = FourierProcessor::fftBandCut(fourierImage, low_, high_);
-        const std::string path = OutputManager::constructPath("image_fourier", "magnitude_spectrum", "bmp");
-        FourierProcessor::visualizeFourier(fourierImage, path);
-        image = FourierProcessor::inverseFastFourierTransform(fourierImage);
+    [[nodiscard]] bool needsFullSpectrum() const override {
+        return false;
+    }
+
+    [[nodiscard]] std::optional<FourierProcessor::FrequencyFilter> frequencyFilter() const override {
+        return FourierProcessor::FrequencyFilter{FourierProcessor::FilterType::BAND_CUT, shape_, low_, high_, order_};
     }
-};
 
+    void transformSpectrum(cv::Mat &fourierImage) const override {
+        fourierImage = FourierProcessor::fftBandCut(fourierImage, low_, high_, shape_, order_);
+    }
+
+    void transformHalfSpectrum(FourierProcessor::HalfSpectrum &spectrum) const override {
+        spectrum = FourierProcessor::fftBandCut(spectrum, low_, high_, shape_, order_);
+    }
+};
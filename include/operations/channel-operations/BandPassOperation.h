@@ -1,24 +1,33 @@
 //
 // Created by gluckasz on 2/4/25.
 //
-#include "../ImageOperation.h"
-#include "input-processing-lib/OutputManager.h"
-#include "image-processing-lib/FourierProcessor.h"
+#include "../SpectralOperation.h"
 
-class BandPassOperation final : public ImageOperation {
+class BandPassOperation final : public SpectralOperation {
     int low_;
     int high_;
+    FourierProcessor::FilterShape shape_;
+    int order_;
 
 public:
-    explicit BandPassOperation(const int low, const int high) : low_(low), high_(high) {
+    explicit BandPassOperation(const int low, const int high, const FourierProcessor::FilterShape shape,
+                               const int order, const FourierProcessor::FFTPrecision precision)
+        : SpectralOperation(precision), low_(low), high_(high), shape_(shape), order_(order) {
     }
 
-    void apply(cv::Mat &image) const override {
-        cv::Mat fourierImage = FourierProcessor::fastFourierTransform(image);
-        fourierImage = FourierProcessor::fftBandPass(fourierImage, low_, high_);
-        const std::string path = OutputManager::constructPath("image_fourier", "magnitude_spectrum", "bmp");
-        FourierProcessor::visualizeFourier(fourierImage, path);
-        image = FourierProcessor::inverseFastFourierTransform(fourierImage);
+    [[nodiscard]] bool needsFullSpectrum() const override {
+        return false;
+    }
+
+    [[nodiscard]] std::optional<FourierProcessor::FrequencyFilter> frequencyFilter() const override {
+        return FourierProcessor::FrequencyFilter{FourierProcessor::FilterType::BAND_PASS, shape_, low_, high_, order_};
     }
-};
 
+    void transformSpectrum(cv::Mat &fourierImage) const override {
+        fourierImage = FourierProcessor::fftBandPass(fourierImage, low_, high_, shape_, order_);
+    }
+
+    void transformHalfSpectrum(FourierProcessor::HalfSpectrum &spectrum) const override {
+        spectrum = FourierProcessor::fftBandPass(spectrum, low_, high_, shape_, order_);
+    }
+};
@@ -1,17 +1,17 @@
 //
 // Created by gluckasz on 2/3/25.
 //
-#include "../ImageOperation.h"
-#include "image-processing-lib/SpatialDomainProcessor.h"
+#include "../PointOperation.h"
 
-class BrightnessOperation final : public ImageOperation {
+class BrightnessOperation final : public PointOperation {
     int delta_;
 
 public:
     explicit BrightnessOperation(const int delta) : delta_(delta) {
     }
 
-    void apply(cv::Mat &image) const override {
-        image = SpatialDomainProcessor::modifyBrightness(image, delta_);
+    [[nodiscard]] std::array<uchar, UCHAR_MAX + 1> lookupTable(
+        const std::array<uint, UCHAR_MAX + 1> &) const override {
+        return SpatialDomainProcessor::brightnessLookupTable(delta_);
     }
 };
@@ -1,17 +1,23 @@
 //
 // Created by gluckasz on 2/3/25.
 //
-#include "../ImageOperation.h"
-#include "image-processing-lib/SpatialDomainProcessor.h"
+#include "../PointOperation.h"
 
-class ContrastLinearOperation final : public ImageOperation {
+class ContrastLinearOperation final : public PointOperation {
     int delta_;
 
 public:
     explicit ContrastLinearOperation(const int delta) : delta_(delta) {
     }
 
-    void apply(cv::Mat &image) const override {
-        image = SpatialDomainProcessor::modifyContrastLinear(image, delta_);
+    [[nodiscard]] bool needsHistogram() const override {
+        return true;
+    }
+
+    [[nodiscard]] std::array<uchar, UCHAR_MAX + 1> lookupTable(
+        const std::array<uint, UCHAR_MAX + 1> &histogram) const override {
+        return SpatialDomainProcessor::contrastLinearLookupTable(delta_,
+                                                                 HistogramProcessor::minimumIntensity(histogram),
+                                                                 HistogramProcessor::maximumIntensity(histogram));
     }
 };
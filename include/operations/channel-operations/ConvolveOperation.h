@@ -0,0 +1,24 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include <fstream>
+
+#include "../ImageOperation.h"
+#include "image-processing-lib/SpatialDomainProcessor.h"
+
+class ConvolveOperation final : public ImageOperation {
+    cv::Mat kernel_;
+
+public:
+    explicit ConvolveOperation(const std::string &kernelPath) {
+        std::ifstream kernelFile(kernelPath);
+        if (!kernelFile.is_open()) {
+            throw std::invalid_argument("Could not open kernel file: " + kernelPath);
+        }
+        kernel_ = SpatialDomainProcessor::parseKernel(kernelFile);
+    }
+
+    void apply(cv::Mat &image) const override {
+        image = SpatialDomainProcessor::convolve(image, kernel_);
+    }
+};
@@ -2,17 +2,24 @@
 // Created by gluckasz on 2/4/25.
 //
 
-#include "../ImageOperation.h"
-#include "input-processing-lib/OutputManager.h"
-#include "image-processing-lib/FourierProcessor.h"
+#include "../SpectralOperation.h"
 
-class FastFourierOperation final : public ImageOperation {
+/**
+ * Transform the image and save its magnitude spectrum. The spectrum is left unchanged, so next to other
+ * spectral operations this only adds a stage to their round trip.
+ */
+class FastFourierOperation final : public SpectralOperation {
 public:
-    void apply(cv::Mat &image) const override {
-        cv::Mat fourierImage = FourierProcessor::fastFourierTransform(image);
-        const std::string path = OutputManager::constructPath("image_fourier", "magnitude_spectrum", "bmp");
-        FourierProcessor::visualizeFourier(fourierImage, path);
-        image = FourierProcessor::inverseFastFourierTransform(fourierImage);
+    explicit FastFourierOperation(const FourierProcessor::FFTPrecision precision) : SpectralOperation(precision) {
+    }
+
+    [[nodiscard]] bool needsFullSpectrum() const override {
+        return false;
     }
-};
 
+    void transformSpectrum(cv::Mat &fourierImage) const override {
+    }
+
+    void transformHalfSpectrum(FourierProcessor::HalfSpectrum &spectrum) const override {
+    }
+};
@@ -1,12 +1,11 @@
 //
 // Created by gluckasz on 2/3/25.
 //
-#include "../ImageOperation.h"
-#include "image-processing-lib/SpatialDomainProcessor.h"
+#include "../GeometricOperation.h"
 
-class FlipDiagonallyOperation final : public ImageOperation {
+class FlipDiagonallyOperation final : public GeometricOperation {
 public:
-    void apply(cv::Mat &image) const override {
-        image = SpatialDomainProcessor::flipDiagonally(image);
+    [[nodiscard]] SpatialDomainProcessor::GeometricTransform transform() const override {
+        return {false, true, true};
     }
 };
@@ -1,12 +1,11 @@
 //
 // Created by gluckasz on 2/3/25.
 //
-#include "../ImageOperation.h"
-#include "image-processing-lib/SpatialDomainProcessor.h"
+#include "../GeometricOperation.h"
 
-class FlipHorizontallyOperation final : public ImageOperation {
+class FlipHorizontallyOperation final : public GeometricOperation {
 public:
-    void apply(cv::Mat &image) const override {
-        image = SpatialDomainProcessor::flipHorizontally(image);
+    [[nodiscard]] SpatialDomainProcessor::GeometricTransform transform() const override {
+        return {false, false, true};
     }
 };
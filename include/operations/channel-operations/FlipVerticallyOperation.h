@@ -1,12 +1,11 @@
 //
 // Created by gluckasz on 2/3/25.
 //
-#include "../ImageOperation.h"
-#include "image-processing-lib/SpatialDomainProcessor.h"
+#include "../GeometricOperation.h"
 
-class FlipVerticallyOperation final : public ImageOperation {
+class FlipVerticallyOperation final : public GeometricOperation {
 public:
-    void apply(cv::Mat &image) const override {
-        image = SpatialDomainProcessor::flipVertically(image);
+    [[nodiscard]] SpatialDomainProcessor::GeometricTransform transform() const override {
+        return {false, true, false};
     }
 };
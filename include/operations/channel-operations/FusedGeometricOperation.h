@@ -0,0 +1,17 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include "../GeometricOperation.h"
+
+class FusedGeometricOperation final : public GeometricOperation {
+    SpatialDomainProcessor::GeometricTransform transform_;
+
+public:
+    explicit FusedGeometricOperation(const SpatialDomainProcessor::GeometricTransform &transform)
+        : transform_(transform) {
+    }
+
+    [[nodiscard]] SpatialDomainProcessor::GeometricTransform transform() const override {
+        return transform_;
+    }
+};
@@ -0,0 +1,33 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include "../PointOperation.h"
+
+class FusedPointOperation final : public ImageOperation {
+    std::vector<std::unique_ptr<PointOperation> > operations_;
+
+public:
+    explicit FusedPointOperation(std::vector<std::unique_ptr<PointOperation> > operations)
+        : operations_(std::move(operations)) {
+    }
+
+    void apply(cv::Mat &image) const override {
+        const bool needsHistogram = std::ranges::any_of(operations_, [](const auto &op) {
+            return op->needsHistogram();
+        });
+        std::array<uint, UCHAR_MAX + 1> inputHistogram = {};
+        if (needsHistogram) {
+            inputHistogram = HistogramProcessor::computeHistogram(image);
+        }
+
+        std::array<uchar, UCHAR_MAX + 1> lookupTable = SpatialDomainProcessor::identityLookupTable();
+        std::array<uint, UCHAR_MAX + 1> histogram = inputHistogram;
+        for (const auto &op: operations_) {
+            lookupTable = SpatialDomainProcessor::composeLookupTables(lookupTable, op->lookupTable(histogram));
+            if (needsHistogram) {
+                histogram = HistogramProcessor::transformHistogram(inputHistogram, lookupTable);
+            }
+        }
+        image = SpatialDomainProcessor::applyLookupTable(image, lookupTable);
+    }
+};
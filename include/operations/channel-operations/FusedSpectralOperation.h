@@ -0,0 +1,69 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include <memory>
+
+#include "../SpectralOperation.h"
+
+class FusedSpectralOperation final : public ImageOperation {
+    std::vector<std::unique_ptr<SpectralOperation> > operations_;
+    FourierProcessor::FFTPrecision precision_;
+
+public:
+    explicit FusedSpectralOperation(std::vector<std::unique_ptr<SpectralOperation> > operations,
+                                    const FourierProcessor::FFTPrecision precision)
+        : operations_(std::move(operations)), precision_(precision) {
+    }
+
+    /**
+     * Replace every run of consecutive spectral operations with one fused operation. Single spectral operations
+     * and all other operations are kept as they are.
+     * @param operations Operations in the order they are applied
+     * @return Operations with the runs fused
+     */
+    static std::vector<std::unique_ptr<ImageOperation> > fuse(
+        std::vector<std::unique_ptr<ImageOperation> > operations) {
+        std::vector<std::unique_ptr<ImageOperation> > fusedOperations;
+        std::vector<std::unique_ptr<SpectralOperation> > spectralOperations;
+        auto flushSpectralOperations = [&] {
+            if (spectralOperations.size() == 1) {
+                fusedOperations.emplace_back(std::move(spectralOperations.front()));
+            } else if (spectralOperations.size() > 1) {
+                const FourierProcessor::FFTPrecision precision = spectralOperations.front()->precision();
+                fusedOperations.emplace_back(
+                    std::make_unique<FusedSpectralOperation>(std::move(spectralOperations), precision));
+            }
+            spectralOperations.clear();
+        };
+
+        for (auto &op: operations) {
+            if (dynamic_cast<SpectralOperation *>(op.get()) != nullptr) {
+                spectralOperations.emplace_back(static_cast<SpectralOperation *>(op.release()));
+            } else {
+                flushSpectralOperations();
+                fusedOperations.emplace_back(std::move(op));
+            }
+        }
+        flushSpectralOperations();
+        return fusedOperations;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return operations_.size();
+    }
+
+    void apply(cv::Mat &image) const override {
+        std::vector channels = {image};
+        applyToChannels(channels);
+        image = channels.front();
+    }
+
+    void applyToChannels(std::vector<cv::Mat> &channels) const override {
+        std::vector<const SpectralOperation *> operations;
+        operations.reserve(operations_.size());
+        for (const auto &op: operations_) {
+            operations.push_back(op.get());
+        }
+        SpectralOperation::applyInFrequencyDomain(channels, operations, precision_);
+    }
+};
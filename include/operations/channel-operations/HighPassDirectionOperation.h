@@ -0,0 +1,39 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include "../SpectralOperation.h"
+
+class HighPassDirectionOperation final : public SpectralOperation {
+    int bandSize_;
+    double angle_;
+    double angularWidth_;
+    FourierProcessor::FilterShape shape_;
+    int order_;
+
+public:
+    explicit HighPassDirectionOperation(const int bandSize, const double angle, const double angularWidth,
+                                        const FourierProcessor::FilterShape shape, const int order,
+                                        const FourierProcessor::FFTPrecision precision)
+        : SpectralOperation(precision), bandSize_(bandSize), angle_(angle), angularWidth_(angularWidth),
+          shape_(shape), order_(order) {
+    }
+
+    [[nodiscard]] bool needsFullSpectrum() const override {
+        return false;
+    }
+
+    [[nodiscard]] std::optional<FourierProcessor::FrequencyFilter> frequencyFilter() const override {
+        return FourierProcessor::FrequencyFilter{
+            FourierProcessor::FilterType::DIRECTIONAL_HIGH_PASS, shape_, bandSize_, 0, order_, angle_, angularWidth_
+        };
+    }
+
+    void transformSpectrum(cv::Mat &fourierImage) const override {
+        fourierImage = FourierProcessor::fftHighPassDirection(fourierImage, bandSize_, angle_, angularWidth_, shape_,
+                                                              order_);
+    }
+
+    void transformHalfSpectrum(FourierProcessor::HalfSpectrum &spectrum) const override {
+        spectrum = FourierProcessor::fftHighPassDirection(spectrum, bandSize_, angle_, angularWidth_, shape_, order_);
+    }
+};
@@ -0,0 +1,63 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include <algorithm>
+#include <sstream>
+
+#include "../ImageOperation.h"
+#include "image-processing-lib/FourierProcessor.h"
+#include "input-processing-lib/OutputManager.h"
+
+/**
+ * Directional high-pass filter of several angles. Every orientation is saved separately and the channels are
+ * replaced by the per-pixel maximum of all orientations (a single angle is a HighPassDirectionOperation).
+ */
+class HighPassDirectionsOperation final : public ImageOperation {
+    int bandSize_;
+    std::vector<double> angles_;
+    double angularWidth_;
+    FourierProcessor::FilterShape shape_;
+    int order_;
+    FourierProcessor::FFTPrecision precision_;
+
+public:
+    explicit HighPassDirectionsOperation(const int bandSize, std::vector<double> angles, const double angularWidth,
+                                         const FourierProcessor::FilterShape shape, const int order,
+                                         const FourierProcessor::FFTPrecision precision)
+        : bandSize_(bandSize), angles_(std::move(angles)), angularWidth_(angularWidth), shape_(shape),
+          order_(order), precision_(precision) {
+    }
+
+    void apply(cv::Mat &image) const override {
+        std::vector channels = {image};
+        applyToChannels(channels);
+        image = channels.front();
+    }
+
+    void applyToChannels(std::vector<cv::Mat> &channels) const override {
+        const std::vector<std::vector<cv::Mat> > directions = FourierProcessor::highPassDirections(
+            channels, bandSize_, angles_, angularWidth_, shape_, order_, precision_);
+
+        for (size_t a = 0; a < angles_.size(); a++) {
+            cv::Mat direction;
+            cv::merge(directions[a], direction);
+            std::ostringstream angle;
+            angle << angles_[a];
+            const std::string path = OutputManager::constructPath("image_direction", angle.str(), "bmp");
+            OutputManager::saveImage(direction, path);
+        }
+        for (size_t c = 0; c < channels.size(); c++) {
+            cv::Mat strongest = directions.front()[c].clone();
+            for (size_t a = 1; a < angles_.size(); a++) {
+                for (int x = 0; x < strongest.rows; x++) {
+                    uchar *strongestRow = strongest.ptr<uchar>(x);
+                    const uchar *directionRow = directions[a][c].ptr<uchar>(x);
+                    for (int y = 0; y < strongest.cols; y++) {
+                        strongestRow[y] = std::max(strongestRow[y], directionRow[y]);
+                    }
+                }
+            }
+            channels[c] = strongest;
+        }
+    }
+};
@@ -1,17 +1,20 @@
 //
 // Created by gluckasz on 2/4/25.
 //
-#include "image-processing-lib/HistogramProcessor.h"
-#include "../ImageOperation.h"
+#include "../PointOperation.h"
 
-class HistogramEqualizationOperation final : public ImageOperation {
+class HistogramEqualizationOperation final : public PointOperation {
     int gMin_, gMax_;
 public:
     explicit HistogramEqualizationOperation(const int gMin, const int gMax) : gMin_(gMin), gMax_(gMax) {
     }
 
-    void apply(cv::Mat &image) const override {
-        std::array<uint, UCHAR_MAX + 1> channelHistogram = HistogramProcessor::computeHistogram(image);
-        image = HistogramProcessor::histogramEqualization(image, channelHistogram, gMax_, gMin_);
+    [[nodiscard]] bool needsHistogram() const override {
+        return true;
+    }
+
+    [[nodiscard]] std::array<uchar, UCHAR_MAX + 1> lookupTable(
+        const std::array<uint, UCHAR_MAX + 1> &histogram) const override {
+        return HistogramProcessor::equalizationLookupTable(histogram, gMax_, gMin_);
     }
 };
@@ -1,23 +1,32 @@
 //
 // Created by gluckasz on 2/4/25.
 //
-#include "../ImageOperation.h"
-#include "input-processing-lib/OutputManager.h"
-#include "image-processing-lib/FourierProcessor.h"
+#include "../SpectralOperation.h"
 
-class LowPassOperation final : public ImageOperation {
+class LowPassOperation final : public SpectralOperation {
     int maskSize_;
+    FourierProcessor::FilterShape shape_;
+    int order_;
 
 public:
-    explicit LowPassOperation(const int maskSize) : maskSize_(maskSize) {
+    explicit LowPassOperation(const int maskSize, const FourierProcessor::FilterShape shape, const int order,
+                              const FourierProcessor::FFTPrecision precision)
+        : SpectralOperation(precision), maskSize_(maskSize), shape_(shape), order_(order) {
     }
 
-    void apply(cv::Mat &image) const override {
-        cv::Mat fourierImage = FourierProcessor::fastFourierTransform(image);
-        fourierImage = FourierProcessor::fftLowPass(fourierImage, maskSize_);
-        const std::string path = OutputManager::constructPath("image_fourier", "magnitude_spectrum", "bmp");
-        FourierProcessor::visualizeFourier(fourierImage, path);
-        image = FourierProcessor::inverseFastFourierTransform(fourierImage);
+    [[nodiscard]] bool needsFullSpectrum() const override {
+        return false;
+    }
+
+    [[nodiscard]] std::optional<FourierProcessor::FrequencyFilter> frequencyFilter() const override {
+        return FourierProcessor::FrequencyFilter{FourierProcessor::FilterType::LOW_PASS, shape_, maskSize_, 0, order_};
     }
-};
 
+    void transformSpectrum(cv::Mat &fourierImage) const override {
+        fourierImage = FourierProcessor::fftLowPass(fourierImage, maskSize_, shape_, order_);
+    }
+
+    void transformHalfSpectrum(FourierProcessor::HalfSpectrum &spectrum) const override {
+        spectrum = FourierProcessor::fftLowPass(spectrum, maskSize_, shape_, order_);
+    }
+};
@@ -1,12 +1,12 @@
 //
 // Created by gluckasz on 2/3/25.
 //
-#include "../ImageOperation.h"
-#include "image-processing-lib/SpatialDomainProcessor.h"
+#include "../PointOperation.h"
 
-class NegativeOperation final : public ImageOperation {
+class NegativeOperation final : public PointOperation {
 public:
-    void apply(cv::Mat &image) const override {
-        image = SpatialDomainProcessor::negative(image);
+    [[nodiscard]] std::array<uchar, UCHAR_MAX + 1> lookupTable(
+        const std::array<uint, UCHAR_MAX + 1> &) const override {
+        return SpatialDomainProcessor::negativeLookupTable();
     }
 };
@@ -6,12 +6,16 @@
 
 class ResizeOperation final : public ImageOperation {
     float delta_;
+    SpatialDomainProcessor::InterpolationMethod method_;
 
 public:
-    explicit ResizeOperation(const float delta) : delta_(delta) {
+    explicit ResizeOperation(const float delta,
+                             const SpatialDomainProcessor::InterpolationMethod method =
+                                     SpatialDomainProcessor::InterpolationMethod::NEAREST)
+        : delta_(delta), method_(method) {
     }
 
     void apply(cv::Mat &image) const override {
-        image = SpatialDomainProcessor::resize(image, delta_);
+        image = SpatialDomainProcessor::resize(image, delta_, method_);
     }
 };
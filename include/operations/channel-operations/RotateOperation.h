@@ -0,0 +1,17 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include "../GeometricOperation.h"
+
+class RotateOperation final : public GeometricOperation {
+    SpatialDomainProcessor::GeometricTransform transform_;
+
+public:
+    explicit RotateOperation(const int degrees)
+        : transform_(SpatialDomainProcessor::GeometricTransform::rotation(degrees)) {
+    }
+
+    [[nodiscard]] SpatialDomainProcessor::GeometricTransform transform() const override {
+        return transform_;
+    }
+};
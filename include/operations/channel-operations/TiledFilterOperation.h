@@ -0,0 +1,22 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include "../ImageOperation.h"
+#include "image-processing-lib/FourierProcessor.h"
+
+class TiledFilterOperation final : public ImageOperation {
+    FourierProcessor::FrequencyFilter filter_;
+    int kernelRadius_;
+    int tileSize_;
+    FourierProcessor::FFTPrecision precision_;
+
+public:
+    explicit TiledFilterOperation(const FourierProcessor::FrequencyFilter &filter, const int kernelRadius,
+                                  const int tileSize, const FourierProcessor::FFTPrecision precision)
+        : filter_(filter), kernelRadius_(kernelRadius), tileSize_(tileSize), precision_(precision) {
+    }
+
+    void apply(cv::Mat &image) const override {
+        image = FourierProcessor::tiledFilter(image, filter_, kernelRadius_, tileSize_, precision_);
+    }
+};
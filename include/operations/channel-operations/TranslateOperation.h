@@ -0,0 +1,27 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include "../SpectralOperation.h"
+
+class TranslateOperation final : public SpectralOperation {
+    double verticalShift_;
+    double horizontalShift_;
+
+public:
+    explicit TranslateOperation(const double verticalShift, const double horizontalShift,
+                                const FourierProcessor::FFTPrecision precision)
+        : SpectralOperation(precision), verticalShift_(verticalShift), horizontalShift_(horizontalShift) {
+    }
+
+    [[nodiscard]] bool needsFullSpectrum() const override {
+        return false;
+    }
+
+    void transformSpectrum(cv::Mat &fourierImage) const override {
+        fourierImage = FourierProcessor::fftTranslate(fourierImage, verticalShift_, horizontalShift_);
+    }
+
+    void transformHalfSpectrum(FourierProcessor::HalfSpectrum &spectrum) const override {
+        spectrum = FourierProcessor::fftTranslate(spectrum, verticalShift_, horizontalShift_);
+    }
+};
@@ -0,0 +1,11 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include "../GeometricOperation.h"
+
+class TransposeOperation final : public GeometricOperation {
+public:
+    [[nodiscard]] SpatialDomainProcessor::GeometricTransform transform() const override {
+        return {true, false, false};
+    }
+};
@@ -0,0 +1,37 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include "../ImageOperation.h"
+#include "input-processing-lib/OutputManager.h"
+#include "image-processing-lib/MorphologicalProcessor.h"
+#include "image-processing-lib/SpatialDomainProcessor.h"
+
+
+class ConnectedComponentsOperation final : public ImageOperation {
+public:
+    void apply(cv::Mat &image) const override {
+        cv::Mat grayscaleImage = image;
+        if (image.channels() != 1) {
+            cvtColor(image, grayscaleImage, cv::COLOR_BGR2GRAY);
+        }
+        std::vector<MorphologicalProcessor::ComponentStats> stats;
+        const cv::Mat labels = MorphologicalProcessor::connectedComponents(grayscaleImage, stats);
+        const cv::Mat coloredLabels = SpatialDomainProcessor::applyColorMap(
+            labels, SpatialDomainProcessor::createColorMap());
+
+        std::stringstream ss;
+        ss << "Connected components: " << stats.size() << "\n"
+                << "label area top left height width centroid_row centroid_col\n";
+        for (size_t i = 0; i < stats.size(); i++) {
+            ss << i + 1 << " " << stats[i].area << " " << stats[i].top << " " << stats[i].left << " "
+                    << stats[i].height << " " << stats[i].width << " "
+                    << stats[i].centroidX << " " << stats[i].centroidY << "\n";
+        }
+
+        OutputManager::saveLabels(labels, "image", "components");
+        std::string path = OutputManager::constructPath("image", "components_colored", "bmp");
+        OutputManager::saveImage(coloredLabels, path);
+        path = OutputManager::constructPath("image", "components_stats", "txt");
+        OutputManager::saveFile(path, ss);
+    }
+};
@@ -0,0 +1,50 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+#include "../ImageOperation.h"
+#include "image-processing-lib/FourierProcessor.h"
+#include "input-processing-lib/OutputManager.h"
+
+class MatchTemplateOperation final : public ImageOperation {
+    cv::Mat template_;
+    int matchCount_;
+    bool saveResponseMap_;
+
+public:
+    explicit MatchTemplateOperation(const std::string &templatePath, const int matchCount, const bool saveResponseMap)
+        : matchCount_(matchCount), saveResponseMap_(saveResponseMap) {
+        template_ = cv::imread(templatePath, cv::IMREAD_GRAYSCALE);
+        if (template_.empty()) {
+            throw std::invalid_argument("Could not open template file: " + templatePath);
+        }
+    }
+
+    void apply(cv::Mat &image) const override {
+        cv::Mat grayscaleImage = image;
+        if (image.channels() != 1) {
+            cvtColor(image, grayscaleImage, cv::COLOR_BGR2GRAY);
+        }
+        const cv::Mat response = FourierProcessor::matchTemplate(grayscaleImage, template_);
+        const std::vector<FourierProcessor::TemplateMatch> matches = FourierProcessor::findMatches(
+            response, template_.size(), matchCount_);
+
+        std::stringstream ss;
+        ss << "Template matches (row, column of the top left corner, normalized cross-correlation):\n";
+        for (const auto &match: matches) {
+            ss << match.x << " " << match.y << " " << match.score << "\n";
+        }
+        OutputManager::saveFile(OutputManager::constructPath("image", "template_matches", "txt"), ss);
+
+        if (saveResponseMap_) {
+            cv::Mat responseMap(response.rows, response.cols, CV_8UC1);
+            for (int x = 0; x < response.rows; x++) {
+                for (int y = 0; y < response.cols; y++) {
+                    responseMap.at<uchar>(x, y) = static_cast<uchar>(
+                        std::round(std::max(response.at<double>(x, y), 0.0) * UCHAR_MAX));
+                }
+            }
+            OutputManager::saveImage(responseMap,
+                                     OutputManager::constructPath("image", "template_response", "bmp"));
+        }
+    }
+};
@@ -25,9 +25,8 @@ public:
             segmentedColorImage = SpatialDomainProcessor::applyColorMap(
                 segmentedImage, SpatialDomainProcessor::createColorMap());
         }
-        std::string path = OutputManager::constructPath("image", "after_segmentation", "bmp");
-        OutputManager::saveImage(segmentedImage, path);
-        path = OutputManager::constructPath("image", "after_segmentation_colored", "bmp");
+        OutputManager::saveLabels(segmentedImage, "image", "after_segmentation");
+        const std::string path = OutputManager::constructPath("image", "after_segmentation_colored", "bmp");
         OutputManager::saveImage(segmentedColorImage, path);
     }
 };
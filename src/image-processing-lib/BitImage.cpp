@@ -0,0 +1,67 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#include "../../include/image-processing-lib/BitImage.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+BitImage::BitImage(const int rows, const int cols) {
+    if (rows < 0 || cols < 0) {
+        throw std::invalid_argument("Image size cannot be negative");
+    }
+    rows_ = rows;
+    cols_ = cols;
+    wordsPerRow_ = (cols + WORD_BITS - 1) / WORD_BITS;
+    words_.assign(static_cast<size_t>(rows) * wordsPerRow_, 0);
+}
+
+BitImage BitImage::fromMat(const cv::Mat &image) {
+    if (!image.empty() && image.type() != CV_8UC1) {
+        throw std::invalid_argument("Only single channel binary images can be packed");
+    }
+    BitImage result(image.rows, image.cols);
+#pragma omp parallel for
+    for (int x = 0; x < image.rows; x++) {
+        const uchar *imageRow = image.ptr<uchar>(x);
+        uint64_t *resultRow = result.row(x);
+        for (int word = 0; word < result.wordsPerRow_; word++) {
+            const int begin = word * WORD_BITS;
+            const int end = std::min(begin + WORD_BITS, image.cols);
+            uint64_t bits = 0;
+            for (int y = begin; y < end; y++) {
+                bits |= static_cast<uint64_t>(imageRow[y] != 0) << (y - begin);
+            }
+            resultRow[word] = bits;
+        }
+    }
+    return result;
+}
+
+cv::Mat BitImage::toMat() const {
+    cv::Mat result(rows_, cols_, CV_8UC1);
+#pragma omp parallel for
+    for (int x = 0; x < rows_; x++) {
+        const uint64_t *bitRow = row(x);
+        uchar *resultRow = result.ptr<uchar>(x);
+        for (int y = 0; y < cols_; y++) {
+            resultRow[y] = (bitRow[y / WORD_BITS] >> (y % WORD_BITS) & 1) ? 255 : 0;
+        }
+    }
+    return result;
+}
+
+void BitImage::set(const int x, const int y, const bool value) {
+    const uint64_t bit = uint64_t{1} << (y % WORD_BITS);
+    if (value) {
+        row(x)[y / WORD_BITS] |= bit;
+    } else {
+        row(x)[y / WORD_BITS] &= ~bit;
+    }
+}
+
+uint64_t BitImage::lastWordMask() const {
+    const int usedBits = cols_ - (wordsPerRow_ - 1) * WORD_BITS;
+    return usedBits == WORD_BITS ? ~uint64_t{0} : (uint64_t{1} << usedBits) - 1;
+}
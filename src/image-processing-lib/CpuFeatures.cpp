@@ -0,0 +1,27 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#include "../../include/image-processing-lib/CpuFeatures.h"
+
+namespace {
+    CpuFeatures::SimdLevel detectSimdLevel() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return CpuFeatures::SimdLevel::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return CpuFeatures::SimdLevel::SSE4;
+        }
+#endif
+        return CpuFeatures::SimdLevel::SCALAR;
+    }
+}
+
+namespace CpuFeatures {
+    SimdLevel simdLevel() {
+        static const SimdLevel level = detectSimdLevel();
+        return level;
+    }
+}
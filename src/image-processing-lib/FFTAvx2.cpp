@@ -0,0 +1,102 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#include "../../include/image-processing-lib/FFTKernels.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+
+namespace {
+    // Four interleaved complex floats per vector, the offsets left at the end of a group use masked loads
+    constexpr int LANES = 4;
+
+    template<bool Masked>
+    __m256 load(const float *values, const __m256i mask) {
+        if constexpr (Masked) {
+            return _mm256_maskload_ps(values, mask);
+        } else {
+            return _mm256_loadu_ps(values);
+        }
+    }
+
+    template<bool Masked>
+    void store(float *values, const __m256 value, const __m256i mask) {
+        if constexpr (Masked) {
+            _mm256_maskstore_ps(values, mask, value);
+        } else {
+            _mm256_storeu_ps(values, value);
+        }
+    }
+
+    /**
+     * Every operation works within the pairs of floats, so the 128-bit halves need no fix-up.
+     */
+    __m256 multiply(const __m256 first, const __m256 second) {
+        const __m256 swapped = _mm256_permute_ps(first, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm256_addsub_ps(_mm256_mul_ps(first, _mm256_moveldup_ps(second)),
+                                _mm256_mul_ps(swapped, _mm256_movehdup_ps(second)));
+    }
+
+    __m256 rotate(const __m256 value, const bool inverse) {
+        const __m256 swapped = _mm256_permute_ps(value, _MM_SHUFFLE(2, 3, 0, 1));
+        const __m256 sign = inverse
+                                ? _mm256_set_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f)
+                                : _mm256_set_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f);
+        return _mm256_xor_ps(swapped, sign);
+    }
+
+    /**
+     * Butterfly of LANES consecutive offsets (or the ones selected by the mask). Offsets and lengths count floats.
+     */
+    template<bool Masked>
+    void radix4Butterfly(const float *source, float *target, const float *twiddles, const int groupLength,
+                         const int stride, const bool inverse, const __m256i mask) {
+        const __m256 first = load<Masked>(source, mask);
+        const __m256 second = multiply(load<Masked>(source + groupLength, mask), load<Masked>(twiddles, mask));
+        const __m256 third = multiply(load<Masked>(source + 2 * groupLength, mask),
+                                      load<Masked>(twiddles + stride, mask));
+        const __m256 fourth = multiply(load<Masked>(source + 3 * groupLength, mask),
+                                       load<Masked>(twiddles + 2 * stride, mask));
+        const __m256 evenSum = _mm256_add_ps(first, third);
+        const __m256 evenDifference = _mm256_sub_ps(first, third);
+        const __m256 oddSum = _mm256_add_ps(second, fourth);
+        const __m256 oddDifference = rotate(_mm256_sub_ps(second, fourth), inverse);
+        store<Masked>(target, _mm256_add_ps(evenSum, oddSum), mask);
+        store<Masked>(target + stride, _mm256_add_ps(evenDifference, oddDifference), mask);
+        store<Masked>(target + 2 * stride, _mm256_sub_ps(evenSum, oddSum), mask);
+        store<Masked>(target + 3 * stride, _mm256_sub_ps(evenDifference, oddDifference), mask);
+    }
+
+    void radix4Stage(const float *source, float *target, const float *twiddles, const int groupCount,
+                     const int stride, const bool inverse) {
+        const int groupLength = groupCount * stride;
+        // Both floats of the first stride % LANES complex values
+        const __m256i tailMask = _mm256_cmpgt_epi32(_mm256_set1_epi32(stride % LANES),
+                                                    _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3));
+        for (int group = 0; group < groupCount; group++) {
+            const float *groupSource = source + 2 * group * stride;
+            float *groupTarget = target + 8 * group * stride;
+            int k = 0;
+            for (; k + LANES <= stride; k += LANES) {
+                radix4Butterfly<false>(groupSource + 2 * k, groupTarget + 2 * k, twiddles + 2 * k,
+                                       2 * groupLength, 2 * stride, inverse, tailMask);
+            }
+            if (k < stride) {
+                radix4Butterfly<true>(groupSource + 2 * k, groupTarget + 2 * k, twiddles + 2 * k,
+                                      2 * groupLength, 2 * stride, inverse, tailMask);
+            }
+        }
+    }
+}
+#endif
+
+namespace FFTKernels {
+    Radix4Function avx2Radix4Function() {
+#ifdef __AVX2__
+        return &radix4Stage;
+#else
+        return nullptr;
+#endif
+    }
+}
@@ -0,0 +1,60 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#include "../../include/image-processing-lib/FFTKernels.h"
+
+namespace {
+    /**
+     * Butterfly of a single offset. Offsets and lengths count floats.
+     */
+    void radix4Butterfly(const float *source, float *target, const float *twiddles, const int groupLength,
+                         const int stride, const bool inverse) {
+        auto multiply = [](const float *value, const float *twiddle, float *product) {
+            product[0] = value[0] * twiddle[0] - value[1] * twiddle[1];
+            product[1] = value[0] * twiddle[1] + value[1] * twiddle[0];
+        };
+        float second[2];
+        float third[2];
+        float fourth[2];
+        multiply(source + groupLength, twiddles, second);
+        multiply(source + 2 * groupLength, twiddles + stride, third);
+        multiply(source + 3 * groupLength, twiddles + 2 * stride, fourth);
+
+        const float evenSum[2] = {source[0] + third[0], source[1] + third[1]};
+        const float evenDifference[2] = {source[0] - third[0], source[1] - third[1]};
+        const float oddSum[2] = {second[0] + fourth[0], second[1] + fourth[1]};
+        // Multiply the odd difference by -i (forward transform) or by i (inverse transform)
+        const float difference[2] = {second[0] - fourth[0], second[1] - fourth[1]};
+        const float oddDifference[2] = {
+            inverse ? -difference[1] : difference[1],
+            inverse ? difference[0] : -difference[0]
+        };
+
+        for (int part = 0; part < 2; part++) {
+            target[part] = evenSum[part] + oddSum[part];
+            target[stride + part] = evenDifference[part] + oddDifference[part];
+            target[2 * stride + part] = evenSum[part] - oddSum[part];
+            target[3 * stride + part] = evenDifference[part] - oddDifference[part];
+        }
+    }
+
+    void radix4Stage(const float *source, float *target, const float *twiddles, const int groupCount,
+                     const int stride, const bool inverse) {
+        const int groupLength = groupCount * stride;
+        for (int group = 0; group < groupCount; group++) {
+            const float *groupSource = source + 2 * group * stride;
+            float *groupTarget = target + 8 * group * stride;
+            for (int k = 0; k < stride; k++) {
+                radix4Butterfly(groupSource + 2 * k, groupTarget + 2 * k, twiddles + 2 * k, 2 * groupLength,
+                                2 * stride, inverse);
+            }
+        }
+    }
+}
+
+namespace FFTKernels {
+    Radix4Function scalarRadix4Function() {
+        return &radix4Stage;
+    }
+}
@@ -0,0 +1,94 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#include "../../include/image-processing-lib/FFTKernels.h"
+
+#ifdef __SSE4_1__
+#include <immintrin.h>
+
+namespace {
+    // Two interleaved complex floats per vector, the odd offset left at the end of a group uses the low half
+    constexpr int LANES = 2;
+
+    template<bool Single>
+    __m128 load(const float *values) {
+        if constexpr (Single) {
+            return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(values)));
+        } else {
+            return _mm_loadu_ps(values);
+        }
+    }
+
+    template<bool Single>
+    void store(float *values, const __m128 value) {
+        if constexpr (Single) {
+            _mm_store_sd(reinterpret_cast<double *>(values), _mm_castps_pd(value));
+        } else {
+            _mm_storeu_ps(values, value);
+        }
+    }
+
+    __m128 multiply(const __m128 first, const __m128 second) {
+        // (a + bi)(c + di): addsub of (ac, bc) and (bd, ad) gives (ac - bd, bc + ad)
+        const __m128 swapped = _mm_shuffle_ps(first, first, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm_addsub_ps(_mm_mul_ps(first, _mm_moveldup_ps(second)),
+                             _mm_mul_ps(swapped, _mm_movehdup_ps(second)));
+    }
+
+    __m128 rotate(const __m128 value, const bool inverse) {
+        // Swap the parts and negate the new real (inverse) or imaginary (forward) ones
+        const __m128 swapped = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+        const __m128 sign = inverse ? _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f) : _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+        return _mm_xor_ps(swapped, sign);
+    }
+
+    /**
+     * Butterfly of LANES consecutive offsets (or a single one). Offsets and lengths count floats.
+     */
+    template<bool Single>
+    void radix4Butterfly(const float *source, float *target, const float *twiddles, const int groupLength,
+                         const int stride, const bool inverse) {
+        const __m128 first = load<Single>(source);
+        const __m128 second = multiply(load<Single>(source + groupLength), load<Single>(twiddles));
+        const __m128 third = multiply(load<Single>(source + 2 * groupLength), load<Single>(twiddles + stride));
+        const __m128 fourth = multiply(load<Single>(source + 3 * groupLength), load<Single>(twiddles + 2 * stride));
+        const __m128 evenSum = _mm_add_ps(first, third);
+        const __m128 evenDifference = _mm_sub_ps(first, third);
+        const __m128 oddSum = _mm_add_ps(second, fourth);
+        const __m128 oddDifference = rotate(_mm_sub_ps(second, fourth), inverse);
+        store<Single>(target, _mm_add_ps(evenSum, oddSum));
+        store<Single>(target + stride, _mm_add_ps(evenDifference, oddDifference));
+        store<Single>(target + 2 * stride, _mm_sub_ps(evenSum, oddSum));
+        store<Single>(target + 3 * stride, _mm_sub_ps(evenDifference, oddDifference));
+    }
+
+    void radix4Stage(const float *source, float *target, const float *twiddles, const int groupCount,
+                     const int stride, const bool inverse) {
+        const int groupLength = groupCount * stride;
+        for (int group = 0; group < groupCount; group++) {
+            const float *groupSource = source + 2 * group * stride;
+            float *groupTarget = target + 8 * group * stride;
+            int k = 0;
+            for (; k + LANES <= stride; k += LANES) {
+                radix4Butterfly<false>(groupSource + 2 * k, groupTarget + 2 * k, twiddles + 2 * k,
+                                       2 * groupLength, 2 * stride, inverse);
+            }
+            if (k < stride) {
+                radix4Butterfly<true>(groupSource + 2 * k, groupTarget + 2 * k, twiddles + 2 * k,
+                                      2 * groupLength, 2 * stride, inverse);
+            }
+        }
+    }
+}
+#endif
+
+namespace FFTKernels {
+    Radix4Function sse4Radix4Function() {
+#ifdef __SSE4_1__
+        return &radix4Stage;
+#else
+        return nullptr;
+#endif
+    }
+}
@@ -3,102 +3,933 @@
 //
 
 #include "../include/image-processing-lib/FourierProcessor.h"
+#include "../include/image-processing-lib/CpuFeatures.h"
+#include "../include/image-processing-lib/FFTKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <tuple>
 
 namespace {
+    using Complex = std::complex<double>;
+
+    /**
+     * Radices of the mixed-radix FFT, in the order their stages are run.
+     */
+    constexpr std::array<int, 5> FFT_RADICES = {4, 2, 3, 5, 7};
+    constexpr int MAX_RADIX = 7;
+
+    /**
+     * Split a transform length into radices of the mixed-radix FFT.
+     * @param length Transform length
+     * @param radices Output radices, their product is the length
+     * @return False if the length has a prime factor the mixed-radix FFT does not handle
+     */
+    bool factorize(int length, std::vector<int> &radices) {
+        radices.clear();
+        for (const int radix: FFT_RADICES) {
+            while (length % radix == 0) {
+                radices.push_back(radix);
+                length /= radix;
+            }
+        }
+        return length == 1;
+    }
+
+    /**
+     * Roots of unity exp(-2 pi i k / radix) used by the generic small DFT.
+     */
+    const std::array<Complex, MAX_RADIX> &radixRoots(const int radix) {
+        static const auto roots = [] {
+            std::array<std::array<Complex, MAX_RADIX>, MAX_RADIX + 1> table{};
+            for (int r = 1; r <= MAX_RADIX; r++) {
+                for (int k = 0; k < r; k++) {
+                    table[r][k] = std::polar(1.0, -2 * std::numbers::pi * k / r);
+                }
+            }
+            return table;
+        }();
+        return roots[radix];
+    }
+
+    /**
+     * In place DFT of a few values. Radices 2, 3 and 4 have dedicated butterflies, the others
+     * go through the direct sum.
+     * @param values Values to transform
+     * @param radix Number of values
+     * @param inverse Use positive exponents
+     */
+    template<typename T>
+    void butterfly(std::complex<T> *values, const int radix, const bool inverse) {
+        using TComplex = std::complex<T>;
+        // Multiplication by -i for the forward and by i for the inverse transform
+        const auto rotate = [inverse](const TComplex value) {
+            return inverse ? TComplex(-value.imag(), value.real()) : TComplex(value.imag(), -value.real());
+        };
+        switch (radix) {
+            case 2: {
+                const TComplex sum = values[0] + values[1];
+                values[1] = values[0] - values[1];
+                values[0] = sum;
+                return;
+            }
+            case 3: {
+                const TComplex sum = values[1] + values[2];
+                const TComplex middle = values[0] - static_cast<T>(0.5) * sum;
+                const TComplex difference = rotate(values[1] - values[2]) * static_cast<T>(std::numbers::sqrt3 / 2);
+                values[0] += sum;
+                values[1] = middle + difference;
+                values[2] = middle - difference;
+                return;
+            }
+            case 4: {
+                const TComplex evenSum = values[0] + values[2];
+                const TComplex evenDifference = values[0] - values[2];
+                const TComplex oddSum = values[1] + values[3];
+                const TComplex oddDifference = rotate(values[1] - values[3]);
+                values[0] = evenSum + oddSum;
+                values[1] = evenDifference + oddDifference;
+                values[2] = evenSum - oddSum;
+                values[3] = evenDifference - oddDifference;
+                return;
+            }
+            default: {
+                const auto &roots = radixRoots(radix);
+                std::array<TComplex, MAX_RADIX> result{};
+                for (int q = 0; q < radix; q++) {
+                    for (int r = 0; r < radix; r++) {
+                        const TComplex root(roots[r * q % radix]);
+                        result[q] += values[r] * (inverse ? std::conj(root) : root);
+                    }
+                }
+                std::copy_n(result.begin(), radix, values);
+            }
+        }
+    }
+
+    /**
+     * Move the zero frequency from the corner to (rows / 2, cols / 2) or back. Odd sizes are handled
+     * by rotating rows and columns, so the two directions are not the same permutation.
+     * @param spectrum CV_32FC2 or CV_64FC2 spectrum
+     * @param inverse Move the zero frequency back to the corner
+     * @return Shifted spectrum
+     */
+    template<typename T>
+    cv::Mat shiftSpectrum(const cv::Mat &spectrum, const bool inverse) {
+        const int M = spectrum.rows;
+        const int N = spectrum.cols;
+        const int rowShift = inverse ? (M + 1) / 2 : M / 2;
+        const int colShift = inverse ? (N + 1) / 2 : N / 2;
+        cv::Mat shifted(M, N, spectrum.type());
+#pragma omp parallel for
+        for (int u = 0; u < M; u++) {
+            const auto *sourceRow = spectrum.ptr<cv::Vec<T, 2> >(u);
+            auto *targetRow = shifted.ptr<cv::Vec<T, 2> >((u + rowShift) % M);
+            for (int v = 0; v < N; v++) {
+                targetRow[(v + colShift) % N] = sourceRow[v];
+            }
+        }
+        return shifted;
+    }
+
+    /**
+     * Matrix type of complex values of a precision.
+     */
+    template<typename T>
+    constexpr int complexType() {
+        return std::is_same_v<T, float> ? CV_32FC2 : CV_64FC2;
+    }
+
+    /**
+     * Side of the square tiles of the blocked transpose, a source and a destination tile
+     * of complex doubles take 32 KiB together.
+     */
+    constexpr int TRANSPOSE_BLOCK_SIZE = 32;
+
+    /**
+     * Scratch buffer of the calling thread, reused by every transform the thread runs.
+     * @param size Minimum number of values
+     */
+    template<typename T>
+    std::complex<T> *threadScratch(const int size) {
+        thread_local std::vector<std::complex<T> > scratch;
+        if (scratch.size() < static_cast<size_t>(size)) {
+            scratch.resize(size);
+        }
+        return scratch.data();
+    }
+
+    /**
+     * Transpose a complex image tile by tile, so that both the reads and the writes stay in the cache.
+     * @param source Image to transpose
+     * @param target Image of the same type and the transposed size
+     */
+    template<typename T>
+    void transposeSpectrum(const cv::Mat &source, cv::Mat &target) {
+        const int rows = target.rows;
+        const int cols = target.cols;
+        const int rowBlocks = (rows + TRANSPOSE_BLOCK_SIZE - 1) / TRANSPOSE_BLOCK_SIZE;
+        const int colBlocks = (cols + TRANSPOSE_BLOCK_SIZE - 1) / TRANSPOSE_BLOCK_SIZE;
+#pragma omp parallel for collapse(2)
+        for (int rowBlock = 0; rowBlock < rowBlocks; rowBlock++) {
+            for (int colBlock = 0; colBlock < colBlocks; colBlock++) {
+                const int rowEnd = std::min(rows, (rowBlock + 1) * TRANSPOSE_BLOCK_SIZE);
+                const int colEnd = std::min(cols, (colBlock + 1) * TRANSPOSE_BLOCK_SIZE);
+                for (int x = rowBlock * TRANSPOSE_BLOCK_SIZE; x < rowEnd; x++) {
+                    auto *targetRow = target.ptr<cv::Vec<T, 2> >(x);
+                    for (int y = colBlock * TRANSPOSE_BLOCK_SIZE; y < colEnd; y++) {
+                        targetRow[y] = source.ptr<cv::Vec<T, 2> >(y)[x];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Transform every row of a complex image in place.
+     */
+    template<typename T>
+    void transformRows(cv::Mat &complexImage, const FourierProcessor::BasicFFTPlan<T> &plan) {
+#pragma omp parallel for
+        for (int x = 0; x < complexImage.rows; x++) {
+            // cv::Vec<T, 2> and std::complex<T> are both two adjacent values
+            plan.execute(reinterpret_cast<std::complex<T> *>(complexImage.ptr<cv::Vec<T, 2> >(x)),
+                         threadScratch<T>(plan.scratchSize()));
+        }
+    }
+
+    /**
+     * Transform every column of a complex image in place: the columns are turned into contiguous rows
+     * with a blocked transpose, transformed and transposed back.
+     */
+    template<typename T>
+    void transformColumns(cv::Mat &complexImage, const FourierProcessor::BasicFFTPlan<T> &plan) {
+        cv::Mat transposed(complexImage.cols, complexImage.rows, complexImage.type());
+        transposeSpectrum<T>(complexImage, transposed);
+        transformRows(transposed, plan);
+        transposeSpectrum<T>(transposed, complexImage);
+    }
+
+    /**
+     * Run the 2D transform of a complex image in place.
+     */
+    template<typename T>
+    void transform2D(cv::Mat &complexImage, const bool inverse) {
+        transformRows(complexImage, *FourierProcessor::BasicFFTPlan<T>::get(complexImage.cols, inverse));
+        transformColumns(complexImage, *FourierProcessor::BasicFFTPlan<T>::get(complexImage.rows, inverse));
+    }
+
+    /**
+     * Compute the DFT of every row of a CV_64FC2 image in place by direct summation (O(cols^2) per row).
+     * Exact for every length, used where the FFT is not wanted.
+     */
+    void directTransformRows(cv::Mat &complexImage, const bool inverse) {
+        const int N = complexImage.cols;
+        // exp(-+2 pi i k / N), the root of the product v * y is looked up modulo N
+        std::vector<Complex> roots(N);
+        for (int k = 0; k < N; k++) {
+            roots[k] = std::polar(1.0, (inverse ? 2.0 : -2.0) * std::numbers::pi * k / N);
+        }
+#pragma omp parallel for
+        for (int x = 0; x < complexImage.rows; x++) {
+            auto *row = reinterpret_cast<Complex *>(complexImage.ptr<cv::Vec2d>(x));
+            Complex *transformed = threadScratch<double>(N);
+            for (int v = 0; v < N; v++) {
+                Complex sum = 0;
+                int rootIndex = 0;
+                for (int y = 0; y < N; y++) {
+                    sum += row[y] * roots[rootIndex];
+                    rootIndex += v;
+                    if (rootIndex >= N) {
+                        rootIndex -= N;
+                    }
+                }
+                transformed[v] = sum;
+            }
+            std::copy_n(transformed, N, row);
+        }
+    }
+
+    /**
+     * Compute the 2D DFT of a CV_64FC2 image in place by direct summation, separably: rows first, then
+     * the columns as rows of the blocked transpose (O(rows * cols * (rows + cols))).
+     */
+    void directTransform2D(cv::Mat &complexImage, const bool inverse) {
+        directTransformRows(complexImage, inverse);
+        cv::Mat transposed(complexImage.cols, complexImage.rows, CV_64FC2);
+        transposeSpectrum<double>(complexImage, transposed);
+        directTransformRows(transposed, inverse);
+        transposeSpectrum<double>(transposed, complexImage);
+    }
+
+    template<typename T>
+    std::complex<T> toComplex(const cv::Vec<T, 2> &value) {
+        return {value[0], value[1]};
+    }
+
+    template<typename T>
+    cv::Vec<T, 2> toVec(const std::complex<T> &value) {
+        return {value.real(), value.imag()};
+    }
+
+    /**
+     * Convert an unnormalized inverse transform value to a pixel.
+     */
+    uchar toPixel(const double value, const double scale) {
+        return static_cast<uchar>(std::clamp(std::round(std::abs(value) * scale), 0.0, 255.0));
+    }
+
+    /**
+     * Gain of a low-pass filter at a distance from the zero frequency.
+     */
+    double lowPassGain(const FourierProcessor::FilterShape shape, const double distance, const int cutoff,
+                       const int order) {
+        if (shape == FourierProcessor::FilterShape::IDEAL || cutoff <= 0) {
+            return distance < cutoff ? 1.0 : 0.0;
+        }
+        const double ratio = distance / cutoff;
+        if (shape == FourierProcessor::FilterShape::BUTTERWORTH) {
+            return 1.0 / (1.0 + std::pow(ratio, 2 * order));
+        }
+        return std::exp(-ratio * ratio / 2);
+    }
+
+    /**
+     * Gain of a high-pass filter at a distance from the zero frequency. The zero frequency (mean brightness)
+     * is always passed.
+     */
+    double highPassGain(const FourierProcessor::FilterShape shape, const double distance, const int cutoff,
+                        const int order) {
+        if (distance == 0) {
+            return 1.0;
+        }
+        if (shape == FourierProcessor::FilterShape::IDEAL) {
+            return distance > cutoff ? 1.0 : 0.0;
+        }
+        return 1.0 - lowPassGain(shape, distance, cutoff, order);
+    }
+
     /**
-     * Perform 1D Fast Fourier Transform on image row.
-     * @param row Image row to transform
+     * Whether the direction of frequency (u, v) lies in the wedge of a directional filter. Edges at an angle
+     * concentrate their energy on the perpendicular frequency direction (cos(angle), sin(angle)).
      */
-    void FFT1D(cv::Mat row) {
-        const int N = row.cols;
-        int j = 0;
-        for (int i = 0; i < N; i++) {
-            if (i < j) {
-                std::swap(row.at<cv::Vec2d>(i)[0], row.at<cv::Vec2d>(j)[0]);
-                std::swap(row.at<cv::Vec2d>(i)[1], row.at<cv::Vec2d>(j)[1]);
-            }
-            int bit = N >> 1;
-            while (j & bit) {
-                j ^= bit;
-                bit >>= 1;
-            }
-            j |= bit;
-        }
-
-        for (int len = 2; len <= N; len <<= 1) {
-            const double theta = -2.0f * std::numbers::pi / len;
-            const std::complex wLen(std::cos(theta), std::sin(theta));
-            for (int i = 0; i < N; i += len) {
-                std::complex<double> w(1, 0);
-                for (int k = 0; k < len / 2; k++) {
-                    std::complex u(row.at<cv::Vec2d>(i + k)[0], row.at<cv::Vec2d>(i + k)[1]);
-
-                    std::complex t(row.at<cv::Vec2d>(i + k + len / 2)[0], row.at<cv::Vec2d>(i + k + len / 2)[1]);
-                    t *= w;
-
-                    std::complex<double> result1 = u + t;
-                    std::complex<double> result2 = u - t;
-
-                    row.at<cv::Vec2d>(i + k)[0] = result1.real();
-                    row.at<cv::Vec2d>(i + k)[1] = result1.imag();
-
-                    row.at<cv::Vec2d>(i + k + len / 2)[0] = result2.real();
-                    row.at<cv::Vec2d>(i + k + len / 2)[1] = result2.imag();
-                    w *= wLen;
+    bool isInWedge(const FourierProcessor::FrequencyFilter &filter, const double u, const double v) {
+        const double direction = std::atan2(v, u) * 180 / std::numbers::pi;
+        // Opposite directions belong to the same wedge
+        const double difference = std::fmod(std::abs(direction - filter.angle), 180.0);
+        return std::min(difference, 180.0 - difference) <= filter.angularWidth / 2;
+    }
+
+    /**
+     * Gain of a filter at frequency (u, v), which is fractional when the filter is sampled on a grid
+     * of another size than the image it was designed for.
+     */
+    double filterGain(const FourierProcessor::FrequencyFilter &filter, const double u, const double v) {
+        using FourierProcessor::FilterType;
+        const double distance = std::sqrt(u * u + v * v);
+        switch (filter.type) {
+            case FilterType::LOW_PASS:
+                return lowPassGain(filter.shape, distance, filter.cutoff, filter.order);
+            case FilterType::HIGH_PASS:
+                return highPassGain(filter.shape, distance, filter.cutoff, filter.order);
+            case FilterType::BAND_PASS:
+                return highPassGain(filter.shape, distance, filter.cutoff, filter.order)
+                       * lowPassGain(filter.shape, distance, filter.upperCutoff, filter.order);
+            case FilterType::BAND_CUT:
+                if (distance == 0) {
+                    return 1.0;
+                }
+                if (filter.shape == FourierProcessor::FilterShape::IDEAL) {
+                    return distance >= filter.cutoff && distance <= filter.upperCutoff ? 0.0 : 1.0;
+                }
+                return 1.0 - highPassGain(filter.shape, distance, filter.cutoff, filter.order)
+                             * lowPassGain(filter.shape, distance, filter.upperCutoff, filter.order);
+            case FilterType::DIRECTIONAL_HIGH_PASS:
+                if (distance == 0) {
+                    return 1.0;
+                }
+                return isInWedge(filter, u, v) ? highPassGain(filter.shape, distance, filter.cutoff, filter.order) : 0.0;
+        }
+        return 1.0;
+    }
+
+    /**
+     * Evaluate the gains of a filter over a spectrum, which is either shifted (zero frequency
+     * at (rows / 2, cols / 2)) or an unshifted half spectrum of an image with cols columns.
+     */
+    cv::Mat buildFilterMask(const FourierProcessor::FrequencyFilter &filter, const int rows, const int cols,
+                            const bool halfSpectrum) {
+        const int maskCols = halfSpectrum ? cols / 2 + 1 : cols;
+        cv::Mat mask(rows, maskCols, CV_64FC1);
+#pragma omp parallel for
+        for (int x = 0; x < rows; x++) {
+            const int u = halfSpectrum ? x < (rows + 1) / 2 ? x : x - rows : x - rows / 2;
+            auto *maskRow = mask.ptr<double>(x);
+            for (int y = 0; y < maskCols; y++) {
+                const int v = halfSpectrum ? y : y - cols / 2;
+                maskRow[y] = filterGain(filter, u, v);
+            }
+        }
+        return mask;
+    }
+
+    /**
+     * Multiply every frequency of a spectrum by its gain.
+     */
+    template<typename T>
+    void multiplyByMask(cv::Mat &spectrum, const cv::Mat &mask) {
+#pragma omp parallel for
+        for (int x = 0; x < spectrum.rows; x++) {
+            auto *spectrumRow = spectrum.ptr<cv::Vec<T, 2> >(x);
+            const auto *maskRow = mask.ptr<double>(x);
+            for (int y = 0; y < spectrum.cols; y++) {
+                const T gain = static_cast<T>(maskRow[y]);
+                spectrumRow[y][0] *= gain;
+                spectrumRow[y][1] *= gain;
+            }
+        }
+    }
+
+    /**
+     * Filter a copy of a spectrum in the given layout.
+     */
+    cv::Mat filterSpectrum(const cv::Mat &spectrum, const FourierProcessor::FrequencyFilter &filter, const int cols,
+                           const bool halfSpectrum) {
+        if (spectrum.type() != CV_32FC2 && spectrum.type() != CV_64FC2) {
+            throw std::invalid_argument("Spectrum must be of type CV_32FC2 or CV_64FC2");
+        }
+        const cv::Mat mask = FourierProcessor::filterMask(filter, spectrum.rows, cols, halfSpectrum);
+        cv::Mat result = spectrum.clone();
+        if (result.depth() == CV_32F) {
+            multiplyByMask<float>(result, mask);
+        } else {
+            multiplyByMask<double>(result, mask);
+        }
+        return result;
+    }
+
+    /**
+     * Pick the widest radix-4 kernel of the single precision FFT which both the library and the processor support.
+     */
+    FFTKernels::Radix4Function radix4Function() {
+        static const FFTKernels::Radix4Function function = [] {
+            const CpuFeatures::SimdLevel simdLevel = CpuFeatures::simdLevel();
+            if (simdLevel == CpuFeatures::SimdLevel::AVX2) {
+                if (const auto avx2Function = FFTKernels::avx2Radix4Function(); avx2Function != nullptr) {
+                    return avx2Function;
+                }
+            }
+            if (simdLevel >= CpuFeatures::SimdLevel::SSE4) {
+                if (const auto sse4Function = FFTKernels::sse4Radix4Function(); sse4Function != nullptr) {
+                    return sse4Function;
                 }
             }
+            return FFTKernels::scalarRadix4Function();
+        }();
+        return function;
+    }
+
+    template<typename T>
+    cv::Mat forwardTransform(const cv::Mat &image, const int M, const int N) {
+        cv::Mat fourierImage = cv::Mat::zeros(M, N, complexType<T>());
+
+#pragma omp parallel for
+        for (int x = 0; x < image.rows; x++) {
+            const uchar *imageRow = image.ptr<uchar>(x);
+            auto *fourierRow = fourierImage.ptr<cv::Vec<T, 2> >(x);
+            for (int y = 0; y < image.cols; y++) {
+                fourierRow[y][0] = imageRow[y];
+            }
+        }
+
+        transform2D<T>(fourierImage, false);
+        return shiftSpectrum<T>(fourierImage, false);
+    }
+
+    /**
+     * Compute the half spectra of equally sized images in one batch. The rows of all images are taken
+     * as one sequence and transformed in pairs (a row pair can span two images), the half spectra are
+     * placed side by side, so all their columns are transformed by one transformColumns call.
+     */
+    template<typename T>
+    std::vector<FourierProcessor::HalfSpectrum> realForwardTransform(const std::vector<cv::Mat> &images, const int M,
+                                                                     const int N) {
+        using TComplex = std::complex<T>;
+        const int H = N / 2 + 1;
+        const int imageRows = images.front().rows;
+        const int imageCols = images.front().cols;
+        const int rowCount = static_cast<int>(images.size()) * imageRows;
+        cv::Mat stacked = cv::Mat::zeros(M, static_cast<int>(images.size()) * H, complexType<T>());
+        const auto rowPlan = FourierProcessor::BasicFFTPlan<T>::get(N, false);
+
+#pragma omp parallel for
+        for (int pair = 0; pair < (rowCount + 1) / 2; pair++) {
+            TComplex *packed = threadScratch<T>(N + rowPlan->scratchSize());
+            TComplex *scratch = packed + N;
+            // Rows a and b are transformed together as z = a + ib, so Z(v) = A(v) + iB(v)
+            // and conj(Z(N - v)) = A(v) - iB(v)
+            const int row = 2 * pair;
+            const bool hasSecond = row + 1 < rowCount;
+            const uchar *first = images[row / imageRows].ptr<uchar>(row % imageRows);
+            const uchar *second = hasSecond ? images[(row + 1) / imageRows].ptr<uchar>((row + 1) % imageRows) : nullptr;
+            for (int y = 0; y < imageCols; y++) {
+                packed[y] = TComplex(first[y], hasSecond ? second[y] : 0);
+            }
+            std::fill(packed + imageCols, packed + N, TComplex());
+            rowPlan->execute(packed, scratch);
+
+            auto *firstRow = stacked.ptr<cv::Vec<T, 2> >(row % imageRows) + row / imageRows * H;
+            auto *secondRow = hasSecond
+                                  ? stacked.ptr<cv::Vec<T, 2> >((row + 1) % imageRows) + (row + 1) / imageRows * H
+                                  : nullptr;
+            for (int v = 0; v < H; v++) {
+                const TComplex mirrored = std::conj(packed[(N - v) % N]);
+                firstRow[v] = toVec((packed[v] + mirrored) * static_cast<T>(0.5));
+                if (hasSecond) {
+                    secondRow[v] = toVec((packed[v] - mirrored) * TComplex(0, -0.5));
+                }
+            }
+        }
+
+        transformColumns(stacked, *FourierProcessor::BasicFFTPlan<T>::get(M, false));
+        if (images.size() == 1) {
+            return {{stacked, N}};
+        }
+        std::vector<FourierProcessor::HalfSpectrum> spectra(images.size());
+        for (size_t c = 0; c < images.size(); c++) {
+            spectra[c] = {cv::Mat(M, H, stacked.type()), N};
+        }
+#pragma omp parallel for
+        for (int u = 0; u < M; u++) {
+            const auto *stackedRow = stacked.ptr<cv::Vec<T, 2> >(u);
+            for (size_t c = 0; c < images.size(); c++) {
+                std::copy_n(stackedRow + c * H, H, spectra[c].values.ptr<cv::Vec<T, 2> >(u));
+            }
+        }
+        return spectra;
+    }
+
+    template<typename T>
+    cv::Mat expandSpectrum(const FourierProcessor::HalfSpectrum &spectrum) {
+        const int M = spectrum.values.rows;
+        const int N = spectrum.cols;
+        const int H = spectrum.values.cols;
+
+        cv::Mat fourierImage(M, N, spectrum.values.type());
+#pragma omp parallel for
+        for (int u = 0; u < M; u++) {
+            const auto *row = spectrum.values.ptr<cv::Vec<T, 2> >(u);
+            const auto *mirroredRow = spectrum.values.ptr<cv::Vec<T, 2> >((M - u) % M);
+            auto *fourierRow = fourierImage.ptr<cv::Vec<T, 2> >(u);
+            for (int v = 0; v < N; v++) {
+                fourierRow[v] = v < H ? row[v] : toVec(std::conj(toComplex(mirroredRow[N - v])));
+            }
         }
+        return shiftSpectrum<T>(fourierImage, false);
     }
 
     /**
-     * Perform 1D Inverse Fast Fourier Transform on image row.
-     * @param row Image row to transform
+     * Multiply every frequency (u, v) of a spectrum by rowRamp[u] * colRamp[v]. A phase ramp is the outer product
+     * of two 1D ramps, so only their tables are computed and the product is formed on the fly.
      */
-    void iFFT1D(cv::Mat row) {
-        const int N = row.cols;
+    template<typename T>
+    cv::Mat applyPhaseRamp(const cv::Mat &fourierImage, const std::vector<Complex> &rowRamp,
+                           const std::vector<Complex> &colRamp) {
+        const std::vector<std::complex<T> > columnFactors(colRamp.begin(), colRamp.end());
+        cv::Mat result(fourierImage.rows, fourierImage.cols, fourierImage.type());
+#pragma omp parallel for
+        for (int u = 0; u < fourierImage.rows; u++) {
+            const auto *row = fourierImage.ptr<cv::Vec<T, 2> >(u);
+            auto *resultRow = result.ptr<cv::Vec<T, 2> >(u);
+            const auto rowFactor = std::complex<T>(rowRamp[u]);
+            for (int v = 0; v < fourierImage.cols; v++) {
+                resultRow[v] = toVec(toComplex(row[v]) * (rowFactor * columnFactors[v]));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Phase ramp of the phase modification by an integer offset: exp(-2 pi i n k / length + k pi) at index n.
+     */
+    std::vector<Complex> phaseModificationRamp(const int length, const int shift) {
+        std::vector<Complex> ramp(length);
+        for (int n = 0; n < length; n++) {
+            ramp[n] = std::polar(1.0, -n * shift * 2 * std::numbers::pi / length + shift * std::numbers::pi);
+        }
+        return ramp;
+    }
+
+    /**
+     * Phase ramp translating a signal by a (fractional) offset: exp(-2 pi i f shift / length) at frequency f.
+     * @param shifted Index i holds frequency i - length / 2 (otherwise the usual order 0, 1, ..., -1)
+     * @param rampLength Number of stored frequencies (the columns of a half spectrum store fewer than length)
+     */
+    std::vector<Complex> translationRamp(const int length, const double shift, const bool shifted,
+                                         const int rampLength) {
+        std::vector<Complex> ramp(rampLength);
+        for (int i = 0; i < rampLength; i++) {
+            const int frequency = shifted ? i - length / 2 : i < (length + 1) / 2 ? i : i - length;
+            if (2 * std::abs(frequency) == length) {
+                // The Nyquist frequency is its own mirror, the mean of both ramps keeps the image real
+                ramp[i] = std::cos(std::numbers::pi * shift);
+            } else {
+                ramp[i] = std::polar(1.0, -2 * std::numbers::pi * frequency * shift / length);
+            }
+        }
+        return ramp;
+    }
+
+    template<typename T>
+    cv::Mat inverseTransform(const cv::Mat &fourierImage, const int outputRows, const int outputCols) {
+        const int M = fourierImage.rows;
+        const int N = fourierImage.cols;
+
+        cv::Mat shiftedInput = shiftSpectrum<T>(fourierImage, true);
+
+        transform2D<T>(shiftedInput, true);
+
+        cv::Mat result = cv::Mat::zeros(outputRows, outputCols, CV_8UC1);
 
-        int j = 0;
-        for (int i = 0; i < N; i++) {
-            if (i < j) {
-                std::swap(row.at<cv::Vec2d>(i)[0], row.at<cv::Vec2d>(j)[0]);
-                std::swap(row.at<cv::Vec2d>(i)[1], row.at<cv::Vec2d>(j)[1]);
+#pragma omp parallel for collapse(2)
+        for (int x = 0; x < outputRows; x++) {
+            for (int y = 0; y < outputCols; y++) {
+                const std::complex<T> complexPixelValue = toComplex(shiftedInput.ptr<cv::Vec<T, 2> >(x)[y]);
+                double pixelValue = std::abs(complexPixelValue) / M / N;
+                result.at<uchar>(x, y) = static_cast<uchar>(
+                    std::clamp(std::round(pixelValue), 0.0, 255.0)
+                );
             }
-            int bit = N >> 1;
-            while (j & bit) {
-                j ^= bit;
-                bit >>= 1;
+        }
+
+        return result;
+    }
+
+    /**
+     * Compute the inverse of realForwardTransform for equally sized half spectra in one batch:
+     * the spectra are placed side by side for one transformColumns call and the rows of all
+     * images are reconstructed in pairs.
+     */
+    template<typename T>
+    std::vector<cv::Mat> realInverseTransform(const std::vector<FourierProcessor::HalfSpectrum> &spectra,
+                                              const int outputRows, const int outputCols) {
+        using TComplex = std::complex<T>;
+        const int M = spectra.front().values.rows;
+        const int N = spectra.front().cols;
+        const int H = spectra.front().values.cols;
+
+        cv::Mat rowSpectra(M, static_cast<int>(spectra.size()) * H, spectra.front().values.type());
+#pragma omp parallel for
+        for (int u = 0; u < M; u++) {
+            auto *row = rowSpectra.ptr<cv::Vec<T, 2> >(u);
+            for (size_t c = 0; c < spectra.size(); c++) {
+                std::copy_n(spectra[c].values.ptr<cv::Vec<T, 2> >(u), H, row + c * H);
             }
-            j |= bit;
         }
+        transformColumns(rowSpectra, *FourierProcessor::BasicFFTPlan<T>::get(M, true));
 
-        for (int len = 2; len <= N; len <<= 1) {
-            const double theta = 2.0f * std::numbers::pi / len;
-            const std::complex wLen(std::cos(theta), std::sin(theta));
-            for (int i = 0; i < N; i += len) {
-                std::complex<double> w(1, 0);
-                for (int k = 0; k < len / 2; k++) {
-                    std::complex u(row.at<cv::Vec2d>(i + k)[0], row.at<cv::Vec2d>(i + k)[1]);
+        std::vector<cv::Mat> results(spectra.size());
+        for (auto &result: results) {
+            result = cv::Mat(outputRows, outputCols, CV_8UC1);
+        }
+        const int rowCount = static_cast<int>(spectra.size()) * outputRows;
+        const auto rowPlan = FourierProcessor::BasicFFTPlan<T>::get(N, true);
+        const double scale = 1.0 / (static_cast<double>(M) * N);
 
-                    std::complex t(row.at<cv::Vec2d>(i + k + len / 2)[0], row.at<cv::Vec2d>(i + k + len / 2)[1]);
-                    t *= w;
+#pragma omp parallel for
+        for (int pair = 0; pair < (rowCount + 1) / 2; pair++) {
+            TComplex *packed = threadScratch<T>(N + rowPlan->scratchSize());
+            TComplex *scratch = packed + N;
+            // Every row spectrum is Hermitian, so the row pair comes back as the real
+            // and imaginary part of the inverse of Z(v) = A(v) + iB(v)
+            const int row = 2 * pair;
+            const bool hasSecond = row + 1 < rowCount;
+            const auto *first = rowSpectra.ptr<cv::Vec<T, 2> >(row % outputRows) + row / outputRows * H;
+            const auto *second = hasSecond
+                                     ? rowSpectra.ptr<cv::Vec<T, 2> >((row + 1) % outputRows)
+                                       + (row + 1) / outputRows * H
+                                     : nullptr;
+            for (int v = 0; v < N; v++) {
+                const bool mirrored = v >= H;
+                const int index = mirrored ? N - v : v;
+                TComplex a = toComplex(first[index]);
+                TComplex b = hasSecond ? toComplex(second[index]) : TComplex();
+                if (mirrored) {
+                    a = std::conj(a);
+                    b = std::conj(b);
+                } else if (v == 0 || 2 * v == N) {
+                    // These frequencies are their own mirror, so they have to be real
+                    a = a.real();
+                    b = b.real();
+                }
+                packed[v] = a + TComplex(0, 1) * b;
+            }
+            rowPlan->execute(packed, scratch);
+
+            auto *firstRow = results[row / outputRows].ptr<uchar>(row % outputRows);
+            auto *secondRow = hasSecond ? results[(row + 1) / outputRows].ptr<uchar>((row + 1) % outputRows) : nullptr;
+            for (int y = 0; y < outputCols; y++) {
+                firstRow[y] = toPixel(packed[y].real(), scale);
+                if (hasSecond) {
+                    secondRow[y] = toPixel(packed[y].imag(), scale);
+                }
+            }
+        }
 
-                    std::complex<double> result1 = u + t;
-                    std::complex<double> result2 = u - t;
+        return results;
+    }
 
-                    row.at<cv::Vec2d>(i + k)[0] = result1.real();
-                    row.at<cv::Vec2d>(i + k)[1] = result1.imag();
+    /**
+     * Circularly convolve an image with a kernel by overlap-save. The image is cut into tiles, every tile
+     * is extended by a halo of the kernel radius taken circularly from the image, transformed, multiplied
+     * by the spectrum of the kernel and transformed back, and the part of the tile without the halo is kept.
+     * Two tiles are packed into the real and the imaginary part of one complex block, since the kernel
+     * is real, their convolutions stay separated. Tiles run in parallel, each thread holds one block.
+     * @param image CV_8UC1 image
+     * @param kernel CV_64FC1 kernel of odd size, not larger than the image
+     * @param tileSize Maximum side of a tile
+     */
+    template<typename T>
+    cv::Mat tiledConvolution(const cv::Mat &image, const cv::Mat &kernel, const int tileSize) {
+        const int rows = image.rows;
+        const int cols = image.cols;
+        const int rowRadius = kernel.rows / 2;
+        const int colRadius = kernel.cols / 2;
+        const int tileRows = std::min(tileSize, rows);
+        const int tileCols = std::min(tileSize, cols);
+        const int blockRows = FourierProcessor::fastFFTLength(tileRows + 2 * rowRadius);
+        const int blockCols = FourierProcessor::fastFFTLength(tileCols + 2 * colRadius);
+
+        // Kernel centered at (0, 0) of the block, its negative offsets wrap around
+        cv::Mat kernelSpectrum = cv::Mat::zeros(blockRows, blockCols, complexType<T>());
+        for (int i = -rowRadius; i <= rowRadius; i++) {
+            const auto *kernelRow = kernel.ptr<double>(i + rowRadius);
+            auto *spectrumRow = kernelSpectrum.ptr<cv::Vec<T, 2> >((i + blockRows) % blockRows);
+            for (int j = -colRadius; j <= colRadius; j++) {
+                spectrumRow[(j + blockCols) % blockCols][0] = static_cast<T>(kernelRow[j + colRadius]);
+            }
+        }
+        transform2D<T>(kernelSpectrum, false);
+
+        const int tilesPerRow = (cols + tileCols - 1) / tileCols;
+        const int tileCount = (rows + tileRows - 1) / tileRows * tilesPerRow;
+        const double scale = 1.0 / blockRows / blockCols;
+        cv::Mat result(rows, cols, CV_8UC1);
+#pragma omp parallel for schedule(dynamic)
+        for (int pair = 0; pair < (tileCount + 1) / 2; pair++) {
+            const int tiles[] = {2 * pair, 2 * pair + 1 < tileCount ? 2 * pair + 1 : -1};
+            // Allocated once per thread and only cleared between the pairs it processes
+            thread_local cv::Mat block;
+            block.create(blockRows, blockCols, complexType<T>());
+            block.setTo(cv::Scalar::all(0));
+            for (int part = 0; part < 2 && tiles[part] >= 0; part++) {
+                const int top = tiles[part] / tilesPerRow * tileRows;
+                const int left = tiles[part] % tilesPerRow * tileCols;
+                const int height = std::min(tileRows, rows - top) + 2 * rowRadius;
+                const int width = std::min(tileCols, cols - left) + 2 * colRadius;
+                for (int x = 0; x < height; x++) {
+                    const auto *imageRow = image.ptr<uchar>(((top + x - rowRadius) % rows + rows) % rows);
+                    auto *blockRow = block.ptr<cv::Vec<T, 2> >(x);
+                    for (int y = 0; y < width; y++) {
+                        blockRow[y][part] = imageRow[((left + y - colRadius) % cols + cols) % cols];
+                    }
+                }
+            }
 
-                    row.at<cv::Vec2d>(i + k + len / 2)[0] = result2.real();
-                    row.at<cv::Vec2d>(i + k + len / 2)[1] = result2.imag();
-                    w *= wLen;
+            transform2D<T>(block, false);
+            for (int x = 0; x < blockRows; x++) {
+                auto *blockRow = block.ptr<cv::Vec<T, 2> >(x);
+                const auto *spectrumRow = kernelSpectrum.ptr<cv::Vec<T, 2> >(x);
+                for (int y = 0; y < blockCols; y++) {
+                    blockRow[y] = toVec(toComplex(blockRow[y]) * toComplex(spectrumRow[y]));
+                }
+            }
+            transform2D<T>(block, true);
+
+            for (int part = 0; part < 2 && tiles[part] >= 0; part++) {
+                const int top = tiles[part] / tilesPerRow * tileRows;
+                const int left = tiles[part] % tilesPerRow * tileCols;
+                const int height = std::min(tileRows, rows - top);
+                const int width = std::min(tileCols, cols - left);
+                for (int x = 0; x < height; x++) {
+                    const auto *blockRow = block.ptr<cv::Vec<T, 2> >(x + rowRadius);
+                    auto *resultRow = result.ptr<uchar>(top + x);
+                    for (int y = 0; y < width; y++) {
+                        resultRow[left + y] = toPixel(blockRow[y + colRadius][part], scale);
+                    }
                 }
             }
         }
+        return result;
+    }
+
+    /**
+     * Check the layout of a half spectrum.
+     */
+    void validateHalfSpectrum(const FourierProcessor::HalfSpectrum &spectrum) {
+        if (spectrum.values.type() != CV_32FC2 && spectrum.values.type() != CV_64FC2) {
+            throw std::invalid_argument("Half spectrum has to be CV_32FC2 or CV_64FC2");
+        }
+        if (spectrum.values.cols != spectrum.cols / 2 + 1) {
+            throw std::invalid_argument("Half spectrum has to have cols / 2 + 1 columns");
+        }
     }
 }
 
 namespace FourierProcessor {
+    template<typename T>
+    BasicFFTPlan<T>::BasicFFTPlan(const int length, const bool inverse) : length_(length), inverse_(inverse) {
+        if (length < 1) {
+            throw std::invalid_argument("FFT length has to be positive");
+        }
+        const double sign = inverse ? 1 : -1;
+        if (factorize(length, radices_)) {
+            int stride = 1;
+            for (const int radix: radices_) {
+                for (int r = 1; r < radix; r++) {
+                    for (int k = 0; k < stride; k++) {
+                        twiddles_.push_back(std::complex<T>(
+                            std::polar(1.0, sign * 2 * std::numbers::pi * k * r / (stride * radix))));
+                    }
+                }
+                stride *= radix;
+            }
+            return;
+        }
+
+        convolutionLength_ = fastFFTLength(2 * length - 1);
+        forwardConvolution_ = get(convolutionLength_, false);
+        inverseConvolution_ = get(convolutionLength_, true);
+        chirp_.resize(length);
+        for (long long k = 0; k < length; k++) {
+            // k^2 modulo 2 * length keeps the angle small and exact for large k
+            chirp_[k] = std::complex<T>(std::polar(
+                1.0, sign * std::numbers::pi * static_cast<double>(k * k % (2 * length)) / length));
+        }
+        chirpSpectrum_.assign(convolutionLength_, std::complex<T>());
+        chirpSpectrum_[0] = std::conj(chirp_[0]);
+        for (int k = 1; k < length; k++) {
+            chirpSpectrum_[k] = chirpSpectrum_[convolutionLength_ - k] = std::conj(chirp_[k]);
+        }
+        std::vector<std::complex<T> > scratch(forwardConvolution_->scratchSize());
+        forwardConvolution_->execute(chirpSpectrum_.data(), scratch.data());
+        for (auto &value: chirpSpectrum_) {
+            value /= static_cast<T>(convolutionLength_);
+        }
+    }
+
+    template<typename T>
+    std::shared_ptr<const BasicFFTPlan<T> > BasicFFTPlan<T>::get(const int length, const bool inverse) {
+        static std::mutex cacheMutex;
+        static std::map<std::pair<int, bool>, std::shared_ptr<const BasicFFTPlan> > cache;
+        const auto key = std::pair(length, inverse);
+        {
+            std::lock_guard lock(cacheMutex);
+            if (const auto it = cache.find(key); it != cache.end()) {
+                return it->second;
+            }
+        }
+        // Built outside of the lock, Bluestein plans get the plans of their convolution length
+        auto plan = std::make_shared<const BasicFFTPlan>(length, inverse);
+        std::lock_guard lock(cacheMutex);
+        return cache.try_emplace(key, std::move(plan)).first->second;
+    }
+
+    template<typename T>
+    int BasicFFTPlan<T>::length() const {
+        return length_;
+    }
+
+    template<typename T>
+    bool BasicFFTPlan<T>::isInverse() const {
+        return inverse_;
+    }
+
+    template<typename T>
+    int BasicFFTPlan<T>::scratchSize() const {
+        return convolutionLength_ == 0 ? length_ : 2 * convolutionLength_;
+    }
+
+    template<typename T>
+    void BasicFFTPlan<T>::execute(std::complex<T> *data, std::complex<T> *scratch) const {
+        if (convolutionLength_ == 0) {
+            mixedRadix(data, scratch);
+        } else {
+            bluestein(data, scratch);
+        }
+    }
+
+    template<typename T>
+    void BasicFFTPlan<T>::mixedRadix(std::complex<T> *data, std::complex<T> *scratch) const {
+        std::complex<T> *source = data;
+        std::complex<T> *target = scratch;
+        const std::complex<T> *twiddles = twiddles_.data();
+        std::array<std::complex<T>, MAX_RADIX> values{};
+        int stride = 1;
+        for (const int radix: radices_) {
+            const int groupLength = length_ / radix;
+            const int groupCount = groupLength / stride;
+            if constexpr (std::is_same_v<T, float>) {
+                if (radix == 4) {
+                    radix4Function()(reinterpret_cast<const float *>(source), reinterpret_cast<float *>(target),
+                                     reinterpret_cast<const float *>(twiddles), groupCount, stride, inverse_);
+                    twiddles += stride * (radix - 1);
+                    stride *= radix;
+                    std::swap(source, target);
+                    continue;
+                }
+            }
+            for (int group = 0; group < groupCount; group++) {
+                for (int k = 0; k < stride; k++) {
+                    const int input = group * stride + k;
+                    values[0] = source[input];
+                    for (int r = 1; r < radix; r++) {
+                        values[r] = source[input + r * groupLength] * twiddles[(r - 1) * stride + k];
+                    }
+                    butterfly(values.data(), radix, inverse_);
+                    const int output = group * stride * radix + k;
+                    for (int r = 0; r < radix; r++) {
+                        target[output + r * stride] = values[r];
+                    }
+                }
+            }
+            twiddles += stride * (radix - 1);
+            stride *= radix;
+            std::swap(source, target);
+        }
+        if (source != data) {
+            std::copy_n(source, length_, data);
+        }
+    }
+
+    template<typename T>
+    void BasicFFTPlan<T>::bluestein(std::complex<T> *data, std::complex<T> *scratch) const {
+        std::complex<T> *work = scratch;
+        for (int k = 0; k < length_; k++) {
+            work[k] = data[k] * chirp_[k];
+        }
+        std::fill(work + length_, work + convolutionLength_, std::complex<T>());
+        forwardConvolution_->execute(work, scratch + convolutionLength_);
+        for (int k = 0; k < convolutionLength_; k++) {
+            work[k] *= chirpSpectrum_[k];
+        }
+        inverseConvolution_->execute(work, scratch + convolutionLength_);
+        for (int k = 0; k < length_; k++) {
+            data[k] = work[k] * chirp_[k];
+        }
+    }
+
+    template class BasicFFTPlan<float>;
+    template class BasicFFTPlan<double>;
+
     void visualizeFourier(cv::Mat fourierImage, const std::string &fourierVisPath) {
+        if (fourierImage.depth() == CV_32F) {
+            fourierImage.convertTo(fourierImage, CV_64FC2);
+        }
         const int M = fourierImage.rows;
         const int N = fourierImage.cols;
 
@@ -141,329 +972,513 @@ namespace FourierProcessor {
     }
 
 
+    void visualizeFourier(const HalfSpectrum &spectrum, const std::string &fourierVisPath) {
+        visualizeFourier(expandHalfSpectrum(spectrum), fourierVisPath);
+    }
+
     cv::Mat fourierTransform(cv::Mat image) {
         const int M = image.rows;
         const int N = image.cols;
 
-        cv::Mat fourierImage = cv::Mat::zeros(M, N, CV_64FC2);
-
-        std::vector<std::complex<double> > rowExps(M * M), colExps(N * N);
+        cv::Mat fourierImage(M, N, CV_64FC2);
 #pragma omp parallel for
-        for (int u = 0; u < M; u++) {
-            for (int x = 0; x < M; x++) {
-                rowExps[u * M + x] = std::exp(
-                    std::complex<double>(0, -2.0 * std::numbers::pi * (static_cast<double>(u * x) / M)));
-            }
-        }
-#pragma omp parallel for
-        for (int v = 0; v < N; v++) {
+        for (int x = 0; x < M; x++) {
+            const uchar *imageRow = image.ptr<uchar>(x);
+            auto *fourierRow = fourierImage.ptr<cv::Vec2d>(x);
             for (int y = 0; y < N; y++) {
-                colExps[v * N + y] = std::exp(
-                    std::complex<double>(0, -2.0 * std::numbers::pi * (static_cast<double>(v * y) / N)));
+                fourierRow[y] = cv::Vec2d(imageRow[y], 0);
             }
         }
+        directTransform2D(fourierImage, false);
 
-#pragma omp parallel for
-        for (int u = 0; u < M; u++) {
-            for (int v = 0; v < N; v++) {
-                std::complex<double> sum(0, 0);
+        return shiftSpectrum<double>(fourierImage, false);
+    }
 
-                for (int x = 0; x < M; x++) {
-                    const auto factorX = rowExps[u * M + x];
-                    for (int y = 0; y < N; y++) {
-                        sum += static_cast<double>(image.at<uchar>(x, y)) * factorX * colExps[v * N + y];
-                    }
+    int fastFFTLength(const int length) {
+        for (int candidate = std::max(length, 1);; candidate++) {
+            int remainder = candidate;
+            for (const int prime: {2, 3, 5, 7}) {
+                while (remainder % prime == 0) {
+                    remainder /= prime;
                 }
-
-                fourierImage.at<cv::Vec2d>(u, v)[0] = sum.real();
-                fourierImage.at<cv::Vec2d>(u, v)[1] = sum.imag();
             }
-        }
-
-#pragma omp parallel for
-        for (int u = 0; u < M / 2; u++) {
-            for (int v = 0; v < N / 2; v++) {
-                auto temp = fourierImage.at<cv::Vec2d>(u, v);
-                fourierImage.at<cv::Vec2d>(u, v) = fourierImage.at<cv::Vec2d>(u + M / 2, v + N / 2);
-                fourierImage.at<cv::Vec2d>(u + M / 2, v + N / 2) = temp;
-
-                temp = fourierImage.at<cv::Vec2d>(u + M / 2, v);
-                fourierImage.at<cv::Vec2d>(u + M / 2, v) = fourierImage.at<cv::Vec2d>(u, v + N / 2);
-                fourierImage.at<cv::Vec2d>(u, v + N / 2) = temp;
+            if (remainder == 1) {
+                return candidate;
             }
         }
+    }
 
-        return fourierImage;
+    void fastFourierTransform2D(cv::Mat &complexImage, const bool inverse) {
+        if (complexImage.type() == CV_32FC2) {
+            transform2D<float>(complexImage, inverse);
+        } else if (complexImage.type() == CV_64FC2) {
+            transform2D<double>(complexImage, inverse);
+        } else {
+            throw std::invalid_argument("FFT input has to be CV_32FC2 or CV_64FC2");
+        }
     }
 
-    cv::Mat fastFourierTransform(cv::Mat image) {
-        const int M = image.rows;
-        const int N = image.cols;
+    cv::Mat fastFourierTransform(cv::Mat image, const bool padToFastSize, const FFTPrecision precision) {
+        const int M = padToFastSize ? fastFFTLength(image.rows) : image.rows;
+        const int N = padToFastSize ? fastFFTLength(image.cols) : image.cols;
+        return precision == FFTPrecision::FLOAT ? forwardTransform<float>(image, M, N)
+                                                : forwardTransform<double>(image, M, N);
+    }
 
-        cv::Mat fourierImage = cv::Mat::zeros(M, N, CV_64FC2);
+    HalfSpectrum realFastFourierTransform(const cv::Mat &image, const bool padToFastSize,
+                                          const FFTPrecision precision) {
+        return realFastFourierTransform(std::vector{image}, padToFastSize, precision).front();
+    }
 
-#pragma omp parallel for collapse(2)
-        for (int x = 0; x < M; x++) {
-            for (int y = 0; y < N; y++) {
-                fourierImage.at<cv::Vec2d>(x, y)[0] = image.at<uchar>(x, y);
-            }
+    std::vector<HalfSpectrum> realFastFourierTransform(const std::vector<cv::Mat> &channels, const bool padToFastSize,
+                                                       const FFTPrecision precision) {
+        if (channels.empty()) {
+            return {};
         }
-
-#pragma omp parallel
-        {
-#pragma omp for
-            for (int x = 0; x < M; x++) {
-                cv::Mat row = cv::Mat::zeros(1, N, CV_64FC2);
-                for (int y = 0; y < N; y++) {
-                    row.at<cv::Vec2d>(0, y)[0] = fourierImage.at<cv::Vec2d>(x, y)[0];
-                }
-                FFT1D(row);
-                for (int y = 0; y < N; y++) {
-                    fourierImage.at<cv::Vec2d>(x, y)[0] = row.at<cv::Vec2d>(0, y)[0];
-                    fourierImage.at<cv::Vec2d>(x, y)[1] = row.at<cv::Vec2d>(0, y)[1];
-                }
+        for (const cv::Mat &channel: channels) {
+            if (channel.type() != CV_8UC1 || channel.size() != channels.front().size()) {
+                throw std::invalid_argument("Channels have to be CV_8UC1 images of the same size");
             }
         }
+        const int M = padToFastSize ? fastFFTLength(channels.front().rows) : channels.front().rows;
+        const int N = padToFastSize ? fastFFTLength(channels.front().cols) : channels.front().cols;
+        return precision == FFTPrecision::FLOAT ? realForwardTransform<float>(channels, M, N)
+                                                : realForwardTransform<double>(channels, M, N);
+    }
+
+    cv::Mat expandHalfSpectrum(const HalfSpectrum &spectrum) {
+        validateHalfSpectrum(spectrum);
+        return spectrum.values.depth() == CV_32F ? expandSpectrum<float>(spectrum) : expandSpectrum<double>(spectrum);
+    }
 
-#pragma omp parallel
+    cv::Mat filterMask(const FrequencyFilter &filter, const int rows, const int cols, const bool halfSpectrum) {
+        if (filter.shape == FilterShape::BUTTERWORTH && filter.order < 1) {
+            throw std::invalid_argument("Butterworth filter order must be positive");
+        }
+        // Masks of large images take a lot of memory, so the cache is emptied once it would exceed this size.
+        // Cleared masks stay valid for callers still holding them.
+        constexpr size_t maxCacheBytes = size_t{256} << 20;
+        static std::mutex cacheMutex;
+        static std::map<std::tuple<FilterType, FilterShape, int, int, int, double, double, int, int, bool>, cv::Mat>
+                cache;
+        static size_t cacheBytes = 0;
+        // Only Butterworth filters depend on the order, only band filters on the upper cutoff
+        // and only directional filters on the wedge
+        const int order = filter.shape == FilterShape::BUTTERWORTH ? filter.order : 0;
+        const int upperCutoff = filter.type == FilterType::BAND_PASS || filter.type == FilterType::BAND_CUT
+                                    ? filter.upperCutoff
+                                    : 0;
+        const bool isDirectional = filter.type == FilterType::DIRECTIONAL_HIGH_PASS;
+        const auto key = std::tuple(filter.type, filter.shape, filter.cutoff, upperCutoff, order,
+                                    isDirectional ? filter.angle : 0.0, isDirectional ? filter.angularWidth : 0.0,
+                                    rows, cols, halfSpectrum);
         {
-#pragma omp for
-            for (int y = 0; y < N; y++) {
-                cv::Mat col = cv::Mat::zeros(1, M, CV_64FC2);
-                for (int x = 0; x < M; x++) {
-                    col.at<cv::Vec2d>(0, x)[0] = fourierImage.at<cv::Vec2d>(x, y)[0];
-                    col.at<cv::Vec2d>(0, x)[1] = fourierImage.at<cv::Vec2d>(x, y)[1];
-                }
-                FFT1D(col);
-                for (int x = 0; x < M; x++) {
-                    fourierImage.at<cv::Vec2d>(x, y)[0] = col.at<cv::Vec2d>(0, x)[0];
-                    fourierImage.at<cv::Vec2d>(x, y)[1] = col.at<cv::Vec2d>(0, x)[1];
-                }
+            std::lock_guard lock(cacheMutex);
+            if (const auto it = cache.find(key); it != cache.end()) {
+                return it->second;
             }
         }
+        cv::Mat mask = buildFilterMask(filter, rows, cols, halfSpectrum);
+        const size_t maskBytes = mask.total() * mask.elemSize();
+        std::lock_guard lock(cacheMutex);
+        if (const auto it = cache.find(key); it != cache.end()) {
+            return it->second;
+        }
+        if (cacheBytes + maskBytes > maxCacheBytes) {
+            cache.clear();
+            cacheBytes = 0;
+        }
+        cacheBytes += maskBytes;
+        return cache.try_emplace(key, std::move(mask)).first->second;
+    }
 
-#pragma omp parallel for
-        for (int u = 0; u < M / 2; u++) {
-            for (int v = 0; v < N / 2; v++) {
-                auto temp = fourierImage.at<cv::Vec2d>(u, v);
-                fourierImage.at<cv::Vec2d>(u, v) = fourierImage.at<cv::Vec2d>(u + M / 2, v + N / 2);
-                fourierImage.at<cv::Vec2d>(u + M / 2, v + N / 2) = temp;
+    cv::Mat applyFilter(const cv::Mat &fourierImage, const FrequencyFilter &filter) {
+        return filterSpectrum(fourierImage, filter, fourierImage.cols, false);
+    }
 
-                temp = fourierImage.at<cv::Vec2d>(u + M / 2, v);
-                fourierImage.at<cv::Vec2d>(u + M / 2, v) = fourierImage.at<cv::Vec2d>(u, v + N / 2);
-                fourierImage.at<cv::Vec2d>(u, v + N / 2) = temp;
-            }
-        }
-        return fourierImage;
+    HalfSpectrum applyFilter(const HalfSpectrum &spectrum, const FrequencyFilter &filter) {
+        validateHalfSpectrum(spectrum);
+        return {filterSpectrum(spectrum.values, filter, spectrum.cols, true), spectrum.cols};
     }
 
-    cv::Mat fftLowPass(const cv::Mat &fourierImage, const int lowPassBandSize) {
-        cv::Mat result = fourierImage.clone();
-        for (int x = 0; x < fourierImage.rows; x++) {
-            for (int y = 0; y < fourierImage.cols; y++) {
-                if (sqrt(pow(fourierImage.rows / 2 - x, 2) + pow(fourierImage.cols / 2 - y, 2)) >= lowPassBandSize) {
-                    result.at<cv::Vec2d>(x, y) = 0;
-                }
-            }
-        }
-        return result;
+    cv::Mat fftLowPass(const cv::Mat &fourierImage, const int lowPassBandSize, const FilterShape shape,
+                       const int order) {
+        return applyFilter(fourierImage, {FilterType::LOW_PASS, shape, lowPassBandSize, 0, order});
     }
 
-    cv::Mat fftHighPass(cv::Mat fourierImage, const int highPassBandSize) {
-        cv::Mat result = fourierImage.clone();
-        const std::complex DCComponent(
-            fourierImage.at<cv::Vec2d>(fourierImage.rows / 2, fourierImage.cols / 2)[0],
-            fourierImage.at<cv::Vec2d>(fourierImage.rows / 2, fourierImage.cols / 2)[1]
-        );
-        for (int x = 0; x < fourierImage.rows; x++) {
-            for (int y = 0; y < fourierImage.cols; y++) {
-                if (sqrt(pow(fourierImage.rows / 2 - x, 2) + pow(fourierImage.cols / 2 - y, 2)) <= highPassBandSize) {
-                    result.at<cv::Vec2d>(x, y) = 0;
-                }
-            }
-        }
+    HalfSpectrum fftLowPass(const HalfSpectrum &spectrum, const int lowPassBandSize, const FilterShape shape,
+                            const int order) {
+        return applyFilter(spectrum, {FilterType::LOW_PASS, shape, lowPassBandSize, 0, order});
+    }
 
-        result.at<cv::Vec2d>(fourierImage.rows / 2, fourierImage.cols / 2)[0] = DCComponent.real();
-        result.at<cv::Vec2d>(fourierImage.rows / 2, fourierImage.cols / 2)[1] = DCComponent.imag();
+    cv::Mat fftHighPass(cv::Mat fourierImage, const int highPassBandSize, const FilterShape shape, const int order) {
+        return applyFilter(fourierImage, {FilterType::HIGH_PASS, shape, highPassBandSize, 0, order});
+    }
 
-        return result;
+    HalfSpectrum fftHighPass(const HalfSpectrum &spectrum, const int highPassBandSize, const FilterShape shape,
+                             const int order) {
+        return applyFilter(spectrum, {FilterType::HIGH_PASS, shape, highPassBandSize, 0, order});
     }
 
-    cv::Mat fftBandPass(const cv::Mat &fourierImage, const int lowCut, const int highCut) {
-        cv::Mat result = fourierImage.clone();
-        result = fftHighPass(result, lowCut);
-        result = fftLowPass(result, highCut);
+    cv::Mat fftBandPass(const cv::Mat &fourierImage, const int lowCut, const int highCut, const FilterShape shape,
+                        const int order) {
+        return applyFilter(fourierImage, {FilterType::BAND_PASS, shape, lowCut, highCut, order});
+    }
 
-        return result;
+    HalfSpectrum fftBandPass(const HalfSpectrum &spectrum, const int lowCut, const int highCut,
+                             const FilterShape shape, const int order) {
+        return applyFilter(spectrum, {FilterType::BAND_PASS, shape, lowCut, highCut, order});
     }
 
-    cv::Mat fftBandCut(cv::Mat fourierImage, const int lowPass, const int highPass) {
-        cv::Mat result = fourierImage.clone();
-        const std::complex DCComponent(
-            fourierImage.at<cv::Vec2d>(fourierImage.rows / 2, fourierImage.cols / 2)[0],
-            fourierImage.at<cv::Vec2d>(fourierImage.rows / 2, fourierImage.cols / 2)[1]
-        );
-        for (int x = 0; x < fourierImage.rows; x++) {
-            for (int y = 0; y < fourierImage.cols; y++) {
-                if (const double distance = sqrt(pow(fourierImage.rows / 2 - x, 2) + pow(fourierImage.cols / 2 - y, 2));
-                    distance >= lowPass && distance <= highPass) {
-                    result.at<cv::Vec2d>(x, y) = 0;
-                }
-            }
-        }
+    cv::Mat fftBandCut(cv::Mat fourierImage, const int lowPass, const int highPass, const FilterShape shape,
+                       const int order) {
+        return applyFilter(fourierImage, {FilterType::BAND_CUT, shape, lowPass, highPass, order});
+    }
 
-        result.at<cv::Vec2d>(fourierImage.rows / 2, fourierImage.cols / 2)[0] = DCComponent.real();
-        result.at<cv::Vec2d>(fourierImage.rows / 2, fourierImage.cols / 2)[1] = DCComponent.imag();
+    HalfSpectrum fftBandCut(const HalfSpectrum &spectrum, const int lowPass, const int highPass,
+                            const FilterShape shape, const int order) {
+        return applyFilter(spectrum, {FilterType::BAND_CUT, shape, lowPass, highPass, order});
+    }
 
-        return result;
+    cv::Mat fftHighPassDirection(const cv::Mat &fourierImage, const int highPassBandSize, const double angle,
+                                 const double angularWidth, const FilterShape shape, const int order) {
+        return applyFilter(fourierImage, {
+                               FilterType::DIRECTIONAL_HIGH_PASS, shape, highPassBandSize, 0, order, angle, angularWidth
+                           });
     }
 
-    cv::Mat fftPhaseModifying(cv::Mat fourierImage, const int verticalShift, const int horizontalShift) {
-        cv::Mat mask = cv::Mat::zeros(fourierImage.rows, fourierImage.cols, CV_64FC2);
-        for (int n = 0; n < fourierImage.rows; n++) {
-            for (int m = 0; m < fourierImage.cols; m++) {
-                std::complex<double> complexResult = exp(std::complex<double>(
-                    0,
-                    -n * verticalShift * 2 * std::numbers::pi / fourierImage.rows
-                    + -m * horizontalShift * 2 * std::numbers::pi / fourierImage.cols
-                    + (verticalShift + horizontalShift) * std::numbers::pi
-                ));
-                mask.at<cv::Vec2d>(n, m)[0] = complexResult.real();
-                mask.at<cv::Vec2d>(n, m)[1] = complexResult.imag();
+    HalfSpectrum fftHighPassDirection(const HalfSpectrum &spectrum, const int highPassBandSize, const double angle,
+                                      const double angularWidth, const FilterShape shape, const int order) {
+        return applyFilter(spectrum, {
+                               FilterType::DIRECTIONAL_HIGH_PASS, shape, highPassBandSize, 0, order, angle, angularWidth
+                           });
+    }
+
+    std::vector<std::vector<cv::Mat> > highPassDirections(const std::vector<cv::Mat> &channels,
+                                                          const int highPassBandSize,
+                                                          const std::vector<double> &angles,
+                                                          const double angularWidth, const FilterShape shape,
+                                                          const int order, const FFTPrecision precision) {
+        if (channels.empty()) {
+            return std::vector<std::vector<cv::Mat> >(angles.size());
+        }
+        const std::vector<HalfSpectrum> spectra = realFastFourierTransform(channels, false, precision);
+        std::vector<HalfSpectrum> filtered;
+        filtered.reserve(angles.size() * spectra.size());
+        for (const double angle: angles) {
+            for (const auto &spectrum: spectra) {
+                filtered.push_back(fftHighPassDirection(spectrum, highPassBandSize, angle, angularWidth, shape, order));
             }
         }
+        const std::vector<cv::Mat> images = inverseRealFastFourierTransform(filtered);
+        std::vector<std::vector<cv::Mat> > directions(angles.size());
+        for (size_t a = 0; a < angles.size(); a++) {
+            directions[a].assign(images.begin() + static_cast<std::ptrdiff_t>(a * channels.size()),
+                                 images.begin() + static_cast<std::ptrdiff_t>((a + 1) * channels.size()));
+        }
+        return directions;
+    }
 
-        cv::Mat result = fourierImage.clone();
-        for (int n = 0; n < fourierImage.rows; n++) {
-            for (int m = 0; m < fourierImage.cols; m++) {
-                const double a = fourierImage.at<cv::Vec2d>(n, m)[0];
-                const double b = fourierImage.at<cv::Vec2d>(n, m)[1];
-                const double c = mask.at<cv::Vec2d>(n, m)[0];
-                const double d = mask.at<cv::Vec2d>(n, m)[1];
-
-                result.at<cv::Vec2d>(n, m)[0] = a * c - b * d;
-                result.at<cv::Vec2d>(n, m)[1] = a * d + b * c;
+    cv::Mat filterKernel(const FrequencyFilter &filter, const cv::Size imageSize, const int radius) {
+        if (imageSize.width <= 0 || imageSize.height <= 0) {
+            throw std::invalid_argument("Image size must be positive");
+        }
+        if (radius < 0) {
+            throw std::invalid_argument("Kernel radius must not be negative");
+        }
+        if (filter.shape == FilterShape::BUTTERWORTH && filter.order < 1) {
+            throw std::invalid_argument("Butterworth filter order must be positive");
+        }
+        const int rows = imageSize.height;
+        const int cols = imageSize.width;
+        const int rowRadius = std::min(radius, (rows - 1) / 2);
+        const int colRadius = std::min(radius, (cols - 1) / 2);
+        // The image grid itself gives the exact impulse response, a coarser grid with twice the kernel size
+        // keeps the aliasing of the sampled response small
+        const int gridRows = std::min(rows, fastFFTLength(2 * (2 * rowRadius + 1)));
+        const int gridCols = std::min(cols, fastFFTLength(2 * (2 * colRadius + 1)));
+        const double rowScale = static_cast<double>(rows) / gridRows;
+        const double colScale = static_cast<double>(cols) / gridCols;
+
+        cv::Mat response(gridRows, gridCols, CV_64FC2);
+#pragma omp parallel for
+        for (int x = 0; x < gridRows; x++) {
+            const double u = (x < (gridRows + 1) / 2 ? x : x - gridRows) * rowScale;
+            auto *responseRow = response.ptr<cv::Vec2d>(x);
+            for (int y = 0; y < gridCols; y++) {
+                const double v = (y < (gridCols + 1) / 2 ? y : y - gridCols) * colScale;
+                responseRow[y] = cv::Vec2d(filterGain(filter, u, v), 0);
             }
         }
-        return result;
+        transform2D<double>(response, true);
+
+        cv::Mat kernel(2 * rowRadius + 1, 2 * colRadius + 1, CV_64FC1);
+        for (int i = -rowRadius; i <= rowRadius; i++) {
+            const auto *responseRow = response.ptr<cv::Vec2d>((i + gridRows) % gridRows);
+            auto *kernelRow = kernel.ptr<double>(i + rowRadius);
+            for (int j = -colRadius; j <= colRadius; j++) {
+                kernelRow[j + colRadius] = responseRow[(j + gridCols) % gridCols][0] / gridRows / gridCols;
+            }
+        }
+        return kernel;
     }
 
-    cv::Mat inverseFourierTransform(const cv::Mat &fourierImage) {
-        const int M = fourierImage.rows;
-        const int N = fourierImage.cols;
-        cv::Mat result = cv::Mat::zeros(M, N, CV_8UC1);
+    cv::Mat tiledFilter(const cv::Mat &image, const FrequencyFilter &filter, const int kernelRadius,
+                        const int tileSize, const FFTPrecision precision) {
+        if (image.empty() || image.type() != CV_8UC1) {
+            throw std::invalid_argument("Image must be a non-empty CV_8UC1 image");
+        }
+        if (tileSize <= 0) {
+            throw std::invalid_argument("Tile size must be positive");
+        }
+        const cv::Mat kernel = filterKernel(filter, image.size(), kernelRadius);
+        return precision == FFTPrecision::FLOAT
+                   ? tiledConvolution<float>(image, kernel, tileSize)
+                   : tiledConvolution<double>(image, kernel, tileSize);
+    }
 
-        std::vector<std::complex<double> > rowExps(M * M), colExps(N * N);
-#pragma omp parallel for
-        for (int u = 0; u < M; u++) {
-            for (int x = 0; x < M; x++) {
-                rowExps[u * M + x] = std::exp(
-                    std::complex<double>(0, 2.0 * std::numbers::pi * (static_cast<double>(u * x) / M)));
+    cv::Mat fftPhaseModifying(cv::Mat fourierImage, const int verticalShift, const int horizontalShift) {
+        const std::vector<Complex> rowRamp = phaseModificationRamp(fourierImage.rows, verticalShift);
+        const std::vector<Complex> colRamp = phaseModificationRamp(fourierImage.cols, horizontalShift);
+        return fourierImage.depth() == CV_32F
+                   ? applyPhaseRamp<float>(fourierImage, rowRamp, colRamp)
+                   : applyPhaseRamp<double>(fourierImage, rowRamp, colRamp);
+    }
+
+    cv::Mat fftTranslate(const cv::Mat &fourierImage, const double verticalShift, const double horizontalShift) {
+        if (fourierImage.type() != CV_32FC2 && fourierImage.type() != CV_64FC2) {
+            throw std::invalid_argument("Spectrum must be of type CV_32FC2 or CV_64FC2");
+        }
+        const std::vector<Complex> rowRamp = translationRamp(fourierImage.rows, verticalShift, true,
+                                                             fourierImage.rows);
+        const std::vector<Complex> colRamp = translationRamp(fourierImage.cols, horizontalShift, true,
+                                                             fourierImage.cols);
+        return fourierImage.depth() == CV_32F
+                   ? applyPhaseRamp<float>(fourierImage, rowRamp, colRamp)
+                   : applyPhaseRamp<double>(fourierImage, rowRamp, colRamp);
+    }
+
+    HalfSpectrum fftTranslate(const HalfSpectrum &spectrum, const double verticalShift, const double horizontalShift) {
+        validateHalfSpectrum(spectrum);
+        const std::vector<Complex> rowRamp = translationRamp(spectrum.values.rows, verticalShift, false,
+                                                             spectrum.values.rows);
+        const std::vector<Complex> colRamp = translationRamp(spectrum.cols, horizontalShift, false,
+                                                             spectrum.values.cols);
+        return {
+            spectrum.values.depth() == CV_32F
+                ? applyPhaseRamp<float>(spectrum.values, rowRamp, colRamp)
+                : applyPhaseRamp<double>(spectrum.values, rowRamp, colRamp),
+            spectrum.cols
+        };
+    }
+
+    cv::Mat translate(const cv::Mat &image, const double verticalShift, const double horizontalShift,
+                      const FFTPrecision precision) {
+        return inverseRealFastFourierTransform(
+            fftTranslate(realFastFourierTransform(image, false, precision), verticalShift, horizontalShift));
+    }
+
+    cv::Mat matchTemplate(const cv::Mat &image, const cv::Mat &templ) {
+        if (image.type() != CV_8UC1 || templ.type() != CV_8UC1) {
+            throw std::invalid_argument("Image and template have to be CV_8UC1");
+        }
+        if (templ.empty() || templ.rows > image.rows || templ.cols > image.cols) {
+            throw std::invalid_argument("Template has to be non-empty and not larger than the image");
+        }
+        const int M = image.rows;
+        const int N = image.cols;
+        const int m = templ.rows;
+        const int n = templ.cols;
+        const double count = static_cast<double>(m) * n;
+
+        double templateMean = 0;
+        for (int x = 0; x < m; x++) {
+            const uchar *templateRow = templ.ptr<uchar>(x);
+            templateMean += std::accumulate(templateRow, templateRow + n, 0.0);
+        }
+        templateMean /= count;
+        double templateNorm = 0;
+        for (int x = 0; x < m; x++) {
+            const uchar *templateRow = templ.ptr<uchar>(x);
+            for (int y = 0; y < n; y++) {
+                templateNorm += (templateRow[y] - templateMean) * (templateRow[y] - templateMean);
             }
         }
+        if (templateNorm == 0) {
+            throw std::invalid_argument("Template must not be constant");
+        }
 
+        // Only windows inside the image are scored, so the circular correlation needs no padding
+        // beyond the next fast length
+        const int P = fastFFTLength(M);
+        const int Q = fastFFTLength(N);
+        cv::Mat packed = cv::Mat::zeros(P, Q, CV_64FC2);
 #pragma omp parallel for
-        for (int v = 0; v < N; v++) {
+        for (int x = 0; x < M; x++) {
+            const uchar *imageRow = image.ptr<uchar>(x);
+            const uchar *templateRow = x < m ? templ.ptr<uchar>(x) : nullptr;
+            auto *packedRow = packed.ptr<cv::Vec2d>(x);
             for (int y = 0; y < N; y++) {
-                colExps[v * N + y] = std::exp(
-                    std::complex<double>(0, 2.0 * std::numbers::pi * (static_cast<double>(v * y) / N)));
+                packedRow[y][0] = imageRow[y];
+                if (templateRow != nullptr && y < n) {
+                    packedRow[y][1] = templateRow[y] - templateMean;
+                }
             }
         }
+        transform2D<double>(packed, false);
 
-        cv::Mat shiftedInput = fourierImage.clone();
-
-        for (int u = 0; u < M / 2; u++) {
-            for (int v = 0; v < N / 2; v++) {
-                std::swap(shiftedInput.at<cv::Vec2d>(u, v), shiftedInput.at<cv::Vec2d>(u + M / 2, v + N / 2));
-                std::swap(shiftedInput.at<cv::Vec2d>(u + M / 2, v), shiftedInput.at<cv::Vec2d>(u, v + N / 2));
+        // The image f and the template t are real, so Z = F + iT gives F(k) = (Z(k) + conj(Z(-k))) / 2
+        // and T(k) = (Z(k) - conj(Z(-k))) / 2i, the correlation is the inverse of F(k) * conj(T(k))
+        cv::Mat crossPower(P, Q, CV_64FC2);
+#pragma omp parallel for
+        for (int u = 0; u < P; u++) {
+            const auto *row = packed.ptr<cv::Vec2d>(u);
+            const auto *mirroredRow = packed.ptr<cv::Vec2d>((P - u) % P);
+            auto *crossPowerRow = crossPower.ptr<cv::Vec2d>(u);
+            for (int v = 0; v < Q; v++) {
+                const Complex value = toComplex(row[v]);
+                const Complex mirrored = std::conj(toComplex(mirroredRow[(Q - v) % Q]));
+                const Complex imageSpectrum = (value + mirrored) * 0.5;
+                const Complex templateSpectrum = (value - mirrored) * Complex(0, -0.5);
+                crossPowerRow[v] = toVec(imageSpectrum * std::conj(templateSpectrum));
             }
         }
+        transform2D<double>(crossPower, true);
 
-#pragma omp parallel for collapse(2)
+        // Integral images of the intensities and their squares, with a zero first row and column
+        std::vector<double> sums((M + 1) * (N + 1), 0.0);
+        std::vector<double> squares((M + 1) * (N + 1), 0.0);
         for (int x = 0; x < M; x++) {
+            const uchar *imageRow = image.ptr<uchar>(x);
+            double rowSum = 0;
+            double rowSquares = 0;
             for (int y = 0; y < N; y++) {
-                std::complex<double> sum(0, 0);
-                for (int u = 0; u < M; u++) {
-                    const auto factorX = rowExps[u * M + x];
-                    for (int v = 0; v < N; v++) {
-                        auto value = shiftedInput.at<cv::Vec2d>(u, v);
-                        std::complex input(value[0], value[1]);
-                        sum += input * factorX * colExps[v * N + y];
-                    }
-                }
-                double pixelValue = std::abs(sum) / (M * N);
-                result.at<uchar>(x, y) = static_cast<uchar>(
-                    std::clamp(std::round(pixelValue), 0.0, 255.0)
-                );
+                rowSum += imageRow[y];
+                rowSquares += static_cast<double>(imageRow[y]) * imageRow[y];
+                sums[(x + 1) * (N + 1) + y + 1] = sums[x * (N + 1) + y + 1] + rowSum;
+                squares[(x + 1) * (N + 1) + y + 1] = squares[x * (N + 1) + y + 1] + rowSquares;
             }
         }
+        const auto windowTotal = [N, m, n](const std::vector<double> &integral, const int x, const int y) {
+            return integral[(x + m) * (N + 1) + y + n] - integral[x * (N + 1) + y + n]
+                   - integral[(x + m) * (N + 1) + y] + integral[x * (N + 1) + y];
+        };
 
-        return result;
-    }
-
-    cv::Mat inverseFastFourierTransform(const cv::Mat &fourierImage) {
-        int M = fourierImage.rows;
-        int N = fourierImage.cols;
-
-        cv::Mat shiftedInput = fourierImage.clone();
-
-        for (int u = 0; u < M / 2; u++) {
-            for (int v = 0; v < N / 2; v++) {
-                std::swap(shiftedInput.at<cv::Vec2d>(u, v), shiftedInput.at<cv::Vec2d>(u + M / 2, v + N / 2));
-                std::swap(shiftedInput.at<cv::Vec2d>(u + M / 2, v), shiftedInput.at<cv::Vec2d>(u, v + N / 2));
+        cv::Mat response(M - m + 1, N - n + 1, CV_64FC1);
+        const double scale = 1.0 / (static_cast<double>(P) * Q);
+#pragma omp parallel for
+        for (int x = 0; x < response.rows; x++) {
+            const auto *correlationRow = crossPower.ptr<cv::Vec2d>(x);
+            auto *responseRow = response.ptr<double>(x);
+            for (int y = 0; y < response.cols; y++) {
+                const double windowSum = windowTotal(sums, x, y);
+                // Sum of squared deviations from the window mean, at least 1 / 2 unless the window is constant
+                const double windowNorm = windowTotal(squares, x, y) - windowSum * (windowSum / count);
+                responseRow[y] = windowNorm < 0.5
+                                     ? 0.0
+                                     : std::clamp(correlationRow[y][0] * scale / std::sqrt(templateNorm * windowNorm),
+                                                  -1.0, 1.0);
             }
         }
+        return response;
+    }
 
-#pragma omp parallel
-        {
-#pragma omp for
-            for (int x = 0; x < M; x++) {
-                cv::Mat row = cv::Mat::zeros(1, N, CV_64FC2);
-                for (int y = 0; y < N; y++) {
-                    row.at<cv::Vec2d>(0, y)[0] = shiftedInput.at<cv::Vec2d>(x, y)[0];
-                    row.at<cv::Vec2d>(0, y)[1] = shiftedInput.at<cv::Vec2d>(x, y)[1];
+    std::vector<TemplateMatch> findMatches(const cv::Mat &response, const cv::Size templateSize, const int maxCount,
+                                           const double minScore) {
+        std::vector<TemplateMatch> candidates;
+        for (int x = 0; x < response.rows; x++) {
+            for (int y = 0; y < response.cols; y++) {
+                const double score = response.at<double>(x, y);
+                if (score < minScore) {
+                    continue;
                 }
-                iFFT1D(row);
-                for (int y = 0; y < N; y++) {
-                    shiftedInput.at<cv::Vec2d>(x, y)[0] = row.at<cv::Vec2d>(0, y)[0];
-                    shiftedInput.at<cv::Vec2d>(x, y)[1] = row.at<cv::Vec2d>(0, y)[1];
+                bool isMaximum = true;
+                for (int dx = -1; dx <= 1 && isMaximum; dx++) {
+                    for (int dy = -1; dy <= 1 && isMaximum; dy++) {
+                        const int neighbourX = x + dx;
+                        const int neighbourY = y + dy;
+                        if (neighbourX >= 0 && neighbourX < response.rows && neighbourY >= 0
+                            && neighbourY < response.cols) {
+                            isMaximum = response.at<double>(neighbourX, neighbourY) <= score;
+                        }
+                    }
+                }
+                if (isMaximum) {
+                    candidates.push_back({x, y, score});
                 }
             }
         }
+        std::ranges::stable_sort(candidates, std::greater(), &TemplateMatch::score);
 
-#pragma omp parallel
-        {
-#pragma omp for
-            for (int y = 0; y < N; y++) {
-                cv::Mat col = cv::Mat::zeros(1, M, CV_64FC2);
-                for (int x = 0; x < M; x++) {
-                    col.at<cv::Vec2d>(0, x)[0] = shiftedInput.at<cv::Vec2d>(x, y)[0];
-                    col.at<cv::Vec2d>(0, x)[1] = shiftedInput.at<cv::Vec2d>(x, y)[1];
-                }
-                iFFT1D(col);
-                for (int x = 0; x < M; x++) {
-                    shiftedInput.at<cv::Vec2d>(x, y)[0] = col.at<cv::Vec2d>(0, x)[0];
-                    shiftedInput.at<cv::Vec2d>(x, y)[1] = col.at<cv::Vec2d>(0, x)[1];
-                }
+        std::vector<TemplateMatch> matches;
+        for (const TemplateMatch &candidate: candidates) {
+            if (static_cast<int>(matches.size()) >= maxCount) {
+                break;
+            }
+            const bool overlaps = std::ranges::any_of(matches, [&](const TemplateMatch &match) {
+                return std::abs(match.x - candidate.x) < templateSize.height
+                       && std::abs(match.y - candidate.y) < templateSize.width;
+            });
+            if (!overlaps) {
+                matches.push_back(candidate);
             }
         }
+        return matches;
+    }
+
+    cv::Mat inverseFourierTransform(const cv::Mat &fourierImage) {
+        const int M = fourierImage.rows;
+        const int N = fourierImage.cols;
+        cv::Mat result(M, N, CV_8UC1);
 
-        cv::Mat result = cv::Mat::zeros(M, N, CV_8UC1);
+        cv::Mat values = shiftSpectrum<double>(fourierImage, true);
+        directTransform2D(values, true);
 
-#pragma omp parallel for collapse(2)
+        const double scale = 1.0 / (static_cast<double>(M) * N);
+#pragma omp parallel for
         for (int x = 0; x < M; x++) {
+            const auto *valuesRow = values.ptr<cv::Vec2d>(x);
+            uchar *resultRow = result.ptr<uchar>(x);
             for (int y = 0; y < N; y++) {
-                std::complex complexPixelValue(
-                    shiftedInput.at<cv::Vec2d>(x, y)[0],
-                    shiftedInput.at<cv::Vec2d>(x, y)[1]
-                );
-                double pixelValue = std::abs(complexPixelValue) / M / N;
-                result.at<uchar>(x, y) = static_cast<uchar>(
-                    std::clamp(std::round(pixelValue), 0.0, 255.0)
-                );
+                resultRow[y] = toPixel(std::abs(toComplex(valuesRow[y])), scale);
             }
         }
 
         return result;
     }
+
+    cv::Mat inverseFastFourierTransform(const cv::Mat &fourierImage, const cv::Size outputSize) {
+        const int M = fourierImage.rows;
+        const int N = fourierImage.cols;
+        const int outputRows = outputSize.height > 0 ? std::min(outputSize.height, M) : M;
+        const int outputCols = outputSize.width > 0 ? std::min(outputSize.width, N) : N;
+        return fourierImage.depth() == CV_32F
+                   ? inverseTransform<float>(fourierImage, outputRows, outputCols)
+                   : inverseTransform<double>(fourierImage, outputRows, outputCols);
+    }
+
+    cv::Mat inverseRealFastFourierTransform(const HalfSpectrum &spectrum, const cv::Size outputSize) {
+        return inverseRealFastFourierTransform(std::vector{spectrum}, outputSize).front();
+    }
+
+    std::vector<cv::Mat> inverseRealFastFourierTransform(const std::vector<HalfSpectrum> &spectra,
+                                                         const cv::Size outputSize) {
+        if (spectra.empty()) {
+            return {};
+        }
+        for (const HalfSpectrum &spectrum: spectra) {
+            validateHalfSpectrum(spectrum);
+            if (spectrum.values.type() != spectra.front().values.type()
+                || spectrum.values.size() != spectra.front().values.size() || spectrum.cols != spectra.front().cols) {
+                throw std::invalid_argument("Half spectra have to be of the same type and size");
+            }
+        }
+        const int M = spectra.front().values.rows;
+        const int N = spectra.front().cols;
+        const int outputRows = outputSize.height > 0 ? std::min(outputSize.height, M) : M;
+        const int outputCols = outputSize.width > 0 ? std::min(outputSize.width, N) : N;
+        return spectra.front().values.depth() == CV_32F
+                   ? realInverseTransform<float>(spectra, outputRows, outputCols)
+                   : realInverseTransform<double>(spectra, outputRows, outputCols);
+    }
 }
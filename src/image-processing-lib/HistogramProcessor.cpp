@@ -4,14 +4,25 @@
 
 #include "../include/image-processing-lib/HistogramProcessor.h"
 
+#include "../include/image-processing-lib/SpatialDomainProcessor.h"
+
 namespace HistogramProcessor {
     std::array<uint, UCHAR_MAX + 1> computeHistogram(cv::Mat image) {
         std::array<uint, UCHAR_MAX + 1> intensityCountArray = {};
 
-        for (int x = 0; x < image.rows; x++) {
-            for (int y = 0; y < image.cols; y++) {
-                const uint intensity = image.at<uchar>(x, y);
-                intensityCountArray[intensity]++;
+#pragma omp parallel
+        {
+            std::array<uint, UCHAR_MAX + 1> threadCountArray = {};
+#pragma omp for collapse(2) nowait
+            for (int x = 0; x < image.rows; x++) {
+                for (int y = 0; y < image.cols; y++) {
+                    const uint intensity = image.at<uchar>(x, y);
+                    threadCountArray[intensity]++;
+                }
+            }
+#pragma omp critical
+            for (int i = 0; i <= UCHAR_MAX; i++) {
+                intensityCountArray[i] += threadCountArray[i];
             }
         }
 
@@ -35,13 +46,18 @@ namespace HistogramProcessor {
     cv::Mat histogramEqualization(const cv::Mat &image,
                              const std::array<uint, UCHAR_MAX + 1> &imageHistogram, const int gMax,
                              const int gMin) {
-        cv::Mat result = image.clone();
-        const int totalPixels = image.rows * image.cols;
+        return SpatialDomainProcessor::applyLookupTable(image,
+                                                        equalizationLookupTable(imageHistogram, gMax, gMin));
+    }
+
+    std::array<uchar, UCHAR_MAX + 1> equalizationLookupTable(const std::array<uint, UCHAR_MAX + 1> &imageHistogram,
+                                                             const int gMax, const int gMin) {
         uint cdf[256] = {static_cast<uint>(imageHistogram[0])};
         for (int i = 1; i < 256; i++)
             cdf[i] = cdf[i - 1] + imageHistogram[i];
+        const uint totalPixels = cdf[UCHAR_MAX];
 
-        uchar lut[256];
+        std::array<uchar, UCHAR_MAX + 1> lut{};
         for (int i = 0; i < 256; i++) {
             lut[i] = std::clamp(
                 gMin + static_cast<int>(std::round((gMax - gMin) * (static_cast<double>(cdf[i]) / totalPixels))),
@@ -49,13 +65,36 @@ namespace HistogramProcessor {
                 UCHAR_MAX
             );
         }
+        return lut;
+    }
 
-        result.forEach<uchar>([&](uchar &pixel, const int *) {
-            pixel = lut[pixel];
-        });
+    std::array<uint, UCHAR_MAX + 1> transformHistogram(const std::array<uint, UCHAR_MAX + 1> &imageHistogram,
+                                                       const std::array<uchar, UCHAR_MAX + 1> &lookupTable) {
+        std::array<uint, UCHAR_MAX + 1> result = {};
+        for (int i = 0; i <= UCHAR_MAX; i++) {
+            result[lookupTable[i]] += imageHistogram[i];
+        }
         return result;
     }
 
+    int minimumIntensity(const std::array<uint, UCHAR_MAX + 1> &imageHistogram) {
+        for (int i = 0; i <= UCHAR_MAX; i++) {
+            if (imageHistogram[i] > 0) {
+                return i;
+            }
+        }
+        return UCHAR_MAX;
+    }
+
+    int maximumIntensity(const std::array<uint, UCHAR_MAX + 1> &imageHistogram) {
+        for (int i = UCHAR_MAX; i >= 0; i--) {
+            if (imageHistogram[i] > 0) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
 
     double mean(const std::array<uint, UCHAR_MAX + 1> &imageHistogram) {
         double sum = 0;
@@ -14,8 +14,9 @@ namespace ImageComparer {
         }
         double squareDistanceSum = 0;
 
-        for (int x = 0; x < originalImage.cols; x++) {
-            for (int y = 0; y < originalImage.rows; y++) {
+#pragma omp parallel for collapse(2) reduction(+:squareDistanceSum)
+        for (int x = 0; x < originalImage.rows; x++) {
+            for (int y = 0; y < originalImage.cols; y++) {
                 squareDistanceSum += pow(originalImage.at<uchar>(x, y) - newImage.at<uchar>(x, y), 2);
             }
         }
@@ -34,8 +35,9 @@ namespace ImageComparer {
         }
         uchar max = 0;
 
-        for (int x = 0; x < originalImage.cols; x++) {
-            for (int y = 0; y < originalImage.rows; y++) {
+#pragma omp parallel for collapse(2) reduction(max:max)
+        for (int x = 0; x < originalImage.rows; x++) {
+            for (int y = 0; y < originalImage.cols; y++) {
                 if (originalImage.at<uchar>(x, y) > max) {
                     max = originalImage.at<uchar>(x, y);
                 }
@@ -58,8 +60,9 @@ namespace ImageComparer {
         double squareSum = 0;
         double se = 0;
 
-        for (int x = 0; x < originalImage.cols; x++) {
-            for (int y = 0; y < originalImage.rows; y++) {
+#pragma omp parallel for collapse(2) reduction(+:squareSum, se)
+        for (int x = 0; x < originalImage.rows; x++) {
+            for (int y = 0; y < originalImage.cols; y++) {
                 squareSum += pow(originalImage.at<uchar>(x, y), 2);
                 se += pow(originalImage.at<uchar>(x, y) - newImage.at<uchar>(x, y), 2);
             }
@@ -85,8 +88,9 @@ namespace ImageComparer {
             throw std::invalid_argument("Images must have same dimensions");
         }
         uchar max = 0;
-        for (int x = 0; x < originalImage.cols; x++) {
-            for (int y = 0; y < originalImage.rows; y++) {
+#pragma omp parallel for collapse(2) reduction(max:max)
+        for (int x = 0; x < originalImage.rows; x++) {
+            for (int y = 0; y < originalImage.cols; y++) {
                 if (originalImage.at<uchar>(x, y) > max) {
                     max = originalImage.at<uchar>(x, y);
                 }
@@ -96,11 +100,12 @@ namespace ImageComparer {
             throw std::invalid_argument("Image maximum value cannot be zero");
         }
 
-        unsigned long long maxSquareSum = 0;
+        const unsigned long long maxSquareSum = static_cast<unsigned long long>(originalImage.total())
+                                                * static_cast<unsigned long long>(max) * max;
         double se = 0;
-        for (int x = 0; x < originalImage.cols; x++) {
-            for (int y = 0; y < originalImage.rows; y++) {
-                maxSquareSum += static_cast<unsigned long long>(std::round(pow(static_cast<int>(max), 2)));
+#pragma omp parallel for collapse(2) reduction(+:se)
+        for (int x = 0; x < originalImage.rows; x++) {
+            for (int y = 0; y < originalImage.cols; y++) {
                 se += pow(originalImage.at<uchar>(x, y) - newImage.at<uchar>(x, y), 2);
             }
         }
@@ -122,8 +127,9 @@ namespace ImageComparer {
             throw std::invalid_argument("Images must have same dimensions");
         }
         uchar maxDifference = 0;
-        for (int x = 0; x < originalImage.cols; x++) {
-            for (int y = 0; y < originalImage.rows; y++) {
+#pragma omp parallel for collapse(2) reduction(max:maxDifference)
+        for (int x = 0; x < originalImage.rows; x++) {
+            for (int y = 0; y < originalImage.cols; y++) {
                 if (std::abs(originalImage.at<uchar>(x, y) - newImage.at<uchar>(x, y)) > maxDifference) {
                     maxDifference = std::abs(originalImage.at<uchar>(x, y) - newImage.at<uchar>(x, y));
                 }
@@ -4,6 +4,306 @@
 
 #include "../../include/image-processing-lib/MorphologicalProcessor.h"
 
+#include <array>
+#include <numeric>
+#include <string>
+#include <utility>
+
+#include "image-processing-lib/Threading.h"
+
+namespace {
+    /**
+     * Action of the first labeling pass for a foreground pixel, decided by which of its already visited
+     * neighbours p (above left), q (above), r (above right) and s (left) are foreground.
+     */
+    enum class LabelAction {
+        NEW,
+        COPY_P,
+        COPY_Q,
+        COPY_R,
+        COPY_S,
+        MERGE_P_R,
+        MERGE_S_R
+    };
+
+    /**
+     * Decision table indexed by p | q << 1 | r << 2 | s << 3. The pixel above touches all the other neighbours,
+     * so its label is enough whenever it is foreground. The pixel above right touches neither p nor s,
+     * so their labels have to be merged with its label.
+     */
+    constexpr std::array<LabelAction, 16> LABEL_DECISION_TABLE = [] {
+        std::array<LabelAction, 16> table{};
+        for (int neighbours = 0; neighbours < 16; neighbours++) {
+            const bool p = neighbours & 1;
+            const bool q = neighbours & 2;
+            const bool r = neighbours & 4;
+            const bool s = neighbours & 8;
+            if (q) {
+                table[neighbours] = LabelAction::COPY_Q;
+            } else if (r) {
+                table[neighbours] = p ? LabelAction::MERGE_P_R : s ? LabelAction::MERGE_S_R : LabelAction::COPY_R;
+            } else if (p) {
+                table[neighbours] = LabelAction::COPY_P;
+            } else if (s) {
+                table[neighbours] = LabelAction::COPY_S;
+            } else {
+                table[neighbours] = LabelAction::NEW;
+            }
+        }
+        return table;
+    }();
+
+    int findRoot(std::vector<int> &parent, int label) {
+        while (parent[label] != label) {
+            parent[label] = parent[parent[label]];
+            label = parent[label];
+        }
+        return label;
+    }
+
+    /**
+     * Merge the trees of two labels. The smaller root wins, so every label points to a smaller or equal one.
+     */
+    int uniteLabels(std::vector<int> &parent, const int first, const int second) {
+        const int firstRoot = findRoot(parent, first);
+        const int secondRoot = findRoot(parent, second);
+        const int root = std::min(firstRoot, secondRoot);
+        parent[std::max(firstRoot, secondRoot)] = root;
+        return root;
+    }
+
+    /**
+     * First labeling pass over a strip of rows. Pixels above the strip are treated as background.
+     * @param image Input binary image
+     * @param labels CV_32SC1 map of provisional labels
+     * @param parent Union-find forest shared by all strips
+     * @param rowBegin First row of the strip
+     * @param rowEnd Row after the last one of the strip
+     * @param firstLabel First provisional label the strip may create
+     * @return Label after the last one created by the strip
+     */
+    int labelStrip(const cv::Mat &image, cv::Mat &labels, std::vector<int> &parent,
+                   const int rowBegin, const int rowEnd, const int firstLabel) {
+        int nextLabel = firstLabel;
+        for (int x = rowBegin; x < rowEnd; x++) {
+            const uchar *imageRow = image.ptr<uchar>(x);
+            int *labelRow = labels.ptr<int>(x);
+            const int *aboveLabels = x > rowBegin ? labels.ptr<int>(x - 1) : nullptr;
+            for (int y = 0; y < image.cols; y++) {
+                if (imageRow[y] == 0) {
+                    labelRow[y] = 0;
+                    continue;
+                }
+                const int p = aboveLabels != nullptr && y > 0 ? aboveLabels[y - 1] : 0;
+                const int q = aboveLabels != nullptr ? aboveLabels[y] : 0;
+                const int r = aboveLabels != nullptr && y + 1 < image.cols ? aboveLabels[y + 1] : 0;
+                const int s = y > 0 ? labelRow[y - 1] : 0;
+                const int neighbours = (p != 0) | (q != 0) << 1 | (r != 0) << 2 | (s != 0) << 3;
+                switch (LABEL_DECISION_TABLE[neighbours]) {
+                    case LabelAction::NEW:
+                        parent[nextLabel] = nextLabel;
+                        labelRow[y] = nextLabel++;
+                        break;
+                    case LabelAction::COPY_P:
+                        labelRow[y] = p;
+                        break;
+                    case LabelAction::COPY_Q:
+                        labelRow[y] = q;
+                        break;
+                    case LabelAction::COPY_R:
+                        labelRow[y] = r;
+                        break;
+                    case LabelAction::COPY_S:
+                        labelRow[y] = s;
+                        break;
+                    case LabelAction::MERGE_P_R:
+                        labelRow[y] = uniteLabels(parent, p, r);
+                        break;
+                    case LabelAction::MERGE_S_R:
+                        labelRow[y] = uniteLabels(parent, s, r);
+                        break;
+                }
+            }
+        }
+        return nextLabel;
+    }
+
+    using Masks::MaskOffset;
+    using Masks::StructuringElement;
+
+    /**
+     * Look up a structuring element, checking its number against the size of the set.
+     */
+    const StructuringElement &structuringElement(const int maskNumber,
+                                                 const std::span<const StructuringElement> maskMapping) {
+        if (maskNumber < 1 || maskNumber > static_cast<int>(maskMapping.size())) {
+            throw std::out_of_range("Mask number has to be between 1 and " + std::to_string(maskMapping.size())
+                                    + " inclusive");
+        }
+        return maskMapping[maskNumber - 1];
+    }
+
+    /**
+     * Check if an image only holds the values 0 and 255, so it can be processed as a BitImage
+     * with the same result.
+     */
+    bool isBinary(const cv::Mat &image) {
+        if (image.type() != CV_8UC1) {
+            return false;
+        }
+        for (int x = 0; x < image.rows; x++) {
+            const uchar *imageRow = image.ptr<uchar>(x);
+            for (int y = 0; y < image.cols; y++) {
+                if (imageRow[y] != 0 && imageRow[y] != 255) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Word offset of a column offset, rounded down so that the bit offset is never negative.
+     */
+    constexpr int wordOffset(const int colOffset) {
+        return colOffset >= 0
+                   ? colOffset / BitImage::WORD_BITS
+                   : -((BitImage::WORD_BITS - 1 - colOffset) / BitImage::WORD_BITS);
+    }
+
+    /**
+     * Word of a packed row shifted left by wordOffset * 64 + bitOffset pixels (pixel y of the result is pixel
+     * y + offset of the row). Pixels outside of the row, or of a missing row, are background.
+     * @param row Packed row or nullptr for a row outside of the image
+     * @param bitOffset Offset within a word, between 0 and 63
+     */
+    uint64_t shiftedWord(const uint64_t *row, const int wordsPerRow, const int word, const int wordOffset,
+                         const int bitOffset) {
+        const auto wordAt = [&](const int index) {
+            return row != nullptr && index >= 0 && index < wordsPerRow ? row[index] : uint64_t{0};
+        };
+        const uint64_t low = wordAt(word + wordOffset) >> bitOffset;
+        return bitOffset == 0 ? low : low | wordAt(word + wordOffset + 1) << (BitImage::WORD_BITS - bitOffset);
+    }
+
+    /**
+     * Packed row a field reads for row x of the result, nullptr if it lies outside of the image.
+     */
+    const uint64_t *fieldRow(const BitImage &image, const int x, const MaskOffset &offset) {
+        const int sourceX = x + offset.row;
+        return sourceX >= 0 && sourceX < image.rows() ? image.row(sourceX) : nullptr;
+    }
+
+    /**
+     * Pixels of a word matched by a field: a white field matches foreground and a black field background.
+     */
+    uint64_t fieldMatches(const uint64_t *sourceRow, const int wordsPerRow, const int word,
+                          const MaskOffset &offset) {
+        const int fieldWordOffset = wordOffset(offset.col);
+        const uint64_t shifted = shiftedWord(sourceRow, wordsPerRow, word, fieldWordOffset,
+                                             offset.col - fieldWordOffset * BitImage::WORD_BITS);
+        return offset.isBlack ? ~shifted : shifted;
+    }
+
+    /**
+     * Combine the copies of an image shifted by the fields of a structuring element, 64 pixels at a time.
+     * Dilation sets the pixels matched by any field, erosion keeps the pixels matched by all of them.
+     * The fields are unrolled and their offsets are constants, so every shift compiles to fixed instructions.
+     */
+    template<StructuringElement ELEMENT, bool IS_DILATION>
+    BitImage morphologyKernel(const BitImage &image) {
+        constexpr auto FIELDS = std::make_index_sequence<static_cast<size_t>(ELEMENT.size)>{};
+        BitImage result(image.rows(), image.cols());
+        const int wordsPerRow = image.wordsPerRow();
+#pragma omp parallel for
+        for (int x = 0; x < image.rows(); x++) {
+            const auto sourceRows = [&]<size_t... FIELD>(std::index_sequence<FIELD...>) {
+                return std::array<const uint64_t *, sizeof...(FIELD)>{fieldRow(image, x, ELEMENT.offsets[FIELD])...};
+            }(FIELDS);
+            uint64_t *resultRow = result.row(x);
+            for (int word = 0; word < wordsPerRow; word++) {
+                resultRow[word] = [&]<size_t... FIELD>(std::index_sequence<FIELD...>) {
+                    if constexpr (IS_DILATION) {
+                        return (uint64_t{0} | ... | fieldMatches(sourceRows[FIELD], wordsPerRow, word,
+                                                                 ELEMENT.offsets[FIELD]));
+                    } else {
+                        return (~uint64_t{0} & ... & fieldMatches(sourceRows[FIELD], wordsPerRow, word,
+                                                                  ELEMENT.offsets[FIELD]));
+                    }
+                }(FIELDS);
+            }
+            resultRow[wordsPerRow - 1] &= image.lastWordMask();
+        }
+        return result;
+    }
+
+    /**
+     * Same as morphologyKernel for a structuring element only known at runtime.
+     */
+    BitImage morphologyKernel(const BitImage &image, const StructuringElement &element, const bool isDilation) {
+        BitImage result(image.rows(), image.cols());
+        const int wordsPerRow = image.wordsPerRow();
+#pragma omp parallel for
+        for (int x = 0; x < image.rows(); x++) {
+            uint64_t *resultRow = result.row(x);
+            std::fill_n(resultRow, wordsPerRow, isDilation ? uint64_t{0} : ~uint64_t{0});
+            for (int field = 0; field < element.size; field++) {
+                const MaskOffset &offset = element.offsets[field];
+                const uint64_t *sourceRow = fieldRow(image, x, offset);
+                for (int word = 0; word < wordsPerRow; word++) {
+                    const uint64_t matches = fieldMatches(sourceRow, wordsPerRow, word, offset);
+                    resultRow[word] = isDilation ? resultRow[word] | matches : resultRow[word] & matches;
+                }
+            }
+            resultRow[wordsPerRow - 1] &= image.lastWordMask();
+        }
+        return result;
+    }
+
+    using MorphologyKernel = BitImage (*)(const BitImage &image);
+
+    template<const auto &ELEMENTS, bool IS_DILATION, size_t... MASK>
+    constexpr std::array<MorphologyKernel, sizeof...(MASK)> makeKernelTable(std::index_sequence<MASK...>) {
+        return {&morphologyKernel<ELEMENTS[MASK], IS_DILATION>...};
+    }
+
+    /**
+     * Specialized kernels of every structuring element of a set, indexed by mask number - 1.
+     */
+    template<const auto &ELEMENTS, bool IS_DILATION>
+    constexpr std::array KERNEL_TABLE = makeKernelTable<ELEMENTS, IS_DILATION>(
+        std::make_index_sequence<ELEMENTS.size()>{});
+
+    template<const auto &ELEMENTS>
+    MorphologyKernel kernelOf(const int maskNumber, const bool isDilation) {
+        return isDilation
+                   ? KERNEL_TABLE<ELEMENTS, true>[maskNumber - 1]
+                   : KERNEL_TABLE<ELEMENTS, false>[maskNumber - 1];
+    }
+
+    /**
+     * Dilate or erode a packed image with the specialized kernel of the mask when the set is one of the sets
+     * of Masks.h, otherwise with the generic kernel.
+     */
+    BitImage morphology(const BitImage &image, const int maskNumber,
+                        const std::span<const StructuringElement> maskMapping, const bool isDilation) {
+        if (image.empty()) {
+            throw std::invalid_argument("Image cannot be empty");
+        }
+        const StructuringElement &element = structuringElement(maskNumber, maskMapping);
+        if (maskMapping.data() == maskMap.data()) {
+            return kernelOf<maskMap>(maskNumber, isDilation)(image);
+        }
+        if (maskMapping.data() == hmtMaskMap.data()) {
+            return kernelOf<hmtMaskMap>(maskNumber, isDilation)(image);
+        }
+        if (maskMapping.data() == hmtComplementMaskMap.data()) {
+            return kernelOf<hmtComplementMaskMap>(maskNumber, isDilation)(image);
+        }
+        return morphologyKernel(image, element, isDilation);
+    }
+}
+
 
 namespace MorphologicalProcessor {
     cv::Mat complement(cv::Mat image) {
@@ -45,57 +345,31 @@ namespace MorphologicalProcessor {
     }
 
     cv::Mat dilation(cv::Mat image, const int maskNumber,
-                                             const std::unordered_map<int, std::vector<std::vector<FieldType> > > &
-                                             maskMapping) {
+                     const std::span<const Masks::StructuringElement> maskMapping) {
         if (image.empty()) {
             throw std::invalid_argument("Image cannot be empty");
         }
-        if (maskMapping == maskMap) {
-            if (maskNumber < 1 || maskNumber > 10) {
-                throw std::out_of_range("Mask number has to be between 1 and 10 inclusive for maskMap");
-            }
-        } else {
-            if (maskNumber < 1 || maskNumber > 12) {
-                throw std::out_of_range("Mask number has to be between 1 and 12 inclusive for hmtMaskMap");
-            }
+        const Masks::StructuringElement &element = structuringElement(maskNumber, maskMapping);
+        if (isBinary(image)) {
+            return dilation(BitImage::fromMat(image), maskNumber, maskMapping).toMat();
         }
 
-
         cv::Mat result = image.clone();
-        const std::vector<std::vector<FieldType> > mask = maskMapping.find(maskNumber)->second;
-
-        int markerX = 0, markerY = 0;
-        bool foundMarker = false;
-        for (int i = 0; i < mask.size() && !foundMarker; i++) {
-            for (int j = 0; j < mask[i].size() && !foundMarker; j++) {
-                if (mask[i][j] == FieldType::BLACK_MARKER ||
-                    mask[i][j] == FieldType::WHITE_MARKER) {
-                    markerX = i;
-                    markerY = j;
-                    foundMarker = true;
-                }
-            }
-        }
 #pragma omp parallel for collapse(2)
         for (int x = 0; x < image.rows; ++x) {
             for (int y = 0; y < image.cols; ++y) {
                 bool shouldDilate = false;
-                for (int i = 0; i < mask.size() && !shouldDilate; ++i) {
-                    for (int j = 0; j < mask[i].size() && !shouldDilate; ++j) {
-                        if (mask[i][j] == FieldType::INACTIVE) continue;
-
-                        const int imgX = x + (i - markerX);
-                        const int imgY = y + (j - markerY);
-                        uchar pixelValue = 0;
-                        if (imgX >= 0 && imgX < image.rows && imgY >= 0 && imgY < image.cols) {
-                            pixelValue = image.at<uchar>(imgX, imgY);
-                        }
-
-                        if (const FieldType ft = mask[i][j];
-                            ((ft == FieldType::BLACK_MARKER || ft == FieldType::BLACK) && pixelValue == 0) || (
-                                (ft == FieldType::WHITE_MARKER || ft == FieldType::WHITE) && pixelValue == 255)) {
-                            shouldDilate = true;
-                        }
+                for (int field = 0; field < element.size && !shouldDilate; ++field) {
+                    const Masks::MaskOffset &offset = element.offsets[field];
+                    const int imgX = x + offset.row;
+                    const int imgY = y + offset.col;
+                    uchar pixelValue = 0;
+                    if (imgX >= 0 && imgX < image.rows && imgY >= 0 && imgY < image.cols) {
+                        pixelValue = image.at<uchar>(imgX, imgY);
+                    }
+
+                    if ((offset.isBlack && pixelValue == 0) || (!offset.isBlack && pixelValue == 255)) {
+                        shouldDilate = true;
                     }
                 }
                 result.at<uchar>(x, y) = shouldDilate ? 255 : 0;
@@ -105,56 +379,31 @@ namespace MorphologicalProcessor {
     }
 
     cv::Mat erosion(cv::Mat image, const int maskNumber,
-                                            const std::unordered_map<int, std::vector<std::vector<FieldType> > > &
-                                            maskMapping) {
+                    const std::span<const Masks::StructuringElement> maskMapping) {
         if (image.empty()) {
             throw std::invalid_argument("Image cannot be empty");
         }
-        if (maskMapping == maskMap) {
-            if (maskNumber < 1 || maskNumber > 10) {
-                throw std::out_of_range("Mask number has to be between 1 and 10 inclusive for maskMap");
-            }
-        } else {
-            if (maskNumber < 1 || maskNumber > 12) {
-                throw std::out_of_range("Mask number has to be between 1 and 12 inclusive for hmtMaskMap");
-            }
+        const Masks::StructuringElement &element = structuringElement(maskNumber, maskMapping);
+        if (isBinary(image)) {
+            return erosion(BitImage::fromMat(image), maskNumber, maskMapping).toMat();
         }
 
         cv::Mat result = image.clone();
-        const std::vector<std::vector<FieldType> > mask = maskMapping.find(maskNumber)->second;
-
-        int markerX = 0, markerY = 0;
-        bool foundMarker = false;
-        for (int i = 0; i < mask.size() && !foundMarker; i++) {
-            for (int j = 0; j < mask[i].size() && !foundMarker; j++) {
-                if (mask[i][j] == FieldType::BLACK_MARKER ||
-                    mask[i][j] == FieldType::WHITE_MARKER) {
-                    markerX = i;
-                    markerY = j;
-                    foundMarker = true;
-                }
-            }
-        }
 #pragma omp parallel for collapse(2)
         for (int x = 0; x < image.rows; ++x) {
             for (int y = 0; y < image.cols; ++y) {
                 bool shouldErode = false;
-                for (int i = 0; i < mask.size() && !shouldErode; ++i) {
-                    for (int j = 0; j < mask[i].size() && !shouldErode; ++j) {
-                        if (mask[i][j] == FieldType::INACTIVE) continue;
-
-                        const int imgX = x + (i - markerX);
-                        const int imgY = y + (j - markerY);
-                        uchar pixelValue = 0;
-                        if (imgX >= 0 && imgX < image.rows && imgY >= 0 && imgY < image.cols) {
-                            pixelValue = image.at<uchar>(imgX, imgY);
-                        }
-
-                        if (const FieldType ft = mask[i][j];
-                            ((ft == FieldType::BLACK_MARKER || ft == FieldType::BLACK) && pixelValue != 0) || (
-                                ft == FieldType::WHITE_MARKER || ft == FieldType::WHITE) && pixelValue != 255) {
-                            shouldErode = true;
-                        }
+                for (int field = 0; field < element.size && !shouldErode; ++field) {
+                    const Masks::MaskOffset &offset = element.offsets[field];
+                    const int imgX = x + offset.row;
+                    const int imgY = y + offset.col;
+                    uchar pixelValue = 0;
+                    if (imgX >= 0 && imgX < image.rows && imgY >= 0 && imgY < image.cols) {
+                        pixelValue = image.at<uchar>(imgX, imgY);
+                    }
+
+                    if ((offset.isBlack && pixelValue != 0) || (!offset.isBlack && pixelValue != 255)) {
+                        shouldErode = true;
                     }
                 }
                 result.at<uchar>(x, y) = shouldErode ? 0 : 255;
@@ -164,8 +413,10 @@ namespace MorphologicalProcessor {
     }
 
     cv::Mat opening(const cv::Mat &image, const int maskNumber,
-                                            const std::unordered_map<int, std::vector<std::vector<FieldType> > > &
-                                            maskMapping) {
+                    const std::span<const Masks::StructuringElement> maskMapping) {
+        if (isBinary(image)) {
+            return opening(BitImage::fromMat(image), maskNumber, maskMapping).toMat();
+        }
         cv::Mat result = image.clone();
         result = erosion(result, maskNumber, maskMapping);
         result = dilation(result, maskNumber, maskMapping);
@@ -173,8 +424,10 @@ namespace MorphologicalProcessor {
     }
 
     cv::Mat closing(const cv::Mat &image, const int maskNumber,
-                                            const std::unordered_map<int, std::vector<std::vector<FieldType> > > &
-                                            maskMapping) {
+                    const std::span<const Masks::StructuringElement> maskMapping) {
+        if (isBinary(image)) {
+            return closing(BitImage::fromMat(image), maskNumber, maskMapping).toMat();
+        }
         cv::Mat result = image.clone();
         result = dilation(result, maskNumber, maskMapping);
         result = erosion(result, maskNumber, maskMapping);
@@ -182,6 +435,9 @@ namespace MorphologicalProcessor {
     }
 
     cv::Mat hmt(const cv::Mat &image, const int maskNumber) {
+        if (isBinary(image)) {
+            return hmt(BitImage::fromMat(image), maskNumber).toMat();
+        }
         cv::Mat foregroundMatch = image.clone();
         cv::Mat backgroundMatch = image.clone();
 
@@ -202,4 +458,163 @@ namespace MorphologicalProcessor {
 
         return result;
     }
+
+    BitImage complement(const BitImage &image) {
+        BitImage result(image.rows(), image.cols());
+#pragma omp parallel for
+        for (int x = 0; x < image.rows(); x++) {
+            const uint64_t *imageRow = image.row(x);
+            uint64_t *resultRow = result.row(x);
+            for (int word = 0; word < image.wordsPerRow(); word++) {
+                resultRow[word] = ~imageRow[word];
+            }
+            resultRow[image.wordsPerRow() - 1] &= image.lastWordMask();
+        }
+        return result;
+    }
+
+    BitImage imagesUnion(const BitImage &image1, const BitImage &image2) {
+        if (image1.rows() != image2.rows() || image1.cols() != image2.cols()) {
+            throw std::invalid_argument("Images must have the same size");
+        }
+        BitImage result(image1.rows(), image1.cols());
+#pragma omp parallel for
+        for (int x = 0; x < image1.rows(); x++) {
+            const uint64_t *firstRow = image1.row(x);
+            const uint64_t *secondRow = image2.row(x);
+            uint64_t *resultRow = result.row(x);
+            for (int word = 0; word < image1.wordsPerRow(); word++) {
+                resultRow[word] = firstRow[word] | secondRow[word];
+            }
+        }
+        return result;
+    }
+
+    bool areEqual(const BitImage &image1, const BitImage &image2) {
+        return image1 == image2;
+    }
+
+    BitImage dilation(const BitImage &image, const int maskNumber,
+                      const std::span<const Masks::StructuringElement> maskMapping) {
+        return morphology(image, maskNumber, maskMapping, true);
+    }
+
+    BitImage erosion(const BitImage &image, const int maskNumber,
+                     const std::span<const Masks::StructuringElement> maskMapping) {
+        return morphology(image, maskNumber, maskMapping, false);
+    }
+
+    BitImage opening(const BitImage &image, const int maskNumber,
+                     const std::span<const Masks::StructuringElement> maskMapping) {
+        return dilation(erosion(image, maskNumber, maskMapping), maskNumber, maskMapping);
+    }
+
+    BitImage closing(const BitImage &image, const int maskNumber,
+                     const std::span<const Masks::StructuringElement> maskMapping) {
+        return erosion(dilation(image, maskNumber, maskMapping), maskNumber, maskMapping);
+    }
+
+    BitImage hmt(const BitImage &image, const int maskNumber) {
+        const BitImage foregroundMatch = erosion(image, maskNumber, hmtMaskMap);
+        BitImage result = erosion(complement(image), maskNumber, hmtComplementMaskMap);
+#pragma omp parallel for
+        for (int x = 0; x < result.rows(); x++) {
+            const uint64_t *foregroundRow = foregroundMatch.row(x);
+            uint64_t *resultRow = result.row(x);
+            for (int word = 0; word < result.wordsPerRow(); word++) {
+                resultRow[word] &= foregroundRow[word];
+            }
+        }
+        return result;
+    }
+
+    cv::Mat connectedComponents(const cv::Mat &image, std::vector<ComponentStats> &stats) {
+        if (image.empty()) {
+            throw std::invalid_argument("Image cannot be empty");
+        }
+        if (image.type() != CV_8UC1) {
+            throw std::invalid_argument("Connected component labeling requires a single channel binary image");
+        }
+
+        cv::Mat labels(image.size(), CV_32SC1);
+        const int stripCount = std::clamp(Threading::getThreadCount(), 1, image.rows);
+        std::vector<int> stripBegins(stripCount + 1);
+        for (int strip = 0; strip <= stripCount; strip++) {
+            stripBegins[strip] = strip * image.rows / stripCount;
+        }
+
+        // A strip creates at most one label per pixel, so its labels start after those the pixels above could take
+        std::vector<int> parent(image.total() + 1);
+        std::vector<int> stripLabelEnds(stripCount);
+#pragma omp parallel for schedule(static, 1)
+        for (int strip = 0; strip < stripCount; strip++) {
+            stripLabelEnds[strip] = labelStrip(image, labels, parent, stripBegins[strip], stripBegins[strip + 1],
+                                               stripBegins[strip] * image.cols + 1);
+        }
+
+        for (int strip = 1; strip < stripCount; strip++) {
+            const int x = stripBegins[strip];
+            const int *aboveLabels = labels.ptr<int>(x - 1);
+            const int *belowLabels = labels.ptr<int>(x);
+            for (int y = 0; y < image.cols; y++) {
+                if (belowLabels[y] == 0) {
+                    continue;
+                }
+                for (int neighbourY = std::max(0, y - 1); neighbourY <= std::min(image.cols - 1, y + 1);
+                     neighbourY++) {
+                    if (aboveLabels[neighbourY] != 0) {
+                        uniteLabels(parent, aboveLabels[neighbourY], belowLabels[y]);
+                    }
+                }
+            }
+        }
+
+        // Labels only point to smaller ones, so in ascending order the parent of a label is already final
+        int componentCount = 0;
+        for (int strip = 0; strip < stripCount; strip++) {
+            for (int label = stripBegins[strip] * image.cols + 1; label < stripLabelEnds[strip]; label++) {
+                parent[label] = parent[label] == label ? ++componentCount : parent[parent[label]];
+            }
+        }
+
+#pragma omp parallel for
+        for (int x = 0; x < labels.rows; x++) {
+            int *labelRow = labels.ptr<int>(x);
+            for (int y = 0; y < labels.cols; y++) {
+                labelRow[y] = labelRow[y] == 0 ? 0 : parent[labelRow[y]];
+            }
+        }
+
+        std::vector<long long> rowSums(componentCount, 0);
+        std::vector<long long> colSums(componentCount, 0);
+        std::vector<int> bottoms(componentCount, -1);
+        std::vector<int> rights(componentCount, -1);
+        stats.assign(componentCount, ComponentStats{0, image.rows, image.cols, 0, 0, 0, 0});
+        for (int x = 0; x < labels.rows; x++) {
+            const int *labelRow = labels.ptr<int>(x);
+            for (int y = 0; y < labels.cols; y++) {
+                if (labelRow[y] == 0) {
+                    continue;
+                }
+                const int component = labelRow[y] - 1;
+                ComponentStats &componentStats = stats[component];
+                componentStats.area++;
+                componentStats.top = std::min(componentStats.top, x);
+                componentStats.left = std::min(componentStats.left, y);
+                bottoms[component] = std::max(bottoms[component], x);
+                rights[component] = std::max(rights[component], y);
+                rowSums[component] += x;
+                colSums[component] += y;
+            }
+        }
+        for (int component = 0; component < componentCount; component++) {
+            ComponentStats &componentStats = stats[component];
+            componentStats.height = bottoms[component] - componentStats.top + 1;
+            componentStats.width = rights[component] - componentStats.left + 1;
+            componentStats.centroidX = static_cast<double>(rowSums[component]) / componentStats.area;
+            componentStats.centroidY = static_cast<double>(colSums[component]) / componentStats.area;
+        }
+
+        return labels;
+    }
 }
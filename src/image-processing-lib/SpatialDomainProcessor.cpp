@@ -4,6 +4,14 @@
 
 #include "../../include/image-processing-lib/SpatialDomainProcessor.h"
 
+#include "../../include/image-processing-lib/CpuFeatures.h"
+#include "../../include/image-processing-lib/FourierProcessor.h"
+#include "../../include/image-processing-lib/StencilKernels.h"
+#include "../../include/image-processing-lib/Threading.h"
+
+#include <numeric>
+#include <sstream>
+
 namespace {
     template<typename TPixel>
     double getIntensity(const TPixel &pixel);
@@ -18,363 +26,1517 @@ namespace {
         return pixel[0] + pixel[1] + pixel[2];
     }
 
-    cv::Mat padImage(const cv::Mat &image) {
-        cv::Mat padded;
-        constexpr int borderSize = 1;
-        copyMakeBorder(image, padded, borderSize, borderSize, borderSize, borderSize, cv::BORDER_CONSTANT);
-        return padded;
-    }
-}
+    /**
+     * Pick the smaller of two intensities.
+     */
+    struct MinimumPicker {
+        uchar operator()(const uchar a, const uchar b) const {
+            return std::min(a, b);
+        }
+    };
 
-namespace SpatialDomainProcessor {
-    cv::Mat modifyBrightness(const cv::Mat &image, const int modVal) {
-        cv::Mat result = image.clone();
-        for (int x = 0; x < result.rows; x++) {
-            for (int y = 0; y < result.cols; y++) {
-                if (modVal < 0) {
-                    if (result.at<uchar>(x, y) >= 0 - modVal) {
-                        result.at<uchar>(x, y) += modVal;
-                    } else {
-                        result.at<uchar>(x, y) = 0;
+    /**
+     * Pick the larger of two intensities.
+     */
+    struct MaximumPicker {
+        uchar operator()(const uchar a, const uchar b) const {
+            return std::max(a, b);
+        }
+    };
+
+    /**
+     * Compute a sliding extremum along every row using the van Herk/Gil-Werman algorithm.
+     * The row is virtually padded with the identity of the picker and split into blocks of window length,
+     * so every output needs one prefix, one suffix and one merging comparison regardless of the window length.
+     * @param image Input grayscale image
+     * @param before Number of pixels of the window before the current one
+     * @param after Number of pixels of the window after the current one
+     * @param identity Value which never wins the comparison (used outside the image)
+     * @param pick Picker choosing the extremum of two values
+     * @return Image of row-wise extremes
+     */
+    template<typename TPicker>
+    cv::Mat slidingExtremumHorizontal(const cv::Mat &image, const int before, const int after, const uchar identity,
+                                      const TPicker pick) {
+        const int cols = image.cols;
+        const int window = before + after + 1;
+        const int paddedLength = cols + before + after;
+        cv::Mat result(image.rows, cols, CV_8UC1);
+
+#pragma omp parallel
+        {
+            std::vector<uchar> padded(paddedLength, identity);
+            std::vector<uchar> prefix(paddedLength);
+            std::vector<uchar> suffix(paddedLength);
+#pragma omp for
+            for (int x = 0; x < image.rows; x++) {
+                std::copy_n(image.ptr<uchar>(x), cols, padded.begin() + before);
+                for (int start = 0; start < paddedLength; start += window) {
+                    const int end = std::min(paddedLength, start + window);
+                    prefix[start] = padded[start];
+                    for (int i = start + 1; i < end; i++) {
+                        prefix[i] = pick(prefix[i - 1], padded[i]);
                     }
-                } else {
-                    if (result.at<uchar>(x, y) <= UCHAR_MAX - modVal) {
-                        result.at<uchar>(x, y) += modVal;
-                    } else {
-                        result.at<uchar>(x, y) = UCHAR_MAX;
+                    suffix[end - 1] = padded[end - 1];
+                    for (int i = end - 2; i >= start; i--) {
+                        suffix[i] = pick(suffix[i + 1], padded[i]);
                     }
                 }
+                uchar *dstRow = result.ptr<uchar>(x);
+                for (int y = 0; y < cols; y++) {
+                    dstRow[y] = pick(suffix[y], prefix[y + window - 1]);
+                }
             }
         }
         return result;
     }
 
-    cv::Mat modifyContrastLinear(const cv::Mat &image, const int modVal) {
-        cv::Mat result = image.clone();
-        int max = 0;
-        int min = 255;
-        for (int x = 0; x < result.rows; x++) {
-            for (int y = 0; y < result.cols; y++) {
-                if (max < result.at<uchar>(x, y)) {
-                    max = static_cast<int>(result.at<uchar>(x, y));
+    /**
+     * Compute a sliding extremum along every column using the van Herk/Gil-Werman algorithm.
+     * Whole rows are combined at once, so the inner loops run over contiguous memory.
+     * @param image Input grayscale image
+     * @param before Number of pixels of the window above the current one
+     * @param after Number of pixels of the window below the current one
+     * @param identity Value which never wins the comparison (used outside the image)
+     * @param pick Picker choosing the extremum of two values
+     * @return Image of column-wise extremes
+     */
+    template<typename TPicker>
+    cv::Mat slidingExtremumVertical(const cv::Mat &image, const int before, const int after, const uchar identity,
+                                    const TPicker pick) {
+        const int rows = image.rows;
+        const int cols = image.cols;
+        const int window = before + after + 1;
+        const int paddedLength = rows + before + after;
+        const std::vector<uchar> identityRow(cols, identity);
+        auto paddedRow = [&](const int i) {
+            const int x = i - before;
+            return x >= 0 && x < rows ? image.ptr<uchar>(x) : identityRow.data();
+        };
+
+        cv::Mat prefix(paddedLength, cols, CV_8UC1);
+        cv::Mat suffix(paddedLength, cols, CV_8UC1);
+        const int blockCount = (paddedLength + window - 1) / window;
+#pragma omp parallel for
+        for (int block = 0; block < blockCount; block++) {
+            const int start = block * window;
+            const int end = std::min(paddedLength, start + window);
+            std::copy_n(paddedRow(start), cols, prefix.ptr<uchar>(start));
+            for (int i = start + 1; i < end; i++) {
+                const uchar *previous = prefix.ptr<uchar>(i - 1);
+                const uchar *current = paddedRow(i);
+                uchar *dst = prefix.ptr<uchar>(i);
+                for (int y = 0; y < cols; y++) {
+                    dst[y] = pick(previous[y], current[y]);
                 }
-                if (min > result.at<uchar>(x, y)) {
-                    min = static_cast<int>(result.at<uchar>(x, y));
+            }
+            std::copy_n(paddedRow(end - 1), cols, suffix.ptr<uchar>(end - 1));
+            for (int i = end - 2; i >= start; i--) {
+                const uchar *next = suffix.ptr<uchar>(i + 1);
+                const uchar *current = paddedRow(i);
+                uchar *dst = suffix.ptr<uchar>(i);
+                for (int y = 0; y < cols; y++) {
+                    dst[y] = pick(next[y], current[y]);
                 }
             }
         }
-        for (int x = 0; x < result.rows; x++) {
-            for (int y = 0; y < result.cols; y++) {
-                result.at<uchar>(x, y) = static_cast<uchar>(std::clamp(
-                    (static_cast<int>(result.at<uchar>(x, y)) - min)
-                    * std::max(max - min + 2 * modVal, 0)
-                    / (max - min) + min - modVal,
-                    0,
-                    UCHAR_MAX
-                ));
+
+        cv::Mat result(rows, cols, CV_8UC1);
+#pragma omp parallel for
+        for (int x = 0; x < rows; x++) {
+            const uchar *suffixRow = suffix.ptr<uchar>(x);
+            const uchar *prefixRow = prefix.ptr<uchar>(x + window - 1);
+            uchar *dstRow = result.ptr<uchar>(x);
+            for (int y = 0; y < cols; y++) {
+                dstRow[y] = pick(suffixRow[y], prefixRow[y]);
             }
         }
         return result;
     }
 
+    /**
+     * Compute a separable sliding extremum over a square window clipped to the image.
+     * @param image Input grayscale image
+     * @param kernelSize Side of the window
+     * @param identity Value which never wins the comparison
+     * @param pick Picker choosing the extremum of two values
+     * @return Image of window extremes
+     */
+    template<typename TPicker>
+    cv::Mat slidingExtremum(const cv::Mat &image, const int kernelSize, const uchar identity, const TPicker pick) {
+        if (kernelSize < 1) {
+            throw std::invalid_argument("Kernel size has to be a positive integer");
+        }
+        const int before = (kernelSize - 1) / 2;
+        const int after = kernelSize / 2;
+        const cv::Mat horizontal = slidingExtremumHorizontal(image, before, after, identity, pick);
+        return slidingExtremumVertical(horizontal, before, after, identity, pick);
+    }
 
-    cv::Mat modifyContrastGamma(const cv::Mat &image, const float modVal) {
-        cv::Mat result = image.clone();
-        for (int x = 0; x < result.rows; x++) {
-            for (int y = 0; y < result.cols; y++) {
-                const float normalizedPixelVal = static_cast<float>(result.at<uchar>(x, y)) / 255.0f;
-                const float gammaCorrectedVal = pow(normalizedPixelVal, modVal);
-                int gammaCorrectedPixel = static_cast<int>(round(gammaCorrectedVal * 255));
+    /**
+     * Relative tolerance used when testing whether a kernel is separable.
+     */
+    constexpr double SEPARABILITY_TOLERANCE = 1e-9;
+
+    /**
+     * Estimated cost of one butterfly relative to one multiply-add of the direct stencil.
+     */
+    constexpr double FFT_BUTTERFLY_COST = 2.0;
 
-                gammaCorrectedPixel = std::clamp(gammaCorrectedPixel, 0, UCHAR_MAX);
-                result.at<uchar>(x, y) = gammaCorrectedPixel;
+    /**
+     * Map a coordinate lying outside [0, length) into the image according to the border type.
+     * @param position Coordinate to map
+     * @param length Length of the image along the axis
+     * @param borderType Extrapolation method
+     * @return Coordinate inside the image or -1 if the pixel is a constant zero
+     */
+    int borderIndex(int position, const int length, const SpatialDomainProcessor::BorderType borderType) {
+        if (position >= 0 && position < length) {
+            return position;
+        }
+        switch (borderType) {
+            case SpatialDomainProcessor::BorderType::CONSTANT:
+                return -1;
+            case SpatialDomainProcessor::BorderType::REPLICATE:
+                return std::clamp(position, 0, length - 1);
+            case SpatialDomainProcessor::BorderType::REFLECT:
+                if (length == 1) {
+                    return 0;
+                }
+                while (position < 0 || position >= length) {
+                    position = position < 0 ? -position : 2 * (length - 1) - position;
+                }
+                return position;
+            case SpatialDomainProcessor::BorderType::WRAP:
+                return (position % length + length) % length;
+        }
+        return -1;
+    }
+
+    /**
+     * Extend a grayscale image by the given margins and convert it to double precision.
+     * @param image Input grayscale image
+     * @param top Rows added above the image
+     * @param bottom Rows added below the image
+     * @param left Columns added to the left of the image
+     * @param right Columns added to the right of the image
+     * @param borderType Extrapolation of the added pixels
+     * @return CV_64FC1 padded image
+     */
+    cv::Mat padImageDouble(const cv::Mat &image, const int top, const int bottom, const int left, const int right,
+                           const SpatialDomainProcessor::BorderType borderType) {
+        cv::Mat padded(image.rows + top + bottom, image.cols + left + right, CV_64FC1);
+        std::vector<int> colIndices(padded.cols);
+        for (int y = 0; y < padded.cols; y++) {
+            colIndices[y] = borderIndex(y - left, image.cols, borderType);
+        }
+
+#pragma omp parallel for
+        for (int x = 0; x < padded.rows; x++) {
+            const int srcX = borderIndex(x - top, image.rows, borderType);
+            auto *dstRow = padded.ptr<double>(x);
+            if (srcX < 0) {
+                std::fill_n(dstRow, padded.cols, 0.0);
+                continue;
+            }
+            const uchar *srcRow = image.ptr<uchar>(srcX);
+            for (int y = 0; y < padded.cols; y++) {
+                dstRow[y] = colIndices[y] < 0 ? 0.0 : srcRow[colIndices[y]];
+            }
+        }
+        return padded;
+    }
+
+    /**
+     * Round and saturate a double precision image to 8 bits.
+     * @param image CV_64FC1 image
+     * @return CV_8UC1 image
+     */
+    cv::Mat saturateToUchar(const cv::Mat &image) {
+        cv::Mat result(image.rows, image.cols, CV_8UC1);
+#pragma omp parallel for
+        for (int x = 0; x < image.rows; x++) {
+            const auto *srcRow = image.ptr<double>(x);
+            uchar *dstRow = result.ptr<uchar>(x);
+            for (int y = 0; y < image.cols; y++) {
+                dstRow[y] = static_cast<uchar>(std::clamp(std::round(srcRow[y]), 0.0, 255.0));
             }
         }
         return result;
     }
 
-    cv::Mat negative(const cv::Mat &image) {
-        cv::Mat result = image.clone();
-        for (int x = 0; x < result.rows; x++) {
-            for (int y = 0; y < result.cols; y++) {
-                result.at<uchar>(x, y) = 255 - result.at<uchar>(x, y);
+    /**
+     * Split a kernel into a column and a row vector whose outer product reproduces it.
+     * @param kernel CV_64FC1 kernel
+     * @param column Output column factor (kernel.rows values)
+     * @param row Output row factor (kernel.cols values)
+     * @return True if the kernel has rank 1 (or is zero)
+     */
+    bool separateKernel(const cv::Mat &kernel, std::vector<double> &column, std::vector<double> &row) {
+        int pivotRow = 0;
+        int pivotCol = 0;
+        double maxAbs = 0;
+        for (int i = 0; i < kernel.rows; i++) {
+            for (int j = 0; j < kernel.cols; j++) {
+                if (std::abs(kernel.at<double>(i, j)) > maxAbs) {
+                    maxAbs = std::abs(kernel.at<double>(i, j));
+                    pivotRow = i;
+                    pivotCol = j;
+                }
+            }
+        }
+
+        column.assign(kernel.rows, 0.0);
+        row.assign(kernel.cols, 0.0);
+        if (maxAbs == 0) {
+            return true;
+        }
+        const double pivot = kernel.at<double>(pivotRow, pivotCol);
+        for (int i = 0; i < kernel.rows; i++) {
+            column[i] = kernel.at<double>(i, pivotCol);
+        }
+        for (int j = 0; j < kernel.cols; j++) {
+            row[j] = kernel.at<double>(pivotRow, j) / pivot;
+        }
+
+        for (int i = 0; i < kernel.rows; i++) {
+            for (int j = 0; j < kernel.cols; j++) {
+                if (std::abs(column[i] * row[j] - kernel.at<double>(i, j)) > SEPARABILITY_TOLERANCE * maxAbs) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Correlate every row of a padded image with a 1D kernel.
+     * @param padded CV_64FC1 padded image
+     * @param weights Kernel weights (already flipped)
+     * @return CV_64FC1 image narrower by weights.size() - 1 columns
+     */
+    cv::Mat correlateRows(const cv::Mat &padded, const std::vector<double> &weights) {
+        const int width = padded.cols - static_cast<int>(weights.size()) + 1;
+        cv::Mat result = cv::Mat::zeros(padded.rows, width, CV_64FC1);
+#pragma omp parallel for
+        for (int x = 0; x < padded.rows; x++) {
+            const auto *srcRow = padded.ptr<double>(x);
+            auto *dstRow = result.ptr<double>(x);
+            for (size_t j = 0; j < weights.size(); j++) {
+                const double weight = weights[j];
+                const double *src = srcRow + j;
+#pragma omp simd
+                for (int y = 0; y < width; y++) {
+                    dstRow[y] += weight * src[y];
+                }
             }
         }
         return result;
     }
 
-    cv::Mat flipHorizontally(const cv::Mat &image) {
-        cv::Mat result = image.clone();
-        for (int x = 0; x < result.rows; x++) {
-            for (int y = 0; y < result.cols / 2; y++) {
-                const uchar temp = result.at<uchar>(x, y);
-                result.at<uchar>(x, y) = result.at<uchar>(x, result.cols - y - 1);
-                result.at<uchar>(x, result.cols - y - 1) = temp;
+    /**
+     * Correlate every column of a padded image with a 1D kernel.
+     * @param padded CV_64FC1 padded image
+     * @param weights Kernel weights (already flipped)
+     * @return CV_64FC1 image shorter by weights.size() - 1 rows
+     */
+    cv::Mat correlateCols(const cv::Mat &padded, const std::vector<double> &weights) {
+        const int height = padded.rows - static_cast<int>(weights.size()) + 1;
+        cv::Mat result = cv::Mat::zeros(height, padded.cols, CV_64FC1);
+#pragma omp parallel for
+        for (int x = 0; x < height; x++) {
+            auto *dstRow = result.ptr<double>(x);
+            for (size_t i = 0; i < weights.size(); i++) {
+                const double weight = weights[i];
+                const auto *src = padded.ptr<double>(x + static_cast<int>(i));
+#pragma omp simd
+                for (int y = 0; y < padded.cols; y++) {
+                    dstRow[y] += weight * src[y];
+                }
             }
         }
         return result;
     }
 
-    cv::Mat flipVertically(const cv::Mat &image) {
-        cv::Mat result = image.clone();
-        for (int x = 0; x < result.rows / 2; x++) {
-            for (int y = 0; y < result.cols; y++) {
-                const uchar temp = result.at<uchar>(x, y);
-                result.at<uchar>(x, y) = result.at<uchar>(result.rows - x - 1, y);
-                result.at<uchar>(result.rows - x - 1, y) = temp;
+    /**
+     * Correlate a padded image with a 2D kernel directly. Each kernel tap is applied to a whole output row,
+     * so the inner loop is a contiguous multiply-add.
+     * @param padded CV_64FC1 padded image
+     * @param kernel CV_64FC1 kernel (already flipped)
+     * @return CV_64FC1 image smaller by the kernel size minus one
+     */
+    cv::Mat correlateDirect(const cv::Mat &padded, const cv::Mat &kernel) {
+        const int height = padded.rows - kernel.rows + 1;
+        const int width = padded.cols - kernel.cols + 1;
+        cv::Mat result = cv::Mat::zeros(height, width, CV_64FC1);
+#pragma omp parallel for
+        for (int x = 0; x < height; x++) {
+            auto *dstRow = result.ptr<double>(x);
+            for (int i = 0; i < kernel.rows; i++) {
+                const auto *srcRow = padded.ptr<double>(x + i);
+                const auto *kernelRow = kernel.ptr<double>(i);
+                for (int j = 0; j < kernel.cols; j++) {
+                    const double weight = kernelRow[j];
+                    if (weight == 0) {
+                        continue;
+                    }
+                    const double *src = srcRow + j;
+#pragma omp simd
+                    for (int y = 0; y < width; y++) {
+                        dstRow[y] += weight * src[y];
+                    }
+                }
             }
         }
         return result;
     }
 
-    cv::Mat flipDiagonally(const cv::Mat &image) {
-        cv::Mat result = image.clone();
-        result = flipHorizontally(result);
-        return flipVertically(result);
+    /**
+     * Smallest power of two not smaller than the given length.
+     * @param length Requested length
+     * @return Power of two
+     */
+    int nextPowerOfTwo(const int length) {
+        int result = 1;
+        while (result < length) {
+            result <<= 1;
+        }
+        return result;
     }
 
-    cv::Mat resize(cv::Mat image, const float factor) {
-        const int newWidth = static_cast<int>(static_cast<float>(image.cols) * factor);
-        const int newHeight = static_cast<int>(static_cast<float>(image.rows) * factor);
-        cv::Mat newImage = cv::Mat::zeros(newHeight, newWidth, CV_8UC1);
+    /**
+     * Convolve a padded image with a kernel by multiplying their spectra.
+     * The transform size only has to cover the padded image, because the circular wrap-around
+     * lands in the margin which is discarded anyway.
+     * @param padded CV_64FC1 padded image
+     * @param kernel CV_64FC1 kernel (not flipped)
+     * @return CV_64FC1 image smaller by the kernel size minus one
+     */
+    cv::Mat convolveFrequency(const cv::Mat &padded, const cv::Mat &kernel) {
+        const int M = nextPowerOfTwo(padded.rows);
+        const int N = nextPowerOfTwo(padded.cols);
+        cv::Mat imageSpectrum = cv::Mat::zeros(M, N, CV_64FC2);
+        cv::Mat kernelSpectrum = cv::Mat::zeros(M, N, CV_64FC2);
+#pragma omp parallel for
+        for (int x = 0; x < padded.rows; x++) {
+            const auto *srcRow = padded.ptr<double>(x);
+            auto *dstRow = imageSpectrum.ptr<cv::Vec2d>(x);
+            for (int y = 0; y < padded.cols; y++) {
+                dstRow[y][0] = srcRow[y];
+            }
+        }
+        for (int i = 0; i < kernel.rows; i++) {
+            for (int j = 0; j < kernel.cols; j++) {
+                kernelSpectrum.at<cv::Vec2d>(i, j)[0] = kernel.at<double>(i, j);
+            }
+        }
+
+        FourierProcessor::fastFourierTransform2D(imageSpectrum, false);
+        FourierProcessor::fastFourierTransform2D(kernelSpectrum, false);
+
+#pragma omp parallel for
+        for (int u = 0; u < M; u++) {
+            auto *imageRow = imageSpectrum.ptr<cv::Vec2d>(u);
+            const auto *kernelRow = kernelSpectrum.ptr<cv::Vec2d>(u);
+            for (int v = 0; v < N; v++) {
+                const std::complex a(imageRow[v][0], imageRow[v][1]);
+                const std::complex b(kernelRow[v][0], kernelRow[v][1]);
+                const std::complex<double> product = a * b;
+                imageRow[v][0] = product.real();
+                imageRow[v][1] = product.imag();
+            }
+        }
+
+        FourierProcessor::fastFourierTransform2D(imageSpectrum, true);
+
+        const int height = padded.rows - kernel.rows + 1;
+        const int width = padded.cols - kernel.cols + 1;
+        const double scale = 1.0 / (static_cast<double>(M) * N);
+        cv::Mat result(height, width, CV_64FC1);
+#pragma omp parallel for
+        for (int x = 0; x < height; x++) {
+            const auto *srcRow = imageSpectrum.ptr<cv::Vec2d>(x + kernel.rows - 1);
+            auto *dstRow = result.ptr<double>(x);
+            for (int y = 0; y < width; y++) {
+                dstRow[y] = srcRow[y + kernel.cols - 1][0] * scale;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Fractional bits of the fixed-point resampling weights.
+     */
+    constexpr int RESAMPLE_WEIGHT_BITS = 12;
 
-        for (int x = 0; x < newHeight; x++) {
+    /**
+     * Fractional bits kept in the intermediate image between the horizontal and vertical resampling pass.
+     */
+    constexpr int RESAMPLE_INTERMEDIATE_BITS = 6;
+
+    /**
+     * Precomputed source indices and fixed-point weights of every output pixel along one axis.
+     * Every output pixel uses the same number of taps; unused taps have zero weight.
+     */
+    struct ResampleTable {
+        int taps = 0;
+        std::vector<int> indices;
+        std::vector<int> weights;
+    };
+
+    /**
+     * Evaluate the continuous resampling kernel of an interpolation method.
+     * @param method Interpolation method
+     * @param x Distance from the kernel centre in source pixels
+     * @return Kernel weight
+     */
+    double resampleKernel(const SpatialDomainProcessor::InterpolationMethod method, double x) {
+        x = std::abs(x);
+        switch (method) {
+            case SpatialDomainProcessor::InterpolationMethod::BILINEAR:
+                return x < 1 ? 1 - x : 0;
+            case SpatialDomainProcessor::InterpolationMethod::BICUBIC: {
+                constexpr double a = -0.5;
+                if (x < 1) {
+                    return ((a + 2) * x - (a + 3)) * x * x + 1;
+                }
+                return x < 2 ? ((a * x - 5 * a) * x + 8 * a) * x - 4 * a : 0;
+            }
+            case SpatialDomainProcessor::InterpolationMethod::LANCZOS: {
+                constexpr double lobes = 3;
+                if (x < 1e-8) {
+                    return 1;
+                }
+                if (x >= lobes) {
+                    return 0;
+                }
+                const double px = std::numbers::pi * x;
+                return lobes * std::sin(px) * std::sin(px / lobes) / (px * px);
+            }
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Half-width of the continuous resampling kernel of an interpolation method.
+     * @param method Interpolation method
+     * @return Kernel support in source pixels
+     */
+    double resampleSupport(const SpatialDomainProcessor::InterpolationMethod method) {
+        switch (method) {
+            case SpatialDomainProcessor::InterpolationMethod::BILINEAR:
+                return 1;
+            case SpatialDomainProcessor::InterpolationMethod::BICUBIC:
+                return 2;
+            case SpatialDomainProcessor::InterpolationMethod::LANCZOS:
+                return 3;
+            default:
+                return 0.5;
+        }
+    }
+
+    /**
+     * Build the resampling table of one axis. Source pixel i covers [i, i + 1) and output pixel j
+     * covers [j / scale, (j + 1) / scale). Taps outside the source are clamped to the nearest edge pixel.
+     * @param srcLength Source length along the axis
+     * @param dstLength Output length along the axis
+     * @param scale Ratio of the output and source length
+     * @param method Interpolation method (other than nearest neighbour and area)
+     * @return Table with weights summing exactly to 1 << RESAMPLE_WEIGHT_BITS for every output pixel
+     */
+    ResampleTable buildResampleTable(const int srcLength, const int dstLength, const double scale,
+                                     const SpatialDomainProcessor::InterpolationMethod method) {
+        const double filterScale = std::max(1.0, 1.0 / scale);
+        const double support = resampleSupport(method) * filterScale;
+
+        ResampleTable table;
+        table.taps = static_cast<int>(std::ceil(support)) * 2 + 1;
+        table.indices.assign(static_cast<size_t>(dstLength) * table.taps, 0);
+        table.weights.assign(static_cast<size_t>(dstLength) * table.taps, 0);
+
+        std::vector<double> weights(table.taps);
+        std::vector<double> fractions(table.taps);
+        std::vector<int> order(table.taps);
+        for (int j = 0; j < dstLength; j++) {
+            const double center = (j + 0.5) / scale;
+            const int first = static_cast<int>(std::floor(center - support));
+
+            double weightSum = 0;
+            for (int t = 0; t < table.taps; t++) {
+                weights[t] = resampleKernel(method, (first + t + 0.5 - center) / filterScale);
+                weightSum += weights[t];
+            }
+
+            // Weights are rounded down and the remainder goes one unit at a time to the taps with the largest
+            // fractional parts, so no tap is off by more than one unit even when there are thousands of them
+            int fixedSum = 0;
+            int *indices = table.indices.data() + static_cast<size_t>(j) * table.taps;
+            int *fixedWeights = table.weights.data() + static_cast<size_t>(j) * table.taps;
+            for (int t = 0; t < table.taps; t++) {
+                indices[t] = std::clamp(first + t, 0, srcLength - 1);
+                const double exactWeight = weights[t] / weightSum * (1 << RESAMPLE_WEIGHT_BITS);
+                fixedWeights[t] = static_cast<int>(std::floor(exactWeight));
+                fractions[t] = exactWeight - fixedWeights[t];
+                fixedSum += fixedWeights[t];
+            }
+            const int remainder = (1 << RESAMPLE_WEIGHT_BITS) - fixedSum;
+            std::iota(order.begin(), order.end(), 0);
+            std::nth_element(order.begin(), order.begin() + remainder, order.end(), [&](const int a, const int b) {
+                return fractions[a] != fractions[b] ? fractions[a] > fractions[b] : a < b;
+            });
+            for (int r = 0; r < remainder; r++) {
+                fixedWeights[order[r]]++;
+            }
+        }
+        return table;
+    }
+
+    /**
+     * Source pixels covered by every output pixel along one axis of an area resize, with the covered
+     * fraction of each of them. Every output pixel uses the same number of taps; unused taps cover nothing.
+     */
+    struct AreaTable {
+        int taps = 0;
+        std::vector<int> indices;
+        std::vector<double> coverages;
+        std::vector<double> totals; // Covered source length of every output pixel
+    };
+
+    /**
+     * Build the area table of one axis. Source pixel i covers [i, i + 1) and output pixel j
+     * covers [j / scale, (j + 1) / scale).
+     * @param srcLength Source length along the axis
+     * @param dstLength Output length along the axis
+     * @param scale Ratio of the output and source length
+     * @return Table of the axis
+     */
+    AreaTable buildAreaTable(const int srcLength, const int dstLength, const double scale) {
+        AreaTable table;
+        table.taps = static_cast<int>(std::ceil(1 / scale)) + 2;
+        table.indices.assign(static_cast<size_t>(dstLength) * table.taps, 0);
+        table.coverages.assign(static_cast<size_t>(dstLength) * table.taps, 0);
+        table.totals.assign(dstLength, 0);
+        for (int j = 0; j < dstLength; j++) {
+            const double begin = j / scale;
+            const double end = std::min<double>((j + 1) / scale, srcLength);
+            const int first = std::clamp(static_cast<int>(std::floor(begin)), 0, srcLength - 1);
+            int *indices = table.indices.data() + static_cast<size_t>(j) * table.taps;
+            double *coverages = table.coverages.data() + static_cast<size_t>(j) * table.taps;
+            for (int t = 0; t < table.taps; t++) {
+                const int i = std::min(first + t, srcLength - 1);
+                indices[t] = i;
+                coverages[t] = first + t < srcLength
+                                   ? std::max(0.0, std::min<double>(i + 1, end) - std::max<double>(i, begin))
+                                   : 0;
+                table.totals[j] += coverages[t];
+            }
+        }
+        return table;
+    }
+
+    /**
+     * Resize by averaging the source area covered by every output pixel. The box sums are accumulated
+     * in double precision and divided once by the covered area, so every source pixel contributes exactly
+     * its share whatever the factor.
+     */
+    cv::Mat areaResize(const cv::Mat &image, const int newHeight, const int newWidth, const double factor) {
+        const AreaTable rowTable = buildAreaTable(image.rows, newHeight, factor);
+        const AreaTable colTable = buildAreaTable(image.cols, newWidth, factor);
+
+        cv::Mat horizontal(image.rows, newWidth, CV_64FC1);
+#pragma omp parallel for
+        for (int x = 0; x < image.rows; x++) {
+            const uchar *srcRow = image.ptr<uchar>(x);
+            auto *dstRow = horizontal.ptr<double>(x);
             for (int y = 0; y < newWidth; y++) {
-                newImage.at<uchar>(x, y) = image.at<uchar>(
-                    static_cast<int>(static_cast<float>(x) / factor),
-                    static_cast<int>(static_cast<float>(y) / factor));
+                const int *indices = colTable.indices.data() + static_cast<size_t>(y) * colTable.taps;
+                const double *coverages = colTable.coverages.data() + static_cast<size_t>(y) * colTable.taps;
+                double sum = 0;
+                for (int t = 0; t < colTable.taps; t++) {
+                    sum += srcRow[indices[t]] * coverages[t];
+                }
+                dstRow[y] = sum;
+            }
+        }
+
+        cv::Mat newImage(newHeight, newWidth, CV_8UC1);
+#pragma omp parallel
+        {
+            std::vector<double> sums(newWidth);
+#pragma omp for
+            for (int x = 0; x < newHeight; x++) {
+                std::fill(sums.begin(), sums.end(), 0.0);
+                const int *indices = rowTable.indices.data() + static_cast<size_t>(x) * rowTable.taps;
+                const double *coverages = rowTable.coverages.data() + static_cast<size_t>(x) * rowTable.taps;
+                for (int t = 0; t < rowTable.taps; t++) {
+                    const double coverage = coverages[t];
+                    if (coverage == 0) {
+                        continue;
+                    }
+                    const auto *srcRow = horizontal.ptr<double>(indices[t]);
+#pragma omp simd
+                    for (int y = 0; y < newWidth; y++) {
+                        sums[y] += srcRow[y] * coverage;
+                    }
+                }
+                uchar *dstRow = newImage.ptr<uchar>(x);
+                for (int y = 0; y < newWidth; y++) {
+                    const long value = std::lround(sums[y] / (rowTable.totals[x] * colTable.totals[y]));
+                    dstRow[y] = static_cast<uchar>(std::clamp(value, 0L, static_cast<long>(UCHAR_MAX)));
+                }
             }
         }
         return newImage;
     }
 
-    cv::Mat midpointFilter(cv::Mat image, const int kernelSize) {
-        cv::Mat newImage;
-        image.copyTo(newImage);
-        const int border = (kernelSize - 1) / 2;
-        int leftFilterSize = -kernelSize / 2;
-        const int rightFilterSize = kernelSize / 2;
-        if (kernelSize % 2 == 0) {
-            leftFilterSize += 1;
-        }
-
-        for (int x = border; x < image.rows - border; x++) {
-            for (int y = border; y < image.cols - border; y++) {
-                uchar max = image.at<uchar>(x - border, y - border);
-                uchar min = image.at<uchar>(x - border, y - border);
-                for (int i = leftFilterSize; i <= rightFilterSize; i++) {
-                    for (int j = leftFilterSize; j <= rightFilterSize; j++) {
-                        const uchar currentPixel = image.at<uchar>(x + i, y + j);
-                        if (max < currentPixel) {
-                            max = currentPixel;
-                        }
-                        if (min > currentPixel) {
-                            min = currentPixel;
-                        }
+    /**
+     * Side of the square tiles used by the blocked transpose, chosen so that a source and a destination tile
+     * stay in the L1 cache together.
+     */
+    constexpr int TRANSPOSE_BLOCK_SIZE = 64;
+
+    /**
+     * Running statistics of a region grown from a seed.
+     */
+    struct RegionStats {
+        double sum = 0;
+        long long count = 0;
+        double seedIntensity = 0;
+
+        [[nodiscard]] double mean() const {
+            return sum / static_cast<double>(count);
+        }
+    };
+
+    /**
+     * Accept intensities whose distance from the region mean is at most 10% of the mean.
+     */
+    struct AdaptiveMeanCriterion {
+        bool operator()(const RegionStats &region, const double intensity) const {
+            constexpr double thresholdK = 0.1;
+            const double mean = region.mean();
+            return std::abs(mean - intensity) <= mean * thresholdK;
+        }
+    };
+
+    /**
+     * Accept intensities whose distance from the region mean is at most a fixed threshold.
+     */
+    struct FixedMeanCriterion {
+        bool operator()(const RegionStats &region, const double intensity) const {
+            constexpr double thresholdMean = 20;
+            return std::abs(region.mean() - intensity) <= thresholdMean;
+        }
+    };
+
+    /**
+     * Accept intensities whose distance from the seed intensity is at most a fixed threshold.
+     */
+    struct SeedDistanceCriterion {
+        bool operator()(const RegionStats &region, const double intensity) const {
+            constexpr double thresholdAbs = 20;
+            return std::abs(region.seedIntensity - intensity) <= thresholdAbs;
+        }
+    };
+
+    /**
+     * Height of the strips grown in parallel by growRegions.
+     */
+    constexpr int REGION_GROWING_STRIP_HEIGHT = 32;
+
+    /**
+     * Union-find over region labels. The smaller label always becomes the root,
+     * so a merged region keeps the label of its earliest seed.
+     */
+    class DisjointSet {
+        std::vector<int> parent_;
+
+    public:
+        explicit DisjointSet(const int size) : parent_(size) {
+            std::iota(parent_.begin(), parent_.end(), 0);
+        }
+
+        int find(int label) {
+            while (parent_[label] != label) {
+                parent_[label] = parent_[parent_[label]];
+                label = parent_[label];
+            }
+            return label;
+        }
+
+        void unite(const int first, const int second) {
+            const int firstRoot = find(first);
+            const int secondRoot = find(second);
+            parent_[std::max(firstRoot, secondRoot)] = std::min(firstRoot, secondRoot);
+        }
+    };
+
+    /**
+     * Grow a region with a span (scanline) fill. Whole runs of a row are claimed at once,
+     * and only the starts of candidate runs in the rows above and below are stacked.
+     * @param image Input image
+     * @param labels CV_32SC1 label map (0 means unlabeled)
+     * @param label Label written to claimed pixels
+     * @param region Statistics of the region, updated with every claimed pixel
+     * @param startX Row of a pixel which already belongs to the region
+     * @param startY Column of a pixel which already belongs to the region
+     * @param rowBegin First row the region may grow into
+     * @param rowEnd Row after the last one the region may grow into
+     * @param accepts Criterion deciding whether an intensity joins the region
+     */
+    template<typename TPixel, typename TCriterion>
+    void growRegion(const cv::Mat &image, cv::Mat &labels, const int label, RegionStats &region,
+                    const int startX, const int startY, const int rowBegin, const int rowEnd,
+                    const TCriterion accepts) {
+        std::vector<std::pair<int, int> > stack;
+        auto claim = [&](int *labelRow, const int y, const double intensity) {
+            labelRow[y] = label;
+            region.sum += intensity;
+            region.count++;
+        };
+        auto fillSpan = [&](const int x, const int y) {
+            int *labelRow = labels.ptr<int>(x);
+            const auto *imageRow = image.ptr<TPixel>(x);
+            int left = y;
+            while (left > 0 && labelRow[left - 1] == 0) {
+                const double intensity = getIntensity(imageRow[left - 1]);
+                if (!accepts(region, intensity)) {
+                    break;
+                }
+                claim(labelRow, --left, intensity);
+            }
+            int right = y;
+            while (right + 1 < image.cols && labelRow[right + 1] == 0) {
+                const double intensity = getIntensity(imageRow[right + 1]);
+                if (!accepts(region, intensity)) {
+                    break;
+                }
+                claim(labelRow, ++right, intensity);
+            }
+            for (const int neighbourX: {x - 1, x + 1}) {
+                if (neighbourX < rowBegin || neighbourX >= rowEnd) {
+                    continue;
+                }
+                const int *neighbourLabels = labels.ptr<int>(neighbourX);
+                const auto *neighbourPixels = image.ptr<TPixel>(neighbourX);
+                bool inRun = false;
+                for (int neighbourY = left; neighbourY <= right; neighbourY++) {
+                    const bool candidate = neighbourLabels[neighbourY] == 0
+                                           && accepts(region, getIntensity(neighbourPixels[neighbourY]));
+                    if (candidate && !inRun) {
+                        stack.emplace_back(neighbourX, neighbourY);
                     }
+                    inRun = candidate;
                 }
-                newImage.at<uchar>(x, y) = (max + min) / 2;
             }
+        };
+
+        fillSpan(startX, startY);
+        while (!stack.empty()) {
+            const auto [x, y] = stack.back();
+            stack.pop_back();
+            int *labelRow = labels.ptr<int>(x);
+            if (labelRow[y] != 0) {
+                continue;
+            }
+            const double intensity = getIntensity(image.ptr<TPixel>(x)[y]);
+            if (!accepts(region, intensity)) {
+                continue;
+            }
+            claim(labelRow, y, intensity);
+            fillSpan(x, y);
         }
-        return newImage;
     }
 
-    cv::Mat arithmeticMeanFilter(cv::Mat image, const int kernelSize) {
-        cv::Mat newImage;
-        image.copyTo(newImage);
-        const int border = (kernelSize - 1) / 2;
-        int leftFilterSize = -kernelSize / 2;
-        const int rightFilterSize = kernelSize / 2;
-        if (kernelSize % 2 == 0) {
-            leftFilterSize += 1;
-        }
-
-        for (int x = border; x < image.rows - border; x++) {
-            for (int y = border; y < image.cols - border; y++) {
-                int sum = 0;
-                for (int i = leftFilterSize; i <= rightFilterSize; i++) {
-                    for (int j = leftFilterSize; j <= rightFilterSize; j++) {
-                        sum += image.at<uchar>(x + j, y + i);
+    /**
+     * Region growing from a regular grid of seeds. Seeds get labels in raster order. The image is split
+     * into horizontal strips of REGION_GROWING_STRIP_HEIGHT rows, the seeds of every strip are grown in parallel
+     * within their strip, regions touching across a strip border are merged when the criterion accepts the mean
+     * of the later region, and finally regions continue growing across the borders.
+     * @param image Input image
+     * @param accepts Criterion deciding whether an intensity joins a region
+     * @return CV_32SC1 label map with consecutive labels starting at 1 (0 means unlabeled)
+     */
+    template<typename TPixel, typename TCriterion>
+    cv::Mat growRegions(const cv::Mat &image, const TCriterion accepts) {
+        cv::Mat labels = cv::Mat::zeros(image.rows, image.cols, CV_32SC1);
+        const int seedXGridSpacing = std::max(1, image.rows / 10);
+        const int seedYGridSpacing = std::max(1, image.cols / 10);
+        std::vector<std::pair<int, int> > seeds;
+        for (int seedX = seedXGridSpacing; seedX < image.rows - seedXGridSpacing; seedX += seedXGridSpacing) {
+            for (int seedY = seedYGridSpacing; seedY < image.cols - seedYGridSpacing; seedY += seedYGridSpacing) {
+                seeds.emplace_back(seedX, seedY);
+            }
+        }
+
+        // The strips only depend on the image height, so the labels do not depend on the number of threads
+        // picking them up
+        const int stripCount = std::max(1, (image.rows + REGION_GROWING_STRIP_HEIGHT - 1)
+                                           / REGION_GROWING_STRIP_HEIGHT);
+        std::vector<int> stripBegins(stripCount + 1);
+        for (int strip = 0; strip < stripCount; strip++) {
+            stripBegins[strip] = strip * REGION_GROWING_STRIP_HEIGHT;
+        }
+        stripBegins[stripCount] = image.rows;
+
+        std::vector<RegionStats> regions(seeds.size() + 1);
+#pragma omp parallel for schedule(dynamic)
+        for (int strip = 0; strip < stripCount; strip++) {
+            const int rowBegin = stripBegins[strip];
+            const int rowEnd = stripBegins[strip + 1];
+            for (size_t seed = 0; seed < seeds.size(); seed++) {
+                const auto [seedX, seedY] = seeds[seed];
+                if (seedX < rowBegin || seedX >= rowEnd || labels.ptr<int>(seedX)[seedY] != 0) {
+                    continue;
+                }
+                const int label = static_cast<int>(seed) + 1;
+                const double seedIntensity = getIntensity(image.ptr<TPixel>(seedX)[seedY]);
+                regions[label] = {seedIntensity, 1, seedIntensity};
+                labels.ptr<int>(seedX)[seedY] = label;
+                growRegion<TPixel>(image, labels, label, regions[label], seedX, seedY, rowBegin, rowEnd, accepts);
+            }
+        }
+
+        DisjointSet regionSets(static_cast<int>(regions.size()));
+        for (int strip = 1; strip < stripCount; strip++) {
+            const int x = stripBegins[strip];
+            if (x == 0 || x >= image.rows) {
+                continue;
+            }
+            const int *aboveLabels = labels.ptr<int>(x - 1);
+            const int *belowLabels = labels.ptr<int>(x);
+            for (int y = 0; y < image.cols; y++) {
+                if (aboveLabels[y] == 0 || belowLabels[y] == 0) {
+                    continue;
+                }
+                const int aboveRoot = regionSets.find(aboveLabels[y]);
+                const int belowRoot = regionSets.find(belowLabels[y]);
+                if (aboveRoot == belowRoot) {
+                    continue;
+                }
+                RegionStats &earlier = regions[std::min(aboveRoot, belowRoot)];
+                const RegionStats &later = regions[std::max(aboveRoot, belowRoot)];
+                if (accepts(earlier, later.mean())) {
+                    earlier.sum += later.sum;
+                    earlier.count += later.count;
+                    regionSets.unite(aboveRoot, belowRoot);
+                }
+            }
+        }
+
+        for (int strip = 1; strip < stripCount; strip++) {
+            const int x = stripBegins[strip];
+            if (x == 0 || x >= image.rows) {
+                continue;
+            }
+            for (int y = 0; y < image.cols; y++) {
+                for (const auto [fromX, toX]: {std::pair(x - 1, x), std::pair(x, x - 1)}) {
+                    const int fromLabel = labels.ptr<int>(fromX)[y];
+                    if (fromLabel == 0 || labels.ptr<int>(toX)[y] != 0) {
+                        continue;
                     }
+                    const int root = regionSets.find(fromLabel);
+                    const double intensity = getIntensity(image.ptr<TPixel>(toX)[y]);
+                    if (!accepts(regions[root], intensity)) {
+                        continue;
+                    }
+                    labels.ptr<int>(toX)[y] = root;
+                    regions[root].sum += intensity;
+                    regions[root].count++;
+                    growRegion<TPixel>(image, labels, root, regions[root], toX, y, 0, image.rows, accepts);
                 }
-                newImage.at<uchar>(x, y) = static_cast<uchar>(sum / pow(kernelSize, 2));
             }
         }
-        return newImage;
+
+        std::vector<int> finalLabels(regions.size(), 0);
+        int nextLabel = 0;
+        for (size_t label = 1; label < regions.size(); label++) {
+            if (regions[label].count > 0 && regionSets.find(static_cast<int>(label)) == static_cast<int>(label)) {
+                finalLabels[label] = ++nextLabel;
+            }
+        }
+        for (size_t label = 1; label < regions.size(); label++) {
+            finalLabels[label] = finalLabels[regionSets.find(static_cast<int>(label))];
+        }
+
+#pragma omp parallel for
+        for (int x = 0; x < labels.rows; x++) {
+            int *labelRow = labels.ptr<int>(x);
+            for (int y = 0; y < labels.cols; y++) {
+                labelRow[y] = finalLabels[labelRow[y]];
+            }
+        }
+        return labels;
+    }
+
+    /**
+     * Pick the widest row kernel of a stencil which both the library and the processor support.
+     */
+    StencilKernels::RowFunction selectRowFunction(const StencilKernels::StencilType type) {
+        const CpuFeatures::SimdLevel simdLevel = CpuFeatures::simdLevel();
+        if (simdLevel == CpuFeatures::SimdLevel::AVX2) {
+            if (const auto rowFunction = StencilKernels::avx2RowFunction(type); rowFunction != nullptr) {
+                return rowFunction;
+            }
+        }
+        if (simdLevel >= CpuFeatures::SimdLevel::SSE4) {
+            if (const auto rowFunction = StencilKernels::sse4RowFunction(type); rowFunction != nullptr) {
+                return rowFunction;
+            }
+        }
+        return StencilKernels::detail::rowFunction<StencilKernels::detail::ScalarLanes>(type);
     }
 
+    /**
+     * Apply a 3x3 stencil to a grayscale image. The interior of every row goes through the vectorized row kernel,
+     * the pixels near the edges, where the stencil reaches out of the image, through a separate scalar loop.
+     * @param image Input grayscale image
+     * @return Filtered image
+     */
+    template<StencilKernels::StencilType Type>
+    cv::Mat applyStencil(const cv::Mat &image) {
+        using TStencil = typename StencilKernels::detail::StencilFor<Type>::type;
+        const StencilKernels::RowFunction rowFunction = selectRowFunction(Type);
+        cv::Mat result(image.size(), CV_8UC1);
 
-    cv::Mat padImageGrayscale(const cv::Mat &image, const int padValue) {
-        cv::Mat paddedImage = cv::Mat::zeros(image.rows + padValue * 2, image.cols + padValue * 2, CV_8UC1);
+        auto borderPixel = [&image](const int x, const int y) -> uchar {
+            if constexpr (TStencil::COPY_BORDER) {
+                return image.ptr<uchar>(x)[y];
+            } else {
+                uchar neighbourhood[3][3];
+                for (int i = 0; i < 3; i++) {
+                    for (int j = 0; j < 3; j++) {
+                        const int neighbourX = x + i - 1;
+                        const int neighbourY = y + j - 1;
+                        neighbourhood[i][j] = neighbourX >= 0 && neighbourX < image.rows &&
+                                              neighbourY >= 0 && neighbourY < image.cols
+                                                  ? image.ptr<uchar>(neighbourX)[neighbourY]
+                                                  : 0;
+                    }
+                }
+                return StencilKernels::detail::clampToUchar(
+                    TStencil::template evaluate<StencilKernels::detail::ScalarLanes>(
+                        neighbourhood[0] + 1, neighbourhood[1] + 1, neighbourhood[2] + 1));
+            }
+        };
+
+        const int interiorBegin = std::min(TStencil::LEFT, image.cols);
+        const int interiorEnd = std::max(interiorBegin, image.cols - TStencil::RIGHT);
+#pragma omp parallel for
+        for (int x = 0; x < image.rows; x++) {
+            uchar *resultRow = result.ptr<uchar>(x);
+            if (x < TStencil::TOP || x >= image.rows - TStencil::BOTTOM) {
+                for (int y = 0; y < image.cols; y++) {
+                    resultRow[y] = borderPixel(x, y);
+                }
+                continue;
+            }
+            const uchar *row = image.ptr<uchar>(x);
+            rowFunction(x > 0 ? image.ptr<uchar>(x - 1) : row, row,
+                        x + 1 < image.rows ? image.ptr<uchar>(x + 1) : row,
+                        resultRow, interiorBegin, interiorEnd);
+            for (int y = 0; y < interiorBegin; y++) {
+                resultRow[y] = borderPixel(x, y);
+            }
+            for (int y = interiorEnd; y < image.cols; y++) {
+                resultRow[y] = borderPixel(x, y);
+            }
+        }
+        return result;
+    }
+}
+
+namespace SpatialDomainProcessor {
+    cv::Mat modifyBrightness(const cv::Mat &image, const int modVal) {
+        return applyLookupTable(image, brightnessLookupTable(modVal));
+    }
+
+    cv::Mat modifyContrastLinear(const cv::Mat &image, const int modVal) {
+        int max = 0;
+        int min = 255;
+#pragma omp parallel for reduction(max:max) reduction(min:min)
         for (int x = 0; x < image.rows; x++) {
+            const uchar *row = image.ptr<uchar>(x);
             for (int y = 0; y < image.cols; y++) {
-                paddedImage.at<uchar>(x + padValue, y + padValue) = image.at<uchar>(x, y);
+                max = std::max(max, static_cast<int>(row[y]));
+                min = std::min(min, static_cast<int>(row[y]));
             }
         }
-        return paddedImage;
+        return applyLookupTable(image, contrastLinearLookupTable(modVal, min, max));
     }
 
-    cv::Mat laplacianFilter(const cv::Mat &image, const int laplaceMask) {
-        static constexpr std::array<std::array<std::array<int, 3>, 3>, 3> laplacianMasks = {{
-            {{{0, -1, 0}, {-1, 4, -1}, {0, -1, 0}}},
-            {{{-1, -1, -1}, {-1, 8, -1}, {-1, -1, -1}}},
-            {{{1, -2, 1}, {-2, 4, -2}, {1, -2, 1}}}
-        }};
+    cv::Mat modifyContrastGamma(const cv::Mat &image, const float modVal) {
+        return applyLookupTable(image, contrastGammaLookupTable(modVal));
+    }
+
+    cv::Mat negative(const cv::Mat &image) {
+        return applyLookupTable(image, negativeLookupTable());
+    }
+
+    std::array<uchar, UCHAR_MAX + 1> identityLookupTable() {
+        std::array<uchar, UCHAR_MAX + 1> lookupTable{};
+        for (int i = 0; i <= UCHAR_MAX; i++) {
+            lookupTable[i] = static_cast<uchar>(i);
+        }
+        return lookupTable;
+    }
+
+    std::array<uchar, UCHAR_MAX + 1> brightnessLookupTable(const int modVal) {
+        std::array<uchar, UCHAR_MAX + 1> lookupTable{};
+        for (int i = 0; i <= UCHAR_MAX; i++) {
+            lookupTable[i] = static_cast<uchar>(std::clamp(i + modVal, 0, UCHAR_MAX));
+        }
+        return lookupTable;
+    }
+
+    std::array<uchar, UCHAR_MAX + 1> contrastLinearLookupTable(const int modVal, const int min, const int max) {
+        if (max <= min) {
+            return identityLookupTable();
+        }
+        std::array<uchar, UCHAR_MAX + 1> lookupTable{};
+        for (int i = 0; i <= UCHAR_MAX; i++) {
+            lookupTable[i] = static_cast<uchar>(std::clamp(
+                (i - min)
+                * std::max(max - min + 2 * modVal, 0)
+                / (max - min) + min - modVal,
+                0,
+                UCHAR_MAX
+            ));
+        }
+        return lookupTable;
+    }
+
+    std::array<uchar, UCHAR_MAX + 1> contrastGammaLookupTable(const float modVal) {
+        std::array<uchar, UCHAR_MAX + 1> lookupTable{};
+        for (int i = 0; i <= UCHAR_MAX; i++) {
+            const float normalizedPixelVal = static_cast<float>(i) / 255.0f;
+            const float gammaCorrectedVal = pow(normalizedPixelVal, modVal);
+            const int gammaCorrectedPixel = static_cast<int>(round(gammaCorrectedVal * 255));
+            lookupTable[i] = static_cast<uchar>(std::clamp(gammaCorrectedPixel, 0, UCHAR_MAX));
+        }
+        return lookupTable;
+    }
 
-        if (laplaceMask < 0 || laplaceMask > 2) {
-            throw std::invalid_argument("Invalid laplaceMask value");
+    std::array<uchar, UCHAR_MAX + 1> negativeLookupTable() {
+        std::array<uchar, UCHAR_MAX + 1> lookupTable{};
+        for (int i = 0; i <= UCHAR_MAX; i++) {
+            lookupTable[i] = static_cast<uchar>(UCHAR_MAX - i);
         }
+        return lookupTable;
+    }
+
+    std::array<uchar, UCHAR_MAX + 1> composeLookupTables(const std::array<uchar, UCHAR_MAX + 1> &first,
+                                                         const std::array<uchar, UCHAR_MAX + 1> &second) {
+        std::array<uchar, UCHAR_MAX + 1> lookupTable{};
+        for (int i = 0; i <= UCHAR_MAX; i++) {
+            lookupTable[i] = second[first[i]];
+        }
+        return lookupTable;
+    }
 
-        const auto &mask = laplacianMasks[laplaceMask];
+    cv::Mat applyLookupTable(const cv::Mat &image, const std::array<uchar, UCHAR_MAX + 1> &lookupTable) {
+        cv::Mat result(image.size(), image.type());
+        const int rowLength = image.cols * image.channels();
+#pragma omp parallel for
+        for (int x = 0; x < image.rows; x++) {
+            const uchar *srcRow = image.ptr<uchar>(x);
+            uchar *dstRow = result.ptr<uchar>(x);
+            for (int y = 0; y < rowLength; y++) {
+                dstRow[y] = lookupTable[srcRow[y]];
+            }
+        }
+        return result;
+    }
 
-        cv::Mat paddedImage = padImage(image);
-        cv::Mat result = image.clone();
+    GeometricTransform GeometricTransform::then(const GeometricTransform &next) const {
+        // Transposing a row reversal gives a column reversal and vice versa, so the flips of this
+        // transform swap when they are moved behind the transposition of the next one.
+        const bool movedFlipRows = next.transpose ? flipCols : flipRows;
+        const bool movedFlipCols = next.transpose ? flipRows : flipCols;
+        return {transpose != next.transpose, movedFlipRows != next.flipRows, movedFlipCols != next.flipCols};
+    }
 
-        for (int x = 1; x < paddedImage.rows - 1; x++) {
-            for (int y = 1; y < paddedImage.cols - 1; y++) {
-                int convolutionValue = 0;
+    bool GeometricTransform::isIdentity() const {
+        return !transpose && !flipRows && !flipCols;
+    }
 
-                for (int i = -1; i <= 1; i++) {
-                    for (int j = -1; j <= 1; j++) {
-                        int pixel = paddedImage.at<uchar>(x + i, y + j);
-                        int maskVal = mask[i + 1][j + 1];
-                        convolutionValue += pixel * maskVal;
+    GeometricTransform GeometricTransform::rotation(const int degrees) {
+        if (degrees % 90 != 0) {
+            throw std::invalid_argument("Rotation angle has to be a multiple of 90 degrees");
+        }
+        switch ((degrees / 90 % 4 + 4) % 4) {
+            case 1:
+                return {true, false, true};
+            case 2:
+                return {false, true, true};
+            case 3:
+                return {true, true, false};
+            default:
+                return {};
+        }
+    }
+
+    cv::Mat applyGeometricTransform(const cv::Mat &image, const GeometricTransform &transform) {
+        if (!transform.transpose) {
+            cv::Mat result(image.rows, image.cols, image.type());
+#pragma omp parallel for
+            for (int x = 0; x < image.rows; x++) {
+                const uchar *srcRow = image.ptr<uchar>(transform.flipRows ? image.rows - 1 - x : x);
+                uchar *dstRow = result.ptr<uchar>(x);
+                if (transform.flipCols) {
+                    std::reverse_copy(srcRow, srcRow + image.cols, dstRow);
+                } else {
+                    std::copy_n(srcRow, image.cols, dstRow);
+                }
+            }
+            return result;
+        }
+
+        const int rows = image.cols;
+        const int cols = image.rows;
+        cv::Mat result(rows, cols, image.type());
+        const int rowBlocks = (rows + TRANSPOSE_BLOCK_SIZE - 1) / TRANSPOSE_BLOCK_SIZE;
+        const int colBlocks = (cols + TRANSPOSE_BLOCK_SIZE - 1) / TRANSPOSE_BLOCK_SIZE;
+#pragma omp parallel for collapse(2)
+        for (int rowBlock = 0; rowBlock < rowBlocks; rowBlock++) {
+            for (int colBlock = 0; colBlock < colBlocks; colBlock++) {
+                const int rowEnd = std::min(rows, (rowBlock + 1) * TRANSPOSE_BLOCK_SIZE);
+                const int colEnd = std::min(cols, (colBlock + 1) * TRANSPOSE_BLOCK_SIZE);
+                for (int x = rowBlock * TRANSPOSE_BLOCK_SIZE; x < rowEnd; x++) {
+                    const int srcCol = transform.flipRows ? rows - 1 - x : x;
+                    uchar *dstRow = result.ptr<uchar>(x);
+                    for (int y = colBlock * TRANSPOSE_BLOCK_SIZE; y < colEnd; y++) {
+                        const int srcRow = transform.flipCols ? cols - 1 - y : y;
+                        dstRow[y] = image.ptr<uchar>(srcRow)[srcCol];
                     }
                 }
+            }
+        }
+        return result;
+    }
+
+    cv::Mat transpose(const cv::Mat &image) {
+        return applyGeometricTransform(image, {true, false, false});
+    }
+
+    cv::Mat rotate(const cv::Mat &image, const int degrees) {
+        return applyGeometricTransform(image, GeometricTransform::rotation(degrees));
+    }
+
+    cv::Mat flipHorizontally(const cv::Mat &image) {
+        return applyGeometricTransform(image, {false, false, true});
+    }
+
+    cv::Mat flipVertically(const cv::Mat &image) {
+        return applyGeometricTransform(image, {false, true, false});
+    }
 
-                int val = std::min(std::abs(convolutionValue), 255);
-                result.at<uchar>(x - 1, y - 1) = static_cast<uchar>(val);
+    cv::Mat flipDiagonally(const cv::Mat &image) {
+        return applyGeometricTransform(image, {false, true, true});
+    }
+
+    cv::Mat resize(cv::Mat image, const float factor, const InterpolationMethod method) {
+        if (factor <= 0) {
+            throw std::invalid_argument("Resize factor has to be positive");
+        }
+        const int newWidth = static_cast<int>(static_cast<float>(image.cols) * factor);
+        const int newHeight = static_cast<int>(static_cast<float>(image.rows) * factor);
+        cv::Mat newImage = cv::Mat::zeros(newHeight, newWidth, CV_8UC1);
+        if (newWidth == 0 || newHeight == 0) {
+            return newImage;
+        }
+
+        if (method == InterpolationMethod::NEAREST) {
+            std::vector<int> rowIndices(newHeight);
+            std::vector<int> colIndices(newWidth);
+            for (int x = 0; x < newHeight; x++) {
+                rowIndices[x] = std::min(image.rows - 1, static_cast<int>(static_cast<float>(x) / factor));
+            }
+            for (int y = 0; y < newWidth; y++) {
+                colIndices[y] = std::min(image.cols - 1, static_cast<int>(static_cast<float>(y) / factor));
             }
+#pragma omp parallel for
+            for (int x = 0; x < newHeight; x++) {
+                const uchar *srcRow = image.ptr<uchar>(rowIndices[x]);
+                uchar *dstRow = newImage.ptr<uchar>(x);
+                for (int y = 0; y < newWidth; y++) {
+                    dstRow[y] = srcRow[colIndices[y]];
+                }
+            }
+            return newImage;
         }
 
-        return result;
+        if (method == InterpolationMethod::AREA) {
+            return areaResize(image, newHeight, newWidth, factor);
+        }
+
+        const ResampleTable rowTable = buildResampleTable(image.rows, newHeight, factor, method);
+        const ResampleTable colTable = buildResampleTable(image.cols, newWidth, factor, method);
+
+        constexpr int horizontalShift = RESAMPLE_WEIGHT_BITS - RESAMPLE_INTERMEDIATE_BITS;
+        cv::Mat horizontal(image.rows, newWidth, CV_32SC1);
+#pragma omp parallel for
+        for (int x = 0; x < image.rows; x++) {
+            const uchar *srcRow = image.ptr<uchar>(x);
+            int *dstRow = horizontal.ptr<int>(x);
+            for (int y = 0; y < newWidth; y++) {
+                const int *indices = colTable.indices.data() + static_cast<size_t>(y) * colTable.taps;
+                const int *weights = colTable.weights.data() + static_cast<size_t>(y) * colTable.taps;
+                int sum = 1 << (horizontalShift - 1);
+                for (int t = 0; t < colTable.taps; t++) {
+                    sum += srcRow[indices[t]] * weights[t];
+                }
+                dstRow[y] = sum >> horizontalShift;
+            }
+        }
+
+        constexpr int verticalShift = RESAMPLE_WEIGHT_BITS + RESAMPLE_INTERMEDIATE_BITS;
+#pragma omp parallel
+        {
+            std::vector<int> sums(newWidth);
+#pragma omp for
+            for (int x = 0; x < newHeight; x++) {
+                std::fill(sums.begin(), sums.end(), 1 << (verticalShift - 1));
+                const int *indices = rowTable.indices.data() + static_cast<size_t>(x) * rowTable.taps;
+                const int *weights = rowTable.weights.data() + static_cast<size_t>(x) * rowTable.taps;
+                for (int t = 0; t < rowTable.taps; t++) {
+                    const int weight = weights[t];
+                    if (weight == 0) {
+                        continue;
+                    }
+                    const int *srcRow = horizontal.ptr<int>(indices[t]);
+#pragma omp simd
+                    for (int y = 0; y < newWidth; y++) {
+                        sums[y] += srcRow[y] * weight;
+                    }
+                }
+                uchar *dstRow = newImage.ptr<uchar>(x);
+                for (int y = 0; y < newWidth; y++) {
+                    dstRow[y] = static_cast<uchar>(std::clamp(sums[y] >> verticalShift, 0, UCHAR_MAX));
+                }
+            }
+        }
+        return newImage;
     }
 
-    cv::Mat optimizedLaplacianFilter(cv::Mat image) {
-        cv::Mat newImage = cv::Mat::zeros(image.size(), image.type());
+    cv::Mat minimumFilter(const cv::Mat &image, const int kernelSize) {
+        return slidingExtremum(image, kernelSize, UCHAR_MAX, MinimumPicker());
+    }
+
+    cv::Mat maximumFilter(const cv::Mat &image, const int kernelSize) {
+        return slidingExtremum(image, kernelSize, 0, MaximumPicker());
+    }
 
+    cv::Mat midpointFilter(cv::Mat image, const int kernelSize) {
+        const cv::Mat minImage = minimumFilter(image, kernelSize);
+        const cv::Mat maxImage = maximumFilter(image, kernelSize);
+        cv::Mat newImage(image.rows, image.cols, CV_8UC1);
+#pragma omp parallel for
         for (int x = 0; x < image.rows; x++) {
+            const uchar *minRow = minImage.ptr<uchar>(x);
+            const uchar *maxRow = maxImage.ptr<uchar>(x);
+            uchar *dstRow = newImage.ptr<uchar>(x);
             for (int y = 0; y < image.cols; y++) {
-               int convolutionValue = 0;
+                dstRow[y] = static_cast<uchar>((maxRow[y] + minRow[y]) / 2);
+            }
+        }
+        return newImage;
+    }
 
-                if (x - 1 >= 0)
-                    convolutionValue += image.at<uchar>(x - 1, y) * -1;
-                if (y - 1 >= 0)
-                    convolutionValue += image.at<uchar>(x, y - 1) * -1;
-                convolutionValue += image.at<uchar>(x, y) * 4;
-                if (y + 1 < image.cols)
-                    convolutionValue += image.at<uchar>(x, y + 1) * -1;
-                if (x + 1 < image.rows)
-                    convolutionValue += image.at<uchar>(x + 1, y) * -1;
+    cv::Mat arithmeticMeanFilter(cv::Mat image, const int kernelSize) {
+        if (kernelSize < 1) {
+            throw std::invalid_argument("Kernel size has to be a positive integer");
+        }
+        const int before = (kernelSize - 1) / 2;
+        const int after = kernelSize / 2;
+        const int rows = image.rows;
+        const int cols = image.cols;
 
-                int val = std::min(std::abs(convolutionValue), 255);
-                newImage.at<uchar>(x, y) = static_cast<uchar>(val);
+        // Horizontal pass: running sum over the window of every row, clipped to the image.
+        cv::Mat rowSums(rows, cols, CV_32SC1);
+#pragma omp parallel for
+        for (int x = 0; x < rows; x++) {
+            const uchar *srcRow = image.ptr<uchar>(x);
+            int *sumRow = rowSums.ptr<int>(x);
+            int sum = 0;
+            for (int y = 0; y < std::min(after, cols - 1) + 1; y++) {
+                sum += srcRow[y];
+            }
+            for (int y = 0; y < cols; y++) {
+                sumRow[y] = sum;
+                if (y + after + 1 < cols) {
+                    sum += srcRow[y + after + 1];
+                }
+                if (y - before >= 0) {
+                    sum -= srcRow[y - before];
+                }
             }
         }
 
+        std::vector<int> colCounts(cols);
+        for (int y = 0; y < cols; y++) {
+            colCounts[y] = std::min(cols - 1, y + after) - std::max(0, y - before) + 1;
+        }
+
+        // Vertical pass: every block of rows keeps a running sum of row sums for all columns at once.
+        cv::Mat newImage(rows, cols, CV_8UC1);
+        const int blockCount = std::max(1, std::min(rows, Threading::getThreadCount()));
+        const int blockSize = (rows + blockCount - 1) / blockCount;
+#pragma omp parallel for
+        for (int block = 0; block < blockCount; block++) {
+            const int firstRow = block * blockSize;
+            const int lastRow = std::min(rows, firstRow + blockSize);
+            if (firstRow >= lastRow) {
+                continue;
+            }
+            std::vector<int> colSums(cols, 0);
+            for (int x = std::max(0, firstRow - before); x <= std::min(rows - 1, firstRow + after); x++) {
+                const int *sumRow = rowSums.ptr<int>(x);
+                for (int y = 0; y < cols; y++) {
+                    colSums[y] += sumRow[y];
+                }
+            }
+            for (int x = firstRow; x < lastRow; x++) {
+                const int rowCount = std::min(rows - 1, x + after) - std::max(0, x - before) + 1;
+                uchar *dstRow = newImage.ptr<uchar>(x);
+                for (int y = 0; y < cols; y++) {
+                    dstRow[y] = static_cast<uchar>(colSums[y] / (rowCount * colCounts[y]));
+                }
+                if (x + after + 1 < rows) {
+                    const int *enteringRow = rowSums.ptr<int>(x + after + 1);
+                    for (int y = 0; y < cols; y++) {
+                        colSums[y] += enteringRow[y];
+                    }
+                }
+                if (x - before >= 0) {
+                    const int *leavingRow = rowSums.ptr<int>(x - before);
+                    for (int y = 0; y < cols; y++) {
+                        colSums[y] -= leavingRow[y];
+                    }
+                }
+            }
+        }
         return newImage;
     }
 
-    cv::Mat robertsOperator1(cv::Mat image) {
-        cv::Mat result = image.clone();
 
-        for (int x = 0; x < image.rows - 1; x++) {
-            for (int y = 0; y < image.cols - 1; y++) {
-                int current = image.at<uchar>(x, y);
-                int diag = image.at<uchar>(x + 1, y + 1);
-                int right = image.at<uchar>(x, y + 1);
-                int below = image.at<uchar>(x + 1, y);
+    cv::Mat padImageGrayscale(const cv::Mat &image, const int padValue) {
+        cv::Mat paddedImage = cv::Mat::zeros(image.rows + padValue * 2, image.cols + padValue * 2, CV_8UC1);
+        for (int x = 0; x < image.rows; x++) {
+            for (int y = 0; y < image.cols; y++) {
+                paddedImage.at<uchar>(x + padValue, y + padValue) = image.at<uchar>(x, y);
+            }
+        }
+        return paddedImage;
+    }
 
-                int diff1 = current - diag;
-                int diff2 = right - below;
+    cv::Mat convolve(const cv::Mat &image, const cv::Mat &kernel, const BorderType borderType) {
+        if (kernel.empty() || kernel.type() != CV_64FC1) {
+            throw std::invalid_argument("Kernel has to be a non-empty CV_64FC1 matrix");
+        }
+        const int anchorRow = kernel.rows / 2;
+        const int anchorCol = kernel.cols / 2;
+        const cv::Mat padded = padImageDouble(image, kernel.rows - 1 - anchorRow, anchorRow,
+                                              kernel.cols - 1 - anchorCol, anchorCol, borderType);
 
-                int val = static_cast<int>(std::round(std::sqrt(std::pow(diff1, 2) + std::pow(diff2, 2))));
-                int magnitude = std::clamp(val, 0, 255);
-                result.at<uchar>(x, y) = magnitude;
-            }
+        std::vector<double> column;
+        std::vector<double> row;
+        if (separateKernel(kernel, column, row)) {
+            std::reverse(column.begin(), column.end());
+            std::reverse(row.begin(), row.end());
+            return saturateToUchar(correlateCols(correlateRows(padded, row), column));
         }
 
-        return result;
+        const double directCost = static_cast<double>(image.total()) * kernel.rows * kernel.cols;
+        const double fftSize = static_cast<double>(nextPowerOfTwo(padded.rows)) * nextPowerOfTwo(padded.cols);
+        if (const double fftCost = 3 * FFT_BUTTERFLY_COST * fftSize * std::log2(fftSize); fftCost < directCost) {
+            return saturateToUchar(convolveFrequency(padded, kernel));
+        }
+
+        cv::Mat flipped(kernel.rows, kernel.cols, CV_64FC1);
+        for (int i = 0; i < kernel.rows; i++) {
+            for (int j = 0; j < kernel.cols; j++) {
+                flipped.at<double>(i, j) = kernel.at<double>(kernel.rows - 1 - i, kernel.cols - 1 - j);
+            }
+        }
+        return saturateToUchar(correlateDirect(padded, flipped));
     }
 
-    template<typename TPixel>
-    cv::Mat regionGrowing(cv::Mat image, const int criterion) {
-        cv::Mat imageSegmentationMasks = cv::Mat::zeros(image.rows, image.cols, CV_8UC1);
-        const int seedXGridSpacing = image.rows / 10;
-        const int seedYGridSpacing = image.cols / 10;
-        int currentMask = 0;
-        constexpr std::array<std::array<int, 2>, 4> dirs = {{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+    cv::Mat parseKernel(std::istream &stream) {
+        std::vector<std::vector<double> > rows;
+        std::string line;
+        while (std::getline(stream, line)) {
+            std::istringstream lineStream(line);
+            std::vector<double> values;
+            double value;
+            while (lineStream >> value) {
+                values.push_back(value);
+            }
+            if (!lineStream.eof()) {
+                throw std::invalid_argument("Kernel contains a value which is not a number");
+            }
+            if (values.empty()) {
+                continue;
+            }
+            if (!rows.empty() && values.size() != rows.front().size()) {
+                throw std::invalid_argument("All kernel rows have to be of the same length");
+            }
+            rows.push_back(std::move(values));
+        }
+        if (rows.empty()) {
+            throw std::invalid_argument("Kernel is empty");
+        }
 
-        for (int seedX = seedXGridSpacing; seedX < image.rows - seedXGridSpacing; seedX += seedXGridSpacing) {
-            for (int seedY = seedYGridSpacing; seedY < image.cols - seedYGridSpacing; seedY += seedYGridSpacing) {
-                if (imageSegmentationMasks.at<uchar>(seedX, seedY) == 0) {
-                    currentMask++;
-                    imageSegmentationMasks.at<uchar>(seedX, seedY) = currentMask;
-                    TPixel seedPixel = image.at<TPixel>(seedX, seedY);
-                    double regionSum = getIntensity(seedPixel);
-                    int regionCount = 1;
-                    double regionMean = regionSum / regionCount;
-                    std::queue<std::pair<int, int> > queue;
-                    queue.emplace(seedX, seedY);
-
-                    while (!queue.empty()) {
-                        auto [fst, snd] = queue.front();
-                        queue.pop();
-                        const int currentX = fst;
-                        const int currentY = snd;
-
-                        for (auto &dir: dirs) {
-                            int newX = currentX + dir[0];
-                            if (int newY = currentY + dir[1];
-                                newX >= 0 && newX < image.rows && newY >= 0 && newY < image.cols &&
-                                imageSegmentationMasks.at<uchar>(newX, newY) == 0) {
-                                constexpr double thresholdMean = 20;
-                                constexpr double thresholdK = 0.1;
-
-                                TPixel newPixel = image.at<TPixel>(newX, newY);
-                                const double newPixelIntensity = getIntensity(newPixel);
-                                bool conditionMet = false;
-
-                                switch (criterion) {
-                                    case 0:
-                                        conditionMet =
-                                                std::abs(regionMean - newPixelIntensity) <= regionMean * thresholdK;
-                                        break;
-                                    case 1:
-                                        conditionMet = std::abs(regionMean - newPixelIntensity) <= thresholdMean;
-                                        break;
-                                    case 2: {
-                                        constexpr double thresholdAbs = 20;
-                                        const double seedIntensity = getIntensity(seedPixel);
-                                        conditionMet = std::abs(seedIntensity - newPixelIntensity) <= thresholdAbs;
-                                        break;
-                                    }
-                                    default:
-                                        break;
-                                }
-
-                                if (conditionMet) {
-                                    imageSegmentationMasks.at<uchar>(newX, newY) = currentMask;
-                                    queue.emplace(newX, newY);
-                                    regionSum += newPixelIntensity;
-                                    regionCount++;
-                                    regionMean = regionSum / regionCount;
-                                }
-                            }
-                        }
-                    }
-                }
+        cv::Mat kernel(static_cast<int>(rows.size()), static_cast<int>(rows.front().size()), CV_64FC1);
+        for (int i = 0; i < kernel.rows; i++) {
+            for (int j = 0; j < kernel.cols; j++) {
+                kernel.at<double>(i, j) = rows[i][j];
             }
         }
+        return kernel;
+    }
+
+    cv::Mat laplacianFilter(const cv::Mat &image, const int laplaceMask) {
+        switch (laplaceMask) {
+            case 0:
+                return applyStencil<StencilKernels::StencilType::LAPLACIAN_0>(image);
+            case 1:
+                return applyStencil<StencilKernels::StencilType::LAPLACIAN_1>(image);
+            case 2:
+                return applyStencil<StencilKernels::StencilType::LAPLACIAN_2>(image);
+            default:
+                throw std::invalid_argument("Invalid laplaceMask value");
+        }
+    }
+
+    cv::Mat optimizedLaplacianFilter(cv::Mat image) {
+        return applyStencil<StencilKernels::StencilType::LAPLACIAN_0>(image);
+    }
 
-        return imageSegmentationMasks;
+    cv::Mat robertsOperator1(cv::Mat image) {
+        return applyStencil<StencilKernels::StencilType::ROBERTS_CROSS>(image);
+    }
+
+    template<typename TPixel>
+    cv::Mat regionGrowing(cv::Mat image, const int criterion) {
+        switch (criterion) {
+            case 0:
+                return growRegions<TPixel>(image, AdaptiveMeanCriterion());
+            case 1:
+                return growRegions<TPixel>(image, FixedMeanCriterion());
+            case 2:
+                return growRegions<TPixel>(image, SeedDistanceCriterion());
+            default:
+                throw std::invalid_argument("Region growing criterion has to be 0, 1 or 2");
+        }
     }
 
     std::vector<cv::Vec3b> createColorMap() {
         std::vector colorMap(256, cv::Vec3b(0, 0, 0));
         for (int i = 1; i <= 255; ++i) {
             const int hue = i * 179 / 255;
-            cv::Mat hsv(1, 1, CV_8UC3, cv::Scalar(hue, 255));
+            cv::Mat hsv(1, 1, CV_8UC3, cv::Scalar(hue, 255, 255));
             cv::Mat rgb;
             cvtColor(hsv, rgb, cv::COLOR_HSV2BGR);
             colorMap[i] = rgb.at<cv::Vec3b>(0, 0);
@@ -384,12 +1546,21 @@ namespace SpatialDomainProcessor {
 
     cv::Mat applyColorMap(const cv::Mat &grayscaleMask,
                                                   const std::vector<cv::Vec3b> &colorMap) {
+        if (colorMap.size() < 2) {
+            throw std::invalid_argument("Color map has to contain the background and at least one other color");
+        }
         cv::Mat colorMask(grayscaleMask.size(), CV_8UC3);
-#pragma omp parallel for collapse(2)
+        const bool isLabelMap = grayscaleMask.type() == CV_32SC1;
+        const int colorCount = static_cast<int>(colorMap.size());
+#pragma omp parallel for
         for (int x = 0; x < grayscaleMask.rows; ++x) {
+            auto *colorRow = colorMask.ptr<cv::Vec3b>(x);
             for (int y = 0; y < grayscaleMask.cols; ++y) {
-                const int grayValue = grayscaleMask.at<uchar>(x, y);
-                colorMask.at<cv::Vec3b>(x, y) = colorMap[grayValue];
+                int value = isLabelMap ? grayscaleMask.ptr<int>(x)[y] : grayscaleMask.ptr<uchar>(x)[y];
+                if (value >= colorCount) {
+                    value = 1 + (value - 1) % (colorCount - 1);
+                }
+                colorRow[y] = colorMap[value];
             }
         }
         return colorMask;
@@ -0,0 +1,113 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#include "../../include/image-processing-lib/StencilRowKernels.h"
+
+#ifdef __SSE4_1__
+#include <immintrin.h>
+
+namespace {
+    // Eight 16-bit lanes, a row kernel step covers 16 pixels
+    constexpr int LANES = 8;
+
+    __m128i load(const unsigned char *pixels) {
+        return _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(pixels)));
+    }
+
+    template<int Coefficient>
+    __m128i accumulate(const __m128i sum, const unsigned char *pixels) {
+        if constexpr (Coefficient == 0) {
+            return sum;
+        } else if constexpr (Coefficient == 1) {
+            return _mm_add_epi16(sum, load(pixels));
+        } else if constexpr (Coefficient == -1) {
+            return _mm_sub_epi16(sum, load(pixels));
+        } else {
+            return _mm_add_epi16(sum, _mm_mullo_epi16(load(pixels), _mm_set1_epi16(Coefficient)));
+        }
+    }
+
+    template<StencilKernels::StencilMask Mask>
+    __m128i maskStencil(const unsigned char *above, const unsigned char *row, const unsigned char *below) {
+        __m128i sum = _mm_setzero_si128();
+        sum = accumulate<Mask[0][0]>(sum, above - 1);
+        sum = accumulate<Mask[0][1]>(sum, above);
+        sum = accumulate<Mask[0][2]>(sum, above + 1);
+        sum = accumulate<Mask[1][0]>(sum, row - 1);
+        sum = accumulate<Mask[1][1]>(sum, row);
+        sum = accumulate<Mask[1][2]>(sum, row + 1);
+        sum = accumulate<Mask[2][0]>(sum, below - 1);
+        sum = accumulate<Mask[2][1]>(sum, below);
+        sum = accumulate<Mask[2][2]>(sum, below + 1);
+        return _mm_abs_epi16(sum);
+    }
+
+    __m128i robertsStencil(const unsigned char *, const unsigned char *row, const unsigned char *below) {
+        const __m128i first = _mm_sub_epi16(load(row), load(below + 1));
+        const __m128i second = _mm_sub_epi16(load(row + 1), load(below));
+        // madd of interleaved (first, second) pairs with themselves gives first^2 + second^2 in 32 bits
+        const __m128i low = _mm_unpacklo_epi16(first, second);
+        const __m128i high = _mm_unpackhi_epi16(first, second);
+        const __m128i lowRoot = _mm_cvtps_epi32(_mm_sqrt_ps(_mm_cvtepi32_ps(_mm_madd_epi16(low, low))));
+        const __m128i highRoot = _mm_cvtps_epi32(_mm_sqrt_ps(_mm_cvtepi32_ps(_mm_madd_epi16(high, high))));
+        return _mm_packs_epi32(lowRoot, highRoot);
+    }
+
+    void store(unsigned char *result, const __m128i low, const __m128i high) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(result), _mm_packus_epi16(low, high));
+    }
+
+    using Evaluate = __m128i (*)(const unsigned char *, const unsigned char *, const unsigned char *);
+
+    /**
+     * Evaluate a stencil over a part of a row. The tail shorter than a step goes through the same vector code
+     * on zero-padded copies of the rows.
+     */
+    template<Evaluate Stencil>
+    void stencilRow(const unsigned char *above, const unsigned char *row, const unsigned char *below,
+                    unsigned char *result, const int begin, const int end) {
+        int y = begin;
+        for (; y + 2 * LANES <= end; y += 2 * LANES) {
+            store(result + y, Stencil(above + y, row + y, below + y),
+                  Stencil(above + y + LANES, row + y + LANES, below + y + LANES));
+        }
+        if (y == end) {
+            return;
+        }
+
+        // The stencils read one pixel to the left (except at the start of the row) and one to the right
+        unsigned char padded[3][2 * LANES + 2] = {};
+        unsigned char tail[2 * LANES];
+        const int count = end - y;
+        for (int i = y > 0 ? -1 : 0; i <= count; i++) {
+            padded[0][i + 1] = above[y + i];
+            padded[1][i + 1] = row[y + i];
+            padded[2][i + 1] = below[y + i];
+        }
+        store(tail, Stencil(padded[0] + 1, padded[1] + 1, padded[2] + 1),
+              Stencil(padded[0] + 1 + LANES, padded[1] + 1 + LANES, padded[2] + 1 + LANES));
+        for (int i = 0; i < count; i++) {
+            result[y + i] = tail[i];
+        }
+    }
+}
+#endif
+
+namespace StencilKernels {
+    RowFunction sse4RowFunction([[maybe_unused]] const StencilType type) {
+#ifdef __SSE4_1__
+        switch (type) {
+            case StencilType::LAPLACIAN_0:
+                return &stencilRow<&maskStencil<LAPLACIAN_MASKS[0]> >;
+            case StencilType::LAPLACIAN_1:
+                return &stencilRow<&maskStencil<LAPLACIAN_MASKS[1]> >;
+            case StencilType::LAPLACIAN_2:
+                return &stencilRow<&maskStencil<LAPLACIAN_MASKS[2]> >;
+            case StencilType::ROBERTS_CROSS:
+                return &stencilRow<&robertsStencil>;
+        }
+#endif
+        return nullptr;
+    }
+}
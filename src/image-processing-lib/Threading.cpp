@@ -0,0 +1,29 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#include "../../include/image-processing-lib/Threading.h"
+
+#include <stdexcept>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Threading {
+    void setThreadCount(const int threadCount) {
+        if (threadCount < 1) {
+            throw std::invalid_argument("Thread count has to be a positive integer");
+        }
+#ifdef _OPENMP
+        omp_set_num_threads(threadCount);
+#endif
+    }
+
+    int getThreadCount() {
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+}
@@ -4,6 +4,8 @@
 
 #include "../include/input-processing-lib/CommandParser.h"
 
+#include <sstream>
+
 #include "input-processing-lib/CommandMapping.h"
 
 template<typename T>
@@ -30,6 +32,29 @@ bool CommandParser::readParam(const std::string &arg, const std::string &prefix,
     }
 }
 
+void CommandParser::readFilterShape(const int argc, char **argv, int &i, FilterShapeOptions &result) {
+    if (i + 1 < argc && std::string(argv[i + 1]).starts_with("-shape=")) {
+        std::optional<std::string> shapeName;
+        readParam(argv[++i], "-shape=", shapeName, "Invalid filter shape format.");
+        if (shapeName.has_value()) {
+            if (auto it = filterShapeMap.find(shapeName.value()); it != filterShapeMap.end()) {
+                result.shape = it->second;
+            } else {
+                std::cerr << "Unknown filter shape: " << shapeName.value() << std::endl;
+            }
+        }
+    }
+    if (i + 1 < argc && std::string(argv[i + 1]).starts_with("-order=")) {
+        std::optional<int> order;
+        readParam(argv[++i], "-order=", order, "Filter order must be an integer.");
+        if (order.has_value() && order.value() < 1) {
+            std::cerr << "Filter order must be a positive integer." << std::endl;
+        } else if (order.has_value()) {
+            result.order = order.value();
+        }
+    }
+}
+
 CommandOptions CommandParser::parse(const int argc, char **argv) {
     CommandOptions commandOptions;
     for (int i = 1; i < argc; i++) {
@@ -82,10 +107,32 @@ CommandOptions CommandParser::parse(const int argc, char **argv) {
                 commandOptions.isDiagonalFlip = true;
                 break;
 
+            case CommandType::TRANSPOSE:
+                commandOptions.isTranspose = true;
+                break;
+
+            case CommandType::ROTATE:
+                if (++i < argc)
+                    readParam(argv[i], "-val=", commandOptions.rotationAngle,
+                              "Rotation angle must be an integer multiple of 90.");
+                break;
+
             case CommandType::RESIZE:
                 if (++i < argc)
                     readParam(argv[i], "-val=", commandOptions.resizeModVal,
                               "Shrink scale factor must be a float between 0 and 1.");
+                if (i + 1 < argc && std::string(argv[i + 1]).starts_with("-method=")) {
+                    std::optional<std::string> methodName;
+                    readParam(argv[++i], "-method=", methodName, "Invalid resize method format.");
+                    if (methodName.has_value()) {
+                        if (auto it = interpolationMethodMap.find(methodName.value());
+                            it != interpolationMethodMap.end()) {
+                            commandOptions.resizeMethod = it->second;
+                        } else {
+                            std::cerr << "Unknown resize method: " << methodName.value() << std::endl;
+                        }
+                    }
+                }
                 break;
 
             case CommandType::MIDPOINT_FILTER:
@@ -100,6 +147,12 @@ CommandOptions CommandParser::parse(const int argc, char **argv) {
                               "Arithmetic mean filter kernel size must be an integer.");
                 break;
 
+            case CommandType::CONVOLVE:
+                if (++i < argc)
+                    readParam(argv[i], "-kernel=", commandOptions.convolutionKernelPath,
+                              "Invalid kernel file path format.");
+                break;
+
             case CommandType::COMPARE_IMAGES:
                 commandOptions.isCompareImages = true;
                 break;
@@ -185,6 +238,10 @@ CommandOptions CommandParser::parse(const int argc, char **argv) {
                 }
                 break;
 
+            case CommandType::CONNECTED_COMPONENTS:
+                commandOptions.isConnectedComponents = true;
+                break;
+
             case CommandType::REGION_GROWING:
                 if (++i < argc) {
                     readParam(argv[i], "-criterion=", commandOptions.regionGrowing,
@@ -201,42 +258,67 @@ CommandOptions CommandParser::parse(const int argc, char **argv) {
                 break;
 
             case CommandType::FFT_LOW_PASS:
-                commandOptions.isFastFourierTransform = true;
                 if (++i < argc) {
                     readParam(argv[i], "-bandValue=", commandOptions.lowPassBandSize, "Band value must be an integer.");
                 }
+                readFilterShape(argc, argv, i, commandOptions.lowPassShape);
                 break;
 
             case CommandType::FFT_HIGH_PASS:
-                commandOptions.isFastFourierTransform = true;
                 if (++i < argc) {
                     readParam(argv[i], "-bandValue=", commandOptions.highPassBandSize,
                               "Band value must be an integer.");
                 }
+                readFilterShape(argc, argv, i, commandOptions.highPassShape);
                 break;
 
             case CommandType::FFT_BAND_PASS:
-                commandOptions.isFastFourierTransform = true;
                 if (++i < argc) {
                     readParam(argv[i], "-lowCut=", commandOptions.lowCut, "Band value must be an integer.");
                 }
                 if (++i < argc) {
                     readParam(argv[i], "-highCut=", commandOptions.highCut, "Band value must be an integer.");
                 }
+                readFilterShape(argc, argv, i, commandOptions.bandPassShape);
                 break;
 
             case CommandType::FFT_BAND_CUT:
-                commandOptions.isFastFourierTransform = true;
                 if (++i < argc) {
                     readParam(argv[i], "-lowPass=", commandOptions.lowPass, "Band value must be an integer.");
                 }
                 if (++i < argc) {
                     readParam(argv[i], "-highPass=", commandOptions.highPass, "Band value must be an integer.");
                 }
+                readFilterShape(argc, argv, i, commandOptions.bandCutShape);
+                break;
+
+            case CommandType::FFT_HIGH_PASS_DIRECTION:
+                if (++i < argc) {
+                    readParam(argv[i], "-bandValue=", commandOptions.highPassDirectionBandSize,
+                              "Band value must be an integer.");
+                }
+                if (++i < argc) {
+                    std::optional<std::string> angles;
+                    readParam(argv[i], "-angles=", angles, "Invalid angle list format.");
+                    std::stringstream ss(angles.value_or(""));
+                    for (std::string angle; std::getline(ss, angle, ',');) {
+                        std::optional<float> value;
+                        if (readParam(angle, "", value, "Angle must be a float.")) {
+                            commandOptions.highPassDirectionAngles.push_back(value.value());
+                        }
+                    }
+                }
+                if (i + 1 < argc && std::string(argv[i + 1]).starts_with("-width=")) {
+                    std::optional<float> width;
+                    readParam(argv[++i], "-width=", width, "Angular width must be a float.");
+                    if (width.has_value()) {
+                        commandOptions.highPassDirectionWidth = width.value();
+                    }
+                }
+                readFilterShape(argc, argv, i, commandOptions.highPassDirectionShape);
                 break;
 
             case CommandType::FFT_PHASE_MODIFYING:
-                commandOptions.isFastFourierTransform = true;
                 if (++i < argc) {
                     readParam(argv[i], "-k=", commandOptions.taskF6k, "K must be an integer.");
                 }
@@ -245,6 +327,64 @@ CommandOptions CommandParser::parse(const int argc, char **argv) {
                 }
                 break;
 
+            case CommandType::TRANSLATE:
+                if (++i < argc) {
+                    readParam(argv[i], "-dx=", commandOptions.translateX, "Horizontal offset must be a float.");
+                }
+                if (++i < argc) {
+                    readParam(argv[i], "-dy=", commandOptions.translateY, "Vertical offset must be a float.");
+                }
+                break;
+
+            case CommandType::FFT_PRECISION:
+                if (++i < argc) {
+                    std::optional<std::string> precisionName;
+                    readParam(argv[i], "-val=", precisionName, "Invalid FFT precision format.");
+                    if (precisionName.has_value()) {
+                        if (auto it = fftPrecisionMap.find(precisionName.value()); it != fftPrecisionMap.end()) {
+                            commandOptions.fftPrecision = it->second;
+                        } else {
+                            std::cerr << "Unknown FFT precision: " << precisionName.value() << std::endl;
+                        }
+                    }
+                }
+                break;
+
+            case CommandType::FFT_TILED:
+                if (++i < argc) {
+                    readParam(argv[i], "-tile=", commandOptions.fftTileSize, "Tile size must be an integer.");
+                }
+                if (++i < argc) {
+                    readParam(argv[i], "-radius=", commandOptions.fftKernelRadius,
+                              "Kernel radius must be an integer.");
+                }
+                break;
+
+            case CommandType::MATCH_TEMPLATE:
+                if (++i < argc) {
+                    readParam(argv[i], "-template=", commandOptions.templatePath,
+                              "Invalid template file path format.");
+                }
+                if (i + 1 < argc && std::string(argv[i + 1]).starts_with("-count=")) {
+                    std::optional<int> matchCount;
+                    readParam(argv[++i], "-count=", matchCount, "Match count must be an integer.");
+                    if (matchCount.has_value()) {
+                        commandOptions.templateMatchCount = matchCount.value();
+                    }
+                }
+                if (i + 1 < argc && std::string(argv[i + 1]) == "-map") {
+                    i++;
+                    commandOptions.isTemplateResponseMap = true;
+                }
+                break;
+
+            case CommandType::THREADS:
+                if (++i < argc) {
+                    readParam(argv[i], "-val=", commandOptions.threadCount,
+                              "Thread count must be a positive integer.");
+                }
+                break;
+
 
             case CommandType::UNKNOWN:
             default:
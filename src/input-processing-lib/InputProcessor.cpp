@@ -4,6 +4,7 @@
 
 #include "../../include/input-processing-lib/InputProcessor.h"
 
+#include "image-processing-lib/Threading.h"
 
 #include "operations/channel-operations/ArithmeticMeanFilterOperation.h"
 #include "operations/channel-operations/BandCutOperation.h"
@@ -11,11 +12,17 @@
 #include "operations/channel-operations/BrightnessOperation.h"
 #include "operations/channel-operations/ContrastGammaOperation.h"
 #include "operations/channel-operations/ContrastLinearOperation.h"
+#include "operations/channel-operations/ConvolveOperation.h"
 #include "operations/channel-operations/FastFourierOperation.h"
 #include "operations/channel-operations/FlipDiagonallyOperation.h"
 #include "operations/channel-operations/FlipHorizontallyOperation.h"
 #include "operations/channel-operations/FlipVerticallyOperation.h"
 #include "operations/channel-operations/FourierOperation.h"
+#include "operations/channel-operations/FusedGeometricOperation.h"
+#include "operations/channel-operations/FusedPointOperation.h"
+#include "operations/channel-operations/FusedSpectralOperation.h"
+#include "operations/channel-operations/HighPassDirectionOperation.h"
+#include "operations/channel-operations/HighPassDirectionsOperation.h"
 #include "operations/channel-operations/HighPassOperation.h"
 #include "operations/channel-operations/HistogramEqualizationOperation.h"
 #include "operations/channel-operations/LowPassOperation.h"
@@ -23,13 +30,19 @@
 #include "operations/channel-operations/NegativeOperation.h"
 #include "operations/channel-operations/PhaseShiftOperation.h"
 #include "operations/channel-operations/ResizeOperation.h"
+#include "operations/channel-operations/RotateOperation.h"
+#include "operations/channel-operations/TiledFilterOperation.h"
+#include "operations/channel-operations/TranslateOperation.h"
+#include "operations/channel-operations/TransposeOperation.h"
 #include "input-processing-lib/CommandMapping.h"
 #include "operations/whole-image-operations/ClosingOperation.h"
 #include "operations/whole-image-operations/CompareImageStatsOperation.h"
+#include "operations/whole-image-operations/ConnectedComponentsOperation.h"
 #include "operations/whole-image-operations/DilationOperation.h"
 #include "operations/whole-image-operations/HistogramStatsOperation.h"
 #include "operations/whole-image-operations/HistogramVisualizationOperation.h"
 #include "operations/whole-image-operations/HMTOperation.h"
+#include "operations/whole-image-operations/MatchTemplateOperation.h"
 #include "../../include/operations/channel-operations/LaplacianFilterOperation.h"
 #include "operations/whole-image-operations/OpeningOperation.h"
 #include "../../include/operations/channel-operations/OptimizedLaplacianFilterOperation.h"
@@ -44,11 +57,15 @@ void InputProcessor::setupChannelProcessingPipeline() {
     }
     if (options_.lowPass.has_value() && options_.highPass.has_value()) {
         channelOperations_.emplace_back(
-            std::make_unique<BandCutOperation>(options_.lowPass.value(), options_.highPass.value()));
+            std::make_unique<BandCutOperation>(options_.lowPass.value(), options_.highPass.value(),
+                                               options_.bandCutShape.shape, options_.bandCutShape.order,
+                                               options_.fftPrecision));
     }
     if (options_.lowCut.has_value() && options_.highCut.has_value()) {
         channelOperations_.emplace_back(
-            std::make_unique<BandPassOperation>(options_.lowCut.value(), options_.highCut.value()));
+            std::make_unique<BandPassOperation>(options_.lowCut.value(), options_.highCut.value(),
+                                                options_.bandPassShape.shape, options_.bandPassShape.order,
+                                                options_.fftPrecision));
     }
     if (options_.brightnessModVal.has_value()) {
         channelOperations_.emplace_back(
@@ -62,9 +79,15 @@ void InputProcessor::setupChannelProcessingPipeline() {
         channelOperations_.emplace_back(
             std::make_unique<ContrastLinearOperation>(options_.contrastLinearModVal.value()));
     }
-    if (options_.isFastFourierTransform) {
+    if (options_.convolutionKernelPath.has_value()) {
         channelOperations_.emplace_back(
-            std::make_unique<FastFourierOperation>());
+            std::make_unique<ConvolveOperation>(options_.convolutionKernelPath.value()));
+    }
+    // The tiled filters never hold the spectrum of the whole image
+    if (options_.isFastFourierTransform
+        && !(options_.fftTileSize.has_value() && options_.fftKernelRadius.has_value())) {
+        channelOperations_.emplace_back(
+            std::make_unique<FastFourierOperation>(options_.fftPrecision));
     }
     if (options_.isDiagonalFlip) {
         channelOperations_.emplace_back(
@@ -78,13 +101,39 @@ void InputProcessor::setupChannelProcessingPipeline() {
         channelOperations_.emplace_back(
             std::make_unique<FlipVerticallyOperation>());
     }
+    if (options_.isTranspose) {
+        channelOperations_.emplace_back(
+            std::make_unique<TransposeOperation>());
+    }
+    if (options_.rotationAngle.has_value()) {
+        channelOperations_.emplace_back(
+            std::make_unique<RotateOperation>(options_.rotationAngle.value()));
+    }
     if (options_.isFourierTransform) {
         channelOperations_.emplace_back(
             std::make_unique<FourierOperation>());
     }
     if (options_.highPassBandSize.has_value()) {
         channelOperations_.emplace_back(
-            std::make_unique<HighPassOperation>(options_.highPassBandSize.value()));
+            std::make_unique<HighPassOperation>(options_.highPassBandSize.value(), options_.highPassShape.shape,
+                                                options_.highPassShape.order, options_.fftPrecision));
+    }
+    if (options_.highPassDirectionBandSize.has_value() && options_.highPassDirectionAngles.size() == 1) {
+        channelOperations_.emplace_back(
+            std::make_unique<HighPassDirectionOperation>(options_.highPassDirectionBandSize.value(),
+                                                         options_.highPassDirectionAngles.front(),
+                                                         options_.highPassDirectionWidth,
+                                                         options_.highPassDirectionShape.shape,
+                                                         options_.highPassDirectionShape.order,
+                                                         options_.fftPrecision));
+    } else if (options_.highPassDirectionBandSize.has_value() && !options_.highPassDirectionAngles.empty()) {
+        channelOperations_.emplace_back(
+            std::make_unique<HighPassDirectionsOperation>(options_.highPassDirectionBandSize.value(),
+                                                          options_.highPassDirectionAngles,
+                                                          options_.highPassDirectionWidth,
+                                                          options_.highPassDirectionShape.shape,
+                                                          options_.highPassDirectionShape.order,
+                                                          options_.fftPrecision));
     }
     if (options_.histogramUniformGMin.has_value() && options_.histogramUniformGMax.has_value()) {
         channelOperations_.emplace_back(
@@ -92,7 +141,8 @@ void InputProcessor::setupChannelProcessingPipeline() {
     }
     if (options_.lowPassBandSize.has_value()) {
         channelOperations_.emplace_back(
-            std::make_unique<LowPassOperation>(options_.lowPassBandSize.value()));
+            std::make_unique<LowPassOperation>(options_.lowPassBandSize.value(), options_.lowPassShape.shape,
+                                               options_.lowPassShape.order, options_.fftPrecision));
     }
     if (options_.midpointKernelSize.has_value()) {
         channelOperations_.emplace_back(
@@ -104,11 +154,17 @@ void InputProcessor::setupChannelProcessingPipeline() {
     }
     if (options_.taskF6k.has_value() && options_.taskF6l.has_value()) {
         channelOperations_.emplace_back(
-            std::make_unique<PhaseShiftOperation>(options_.taskF6k.value(), options_.taskF6l.value()));
+            std::make_unique<PhaseShiftOperation>(options_.taskF6k.value(), options_.taskF6l.value(),
+                                                  options_.fftPrecision));
+    }
+    if (options_.translateX.has_value() && options_.translateY.has_value()) {
+        channelOperations_.emplace_back(
+            std::make_unique<TranslateOperation>(options_.translateY.value(), options_.translateX.value(),
+                                                 options_.fftPrecision));
     }
     if (options_.resizeModVal.has_value()) {
         channelOperations_.emplace_back(
-            std::make_unique<ResizeOperation>(options_.resizeModVal.value()));
+            std::make_unique<ResizeOperation>(options_.resizeModVal.value(), options_.resizeMethod));
     }
     if (options_.laplaceMask.has_value()) {
         channelOperations_.emplace_back(
@@ -124,6 +180,69 @@ void InputProcessor::setupChannelProcessingPipeline() {
     }
 }
 
+void InputProcessor::fusePointOperations() {
+    std::vector<std::unique_ptr<ImageOperation>> fusedOperations;
+    std::vector<std::unique_ptr<PointOperation>> pointOperations;
+    auto flushPointOperations = [&] {
+        if (pointOperations.size() == 1) {
+            fusedOperations.emplace_back(std::move(pointOperations.front()));
+        } else if (pointOperations.size() > 1) {
+            fusedOperations.emplace_back(std::make_unique<FusedPointOperation>(std::move(pointOperations)));
+        }
+        pointOperations.clear();
+    };
+
+    for (auto &op : channelOperations_) {
+        if (dynamic_cast<PointOperation *>(op.get()) != nullptr) {
+            pointOperations.emplace_back(static_cast<PointOperation *>(op.release()));
+        } else {
+            flushPointOperations();
+            fusedOperations.emplace_back(std::move(op));
+        }
+    }
+    flushPointOperations();
+    channelOperations_ = std::move(fusedOperations);
+}
+
+void InputProcessor::fuseGeometricOperations() {
+    std::vector<std::unique_ptr<ImageOperation>> fusedOperations;
+    std::optional<SpatialDomainProcessor::GeometricTransform> transform;
+    auto flushTransform = [&] {
+        if (transform.has_value() && !transform->isIdentity()) {
+            fusedOperations.emplace_back(std::make_unique<FusedGeometricOperation>(transform.value()));
+        }
+        transform.reset();
+    };
+
+    for (auto &op : channelOperations_) {
+        if (const auto *geometricOp = dynamic_cast<GeometricOperation *>(op.get()); geometricOp != nullptr) {
+            transform = transform.value_or(SpatialDomainProcessor::GeometricTransform{}).then(
+                geometricOp->transform());
+        } else {
+            flushTransform();
+            fusedOperations.emplace_back(std::move(op));
+        }
+    }
+    flushTransform();
+    channelOperations_ = std::move(fusedOperations);
+}
+
+void InputProcessor::fuseSpectralOperations() {
+    // Tiled filters replace the spectral filters before fusing, so they also end the runs they are part of
+    if (options_.fftTileSize.has_value() && options_.fftKernelRadius.has_value()) {
+        for (auto &op : channelOperations_) {
+            const auto *spectralOperation = dynamic_cast<SpectralOperation *>(op.get());
+            if (spectralOperation != nullptr && spectralOperation->frequencyFilter().has_value()) {
+                op = std::make_unique<TiledFilterOperation>(spectralOperation->frequencyFilter().value(),
+                                                            options_.fftKernelRadius.value(),
+                                                            options_.fftTileSize.value(),
+                                                            spectralOperation->precision());
+            }
+        }
+    }
+    channelOperations_ = FusedSpectralOperation::fuse(std::move(channelOperations_));
+}
+
 void InputProcessor::setupImageProcessingPipeline() {
     if (options_.closingMask.has_value()) {
         imageOperations_.emplace_back(
@@ -149,6 +268,10 @@ void InputProcessor::setupImageProcessingPipeline() {
         imageOperations_.emplace_back(
             std::make_unique<OpeningOperation>(options_.openingMask.value()));
     }
+    if (options_.isConnectedComponents) {
+        imageOperations_.emplace_back(
+            std::make_unique<ConnectedComponentsOperation>());
+    }
     if (options_.regionGrowing.has_value()) {
         imageOperations_.emplace_back(
             std::make_unique<RegionGrowingOperation>(options_.regionGrowing.value()));
@@ -165,6 +288,11 @@ void InputProcessor::setupStatsPipeline() {
         statsOperations_.emplace_back(
             std::make_unique<CompareImageStatsOperation>(originalImage));
     }
+    if (options_.templatePath.has_value()) {
+        statsOperations_.emplace_back(
+            std::make_unique<MatchTemplateOperation>(options_.templatePath.value(), options_.templateMatchCount,
+                                                     options_.isTemplateResponseMap));
+    }
 }
 
 void InputProcessor::saveResults(const cv::Mat &image) const {
@@ -202,15 +330,26 @@ void InputProcessor::printCommands() {
             << " - flip the image vertically.\n\n"
             << commandToStringMap.find(CommandType::DIAGONAL_FLIP)->second
             << " - flip the image diagonally.\n\n"
+            << commandToStringMap.find(CommandType::TRANSPOSE)->second
+            << " - transpose the image (swap rows with columns).\n\n"
+            << commandToStringMap.find(CommandType::ROTATE)->second
+            << "[-val=value] - rotate the image clockwise.\n"
+            << "\t -val - rotation angle in degrees (multiple of 90, can be negative).\n\n"
             << commandToStringMap.find(CommandType::RESIZE)->second
-            << "[-val=value] - resize an image using Nearest Neighbor Method.\n"
-            << "\t -val - floating-point scale factor of new image.\n\n"
+            << "[-val=value] [-method=value] - resize an image.\n"
+            << "\t -val - floating-point scale factor of new image.\n"
+            << "\t -method - optional resampling method: nearest (default), bilinear, bicubic, lanczos "
+            << "or area (best for large downscale factors).\n\n"
             << commandToStringMap.find(CommandType::MIDPOINT_FILTER)->second
             << "[-val=value] - apply midpoint filter.\n"
             << "\t -val - integer kernel size value.\n\n"
             << commandToStringMap.find(CommandType::ARITHMETIC_MEAN_FILTER)->second
             << " - apply arithmetic mean filter.\n"
             << "\t -val - integer kernel size value.\n\n"
+            << commandToStringMap.find(CommandType::CONVOLVE)->second
+            << "[-kernel=path] - convolve an image with a custom kernel (separable kernels are applied in two passes "
+            << "and large kernels through the fast fourier transform).\n"
+            << "\t -kernel - path to a text file with kernel rows on separate lines and whitespace separated values.\n\n"
             << commandToStringMap.find(CommandType::COMPARE_IMAGES)->second
             << " - save image comparison stats after all operations.\n\n"
             << commandToStringMap.find(CommandType::HISTOGRAM)->second
@@ -245,6 +384,9 @@ void InputProcessor::printCommands() {
             << commandToStringMap.find(CommandType::HMT)->second
             << " - apply HMT.\n"
             << "\t -mask - number of mask to choose (between 1 and 10).\n\n"
+            << commandToStringMap.find(CommandType::CONNECTED_COMPONENTS)->second
+            << " - label connected components of a binary image (8-connectivity) and save the label map, "
+            << "its colored visualization and the area, bounding box and centroid of every component.\n\n"
             << commandToStringMap.find(CommandType::REGION_GROWING)->second
             << " - make image segmentation using region growing method.\n"
             << "\t -criterion - criterion to choose (0- adaptive mean distance, 1- fixed mean distance, 2- absolute distance)\n\n"
@@ -254,42 +396,83 @@ void InputProcessor::printCommands() {
             << " - do the fast fourier transform and then inverse fast fourier transform.\n\n"
             << commandToStringMap.find(CommandType::FFT_LOW_PASS)->second
             << " - do the low pass filter after fast fourier transform and then inverse fast fourier transform.\n"
-            << "\t -bandValue - radius of the circle which will be preserved.\n\n"
+            << "\t -bandValue - radius of the circle which will be preserved.\n"
+            << "\t -shape - optional frequency response: ideal (default), butterworth or gaussian.\n"
+            << "\t -order - optional order of the butterworth filter (default 2).\n\n"
             << commandToStringMap.find(CommandType::FFT_HIGH_PASS)->second
             << " - do the high pass filter after fast fourier transform and then inverse fast fourier transform.\n"
-            << "\t -bandValue - radius of the circle which will not be preserved.\n\n"
+            << "\t -bandValue - radius of the circle which will not be preserved.\n"
+            << "\t -shape - optional frequency response: ideal (default), butterworth or gaussian.\n"
+            << "\t -order - optional order of the butterworth filter (default 2).\n\n"
             << commandToStringMap.find(CommandType::FFT_BAND_PASS)->second
             << " - do the band pass filter after fast fourier transform and then inverse fast fourier transform.\n"
             << "\t -lowCut - radius of the lower bound circle, which will be cut (with high pass filter)\n"
-            << "\t -highCut - radius of the upper bound circle up to which the fourier image will be preserved (with low pass filter).\n\n"
+            << "\t -highCut - radius of the upper bound circle up to which the fourier image will be preserved (with low pass filter).\n"
+            << "\t -shape - optional frequency response: ideal (default), butterworth or gaussian.\n"
+            << "\t -order - optional order of the butterworth filter (default 2).\n\n"
             << commandToStringMap.find(CommandType::FFT_BAND_CUT)->second
             << " - do the band cut filter after fast fourier transform and then inverse fast fourier transform.\n"
             << "\t -lowPass - radius of the larger circle. Between its edge and the smaller circle the area will be cut.\n"
-            << "\t -highPass - radius of the smaller circle. Between its edge and the larger circle the area will be cut\n\n"
+            << "\t -highPass - radius of the smaller circle. Between its edge and the larger circle the area will be cut\n"
+            << "\t -shape - optional frequency response: ideal (default), butterworth or gaussian.\n"
+            << "\t -order - optional order of the butterworth filter (default 2).\n\n"
             << commandToStringMap.find(CommandType::FFT_HIGH_PASS_DIRECTION)->second
             << " - do the high-pass filter with detection of edge direction after fast fourier transform and then inverse fast fourier transform.\n"
-            << "\t -mask - number of mask to choose (1 or 2)\n\n"
+            << "\t -bandValue - radius of the circle which will not be preserved.\n"
+            << "\t -angles - comma separated edge angles in degrees (0 keeps horizontal edges). With several angles "
+            << "every orientation is saved and the result is their maximum.\n"
+            << "\t -width - optional angular width of the preserved wedge in degrees (default 15).\n"
+            << "\t -shape - optional frequency response: ideal (default), butterworth or gaussian.\n"
+            << "\t -order - optional order of the butterworth filter (default 2).\n\n"
             << commandToStringMap.find(CommandType::FFT_PHASE_MODIFYING)->second
             << " - do the phase modifying filter after fast fourier transform and then inverse fast fourier transform.\n"
             << "\t -k - k coefficient in task F6.\n"
-            << "\t -l - l coefficient in task F6.\n\n";
+            << "\t -l - l coefficient in task F6.\n\n"
+            << commandToStringMap.find(CommandType::TRANSLATE)->second
+            << "[-dx=value] [-dy=value] - translate the image circularly by a possibly fractional offset "
+            << "with a phase ramp applied to its fast fourier transform.\n"
+            << "\t -dx - float horizontal offset (positive moves the image right).\n"
+            << "\t -dy - float vertical offset (positive moves the image down).\n\n"
+            << commandToStringMap.find(CommandType::FFT_PRECISION)->second
+            << "[-val=value] - set the precision of the fast fourier transform commands.\n"
+            << "\t -val - float (faster, vectorized) or double (default).\n\n"
+            << commandToStringMap.find(CommandType::FFT_TILED)->second
+            << "[-tile=value] [-radius=value] - run the low pass, high pass, band pass and band cut filters "
+            << "tile by tile as a convolution with their truncated impulse response, so images of any size fit in memory.\n"
+            << "\t -tile - maximum side of a tile (e.g. 512).\n"
+            << "\t -radius - radius of the impulse response and of the overlap of the tiles, has to cover "
+            << "about image size / cutoff pixels (works best with butterworth or gaussian filters).\n\n"
+            << commandToStringMap.find(CommandType::MATCH_TEMPLATE)->second
+            << "[-template=path] [-count=value] [-map] - find a template in the image by normalized cross-correlation "
+            << "computed with the fast fourier transform.\n"
+            << "\t -template - path to the template image (read in grayscale).\n"
+            << "\t -count - optional maximum number of non-overlapping matches (default 1).\n"
+            << "\t -map - optionally save the response map of the correlation.\n\n"
+            << commandToStringMap.find(CommandType::THREADS)->second
+            << "[-val=value] - set the number of threads used by parallel operations.\n"
+            << "\t -val - positive integer thread count (default is the number of available cores).\n\n";
 }
 
 void InputProcessor::process() {
     if (options_.showHelp) {
         printCommands();
     }
+    if (options_.threadCount.has_value()) {
+        Threading::setThreadCount(options_.threadCount.value());
+    }
     cv::Mat image = imread(inputImagePath_, options_.imreadMode);
     setupChannelProcessingPipeline();
+    fusePointOperations();
+    fuseGeometricOperations();
+    fuseSpectralOperations();
     setupImageProcessingPipeline();
     setupStatsPipeline();
 
     std::vector<cv::Mat> channels;
     split(image, channels);
-    for (auto & channel : channels) {
-        for (const auto& op : channelOperations_) {
-            op->apply(channel);
-        }
+    // Channels are independent, so every operation can process all of them at once
+    for (const auto& op : channelOperations_) {
+        op->applyToChannels(channels);
     }
     cv::merge(channels, image);
 
@@ -5,6 +5,7 @@
 #include "../../include/input-processing-lib/OutputManager.h"
 
 #include <fstream>
+#include <limits>
 
 #include "../../include/Constants.h"
 
@@ -28,6 +29,27 @@ void OutputManager::saveFile(const std::string &filePath, const std::stringstrea
     statsFile.close();
 }
 
+void OutputManager::saveLabels(const cv::Mat &labels, const std::string &baseName, const std::string &suffix) {
+    double maxLabel = 0;
+    cv::minMaxLoc(labels, nullptr, &maxLabel);
+    if (maxLabel <= std::numeric_limits<uint16_t>::max()) {
+        cv::Mat labels16;
+        labels.convertTo(labels16, CV_16UC1);
+        const std::string path = constructPath(baseName, suffix, "png");
+        saveImage(labels16, path);
+        return;
+    }
+
+    if (!std::filesystem::is_directory(Constants::DEFAULT_OUTPUT_DIR) || !
+        std::filesystem::exists(Constants::DEFAULT_OUTPUT_DIR)) {
+        std::filesystem::create_directory(Constants::DEFAULT_OUTPUT_DIR);
+    }
+    const std::string path = constructPath(baseName, suffix, "yml");
+    cv::FileStorage file(path, cv::FileStorage::WRITE);
+    file << "labels" << labels;
+    file.release();
+}
+
 std::string OutputManager::constructPath(const std::string &baseName, const std::string &suffix,
                                          const std::string &extension) {
     return Constants::DEFAULT_OUTPUT_DIR + '/' + baseName + '_' + suffix + '.' + extension;
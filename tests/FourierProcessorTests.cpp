@@ -0,0 +1,661 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#include <algorithm>
+#include <complex>
+#include <functional>
+#include <numbers>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+#include <image-processing-lib/CpuFeatures.h>
+#include <image-processing-lib/FFTKernels.h>
+#include <image-processing-lib/FourierProcessor.h>
+
+class FourierProcessorTest : public testing::Test {
+protected:
+    static cv::Mat createImage(const int rows, const int cols) {
+        cv::Mat image(rows, cols, CV_8UC1);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                image.at<uchar>(x, y) = static_cast<uchar>((x * 37 + y * 91 + x * y * 13) % 256);
+            }
+        }
+        return image;
+    }
+
+    /**
+     * Direct DFT of an image, with the zero frequency moved to (rows / 2, cols / 2).
+     */
+    static cv::Mat referenceSpectrum(const cv::Mat &image) {
+        const int M = image.rows;
+        const int N = image.cols;
+        cv::Mat spectrum(M, N, CV_64FC2);
+        for (int u = 0; u < M; u++) {
+            for (int v = 0; v < N; v++) {
+                std::complex<double> sum = 0;
+                for (int x = 0; x < M; x++) {
+                    for (int y = 0; y < N; y++) {
+                        const double angle = -2 * std::numbers::pi * (static_cast<double>(u * x) / M +
+                                                                      static_cast<double>(v * y) / N);
+                        sum += static_cast<double>(image.at<uchar>(x, y)) * std::polar(1.0, angle);
+                    }
+                }
+                spectrum.at<cv::Vec2d>((u + M / 2) % M, (v + N / 2) % N) = cv::Vec2d(sum.real(), sum.imag());
+            }
+        }
+        return spectrum;
+    }
+};
+
+TEST_F(FourierProcessorTest, FastFourierTransformArbitrarySizeTest) {
+    // Power of two, mixed radix (3 * 5 by 2 * 7) and prime (Bluestein) lengths, odd sizes included
+    for (const auto &[rows, cols]: {std::pair(8, 16), std::pair(15, 14), std::pair(11, 9), std::pair(13, 42),
+                                    std::pair(1, 17), std::pair(35, 66)}) {
+        const cv::Mat image = createImage(rows, cols);
+        const cv::Mat expected = referenceSpectrum(image);
+        const cv::Mat spectrum = FourierProcessor::fastFourierTransform(image);
+        ASSERT_EQ(rows, spectrum.rows);
+        ASSERT_EQ(cols, spectrum.cols);
+        for (int u = 0; u < rows; u++) {
+            for (int v = 0; v < cols; v++) {
+                EXPECT_NEAR(expected.at<cv::Vec2d>(u, v)[0], spectrum.at<cv::Vec2d>(u, v)[0], 1e-6)
+                    << "Mismatch at frequency (" << u << ", " << v << ") of " << rows << "x" << cols;
+                EXPECT_NEAR(expected.at<cv::Vec2d>(u, v)[1], spectrum.at<cv::Vec2d>(u, v)[1], 1e-6)
+                    << "Mismatch at frequency (" << u << ", " << v << ") of " << rows << "x" << cols;
+            }
+        }
+
+        const cv::Mat reconstructed = FourierProcessor::inverseFastFourierTransform(spectrum);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                EXPECT_EQ(image.at<uchar>(x, y), reconstructed.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") of " << rows << "x" << cols;
+            }
+        }
+    }
+}
+
+TEST_F(FourierProcessorTest, FastFourierTransformPaddingTest) {
+    EXPECT_EQ(1, FourierProcessor::fastFFTLength(1));
+    EXPECT_EQ(12, FourierProcessor::fastFFTLength(11));
+    EXPECT_EQ(210, FourierProcessor::fastFFTLength(210));
+    EXPECT_EQ(4000, FourierProcessor::fastFFTLength(3989));
+
+    const cv::Mat image = createImage(23, 31);
+    const cv::Mat spectrum = FourierProcessor::fastFourierTransform(image, true);
+    EXPECT_EQ(24, spectrum.rows);
+    EXPECT_EQ(32, spectrum.cols);
+    const cv::Mat reconstructed = FourierProcessor::inverseFastFourierTransform(spectrum, image.size());
+    ASSERT_EQ(image.rows, reconstructed.rows);
+    ASSERT_EQ(image.cols, reconstructed.cols);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            EXPECT_EQ(image.at<uchar>(x, y), reconstructed.at<uchar>(x, y))
+                << "Mismatch at pixel (" << x << ", " << y << ")";
+        }
+    }
+}
+
+TEST_F(FourierProcessorTest, FourierTransformTest) {
+    for (const auto &[rows, cols]: {std::pair(8, 16), std::pair(11, 9), std::pair(1, 17), std::pair(33, 36)}) {
+        const cv::Mat image = createImage(rows, cols);
+        const cv::Mat expected = referenceSpectrum(image);
+        const cv::Mat spectrum = FourierProcessor::fourierTransform(image);
+        ASSERT_EQ(rows, spectrum.rows);
+        ASSERT_EQ(cols, spectrum.cols);
+        for (int u = 0; u < rows; u++) {
+            for (int v = 0; v < cols; v++) {
+                EXPECT_NEAR(expected.at<cv::Vec2d>(u, v)[0], spectrum.at<cv::Vec2d>(u, v)[0], 1e-6)
+                    << "Mismatch at frequency (" << u << ", " << v << ") of " << rows << "x" << cols;
+                EXPECT_NEAR(expected.at<cv::Vec2d>(u, v)[1], spectrum.at<cv::Vec2d>(u, v)[1], 1e-6)
+                    << "Mismatch at frequency (" << u << ", " << v << ") of " << rows << "x" << cols;
+            }
+        }
+
+        const cv::Mat reconstructed = FourierProcessor::inverseFourierTransform(spectrum);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                EXPECT_EQ(image.at<uchar>(x, y), reconstructed.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") of " << rows << "x" << cols;
+            }
+        }
+    }
+}
+
+TEST_F(FourierProcessorTest, MatchTemplateTest) {
+    const cv::Mat image = createImage(29, 34);
+    constexpr int templateX = 11;
+    constexpr int templateY = 6;
+    cv::Mat templ(7, 9, CV_8UC1);
+    for (int x = 0; x < templ.rows; x++) {
+        for (int y = 0; y < templ.cols; y++) {
+            templ.at<uchar>(x, y) = image.at<uchar>(templateX + x, templateY + y);
+        }
+    }
+
+    const cv::Mat response = FourierProcessor::matchTemplate(image, templ);
+    ASSERT_EQ(image.rows - templ.rows + 1, response.rows);
+    ASSERT_EQ(image.cols - templ.cols + 1, response.cols);
+    const double count = static_cast<double>(templ.rows) * templ.cols;
+    for (int x = 0; x < response.rows; x++) {
+        for (int y = 0; y < response.cols; y++) {
+            // Pearson correlation of the window and the template
+            double windowMean = 0;
+            double templateMean = 0;
+            for (int i = 0; i < templ.rows; i++) {
+                for (int j = 0; j < templ.cols; j++) {
+                    windowMean += image.at<uchar>(x + i, y + j) / count;
+                    templateMean += templ.at<uchar>(i, j) / count;
+                }
+            }
+            double covariance = 0;
+            double windowNorm = 0;
+            double templateNorm = 0;
+            for (int i = 0; i < templ.rows; i++) {
+                for (int j = 0; j < templ.cols; j++) {
+                    const double window = image.at<uchar>(x + i, y + j) - windowMean;
+                    const double pattern = templ.at<uchar>(i, j) - templateMean;
+                    covariance += window * pattern;
+                    windowNorm += window * window;
+                    templateNorm += pattern * pattern;
+                }
+            }
+            EXPECT_NEAR(covariance / std::sqrt(windowNorm * templateNorm), response.at<double>(x, y), 1e-9)
+                << "Mismatch at (" << x << ", " << y << ")";
+        }
+    }
+
+    const std::vector<FourierProcessor::TemplateMatch> matches =
+            FourierProcessor::findMatches(response, templ.size(), 3);
+    ASSERT_FALSE(matches.empty());
+    EXPECT_EQ(templateX, matches.front().x);
+    EXPECT_EQ(templateY, matches.front().y);
+    EXPECT_NEAR(1.0, matches.front().score, 1e-9);
+    for (size_t i = 1; i < matches.size(); i++) {
+        EXPECT_LE(matches[i].score, matches[i - 1].score);
+        EXPECT_TRUE(std::abs(matches[i].x - templateX) >= templ.rows
+                    || std::abs(matches[i].y - templateY) >= templ.cols);
+    }
+
+    EXPECT_THROW(FourierProcessor::matchTemplate(image, cv::Mat(3, 3, CV_8UC1, cv::Scalar(7))), std::invalid_argument);
+    EXPECT_THROW(FourierProcessor::matchTemplate(templ, image), std::invalid_argument);
+}
+
+TEST_F(FourierProcessorTest, TranslateTest) {
+    // Integer offsets move the image circularly without changing any pixel
+    for (const auto &[rows, cols]: {std::pair(16, 20), std::pair(15, 21)}) {
+        const cv::Mat image = createImage(rows, cols);
+        const cv::Mat translated = FourierProcessor::translate(image, 3, -5);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                EXPECT_EQ(image.at<uchar>(x, y), translated.at<uchar>((x + 3) % rows, (y - 5 + cols) % cols))
+                    << "Mismatch at pixel (" << x << ", " << y << ") of " << rows << "x" << cols;
+            }
+        }
+    }
+
+    // A band-limited image is translated by a fraction of a pixel exactly
+    constexpr int rows = 24;
+    constexpr int cols = 30;
+    const auto intensity = [](const double x, const double y) {
+        return 128 + 60 * std::cos(2 * std::numbers::pi * 2 * x / rows)
+               + 50 * std::sin(2 * std::numbers::pi * (3 * y / cols + x / rows));
+    };
+    cv::Mat image(rows, cols, CV_8UC1);
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>(std::round(intensity(x, y)));
+        }
+    }
+    const cv::Mat translated = FourierProcessor::translate(image, 0.5, -1.25);
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            // The input is rounded, so the translation of the rounding error adds to the rounding of the result
+            EXPECT_NEAR(intensity(x - 0.5, y + 1.25), translated.at<uchar>(x, y), 1.5)
+                << "Mismatch at pixel (" << x << ", " << y << ")";
+        }
+    }
+
+    // Phase modification keeps its ramp exp(-2 pi i (n k / M + m l / N) + (k + l) pi)
+    const cv::Mat spectrum = FourierProcessor::fastFourierTransform(createImage(9, 12));
+    const cv::Mat modified = FourierProcessor::fftPhaseModifying(spectrum, 2, -3);
+    for (int n = 0; n < spectrum.rows; n++) {
+        for (int m = 0; m < spectrum.cols; m++) {
+            const std::complex<double> mask = std::polar(
+                1.0, -2 * std::numbers::pi * (n * 2.0 / spectrum.rows + m * -3.0 / spectrum.cols) - std::numbers::pi);
+            const std::complex<double> expected =
+                    std::complex(spectrum.at<cv::Vec2d>(n, m)[0], spectrum.at<cv::Vec2d>(n, m)[1]) * mask;
+            EXPECT_NEAR(expected.real(), modified.at<cv::Vec2d>(n, m)[0], 1e-6);
+            EXPECT_NEAR(expected.imag(), modified.at<cv::Vec2d>(n, m)[1], 1e-6);
+        }
+    }
+}
+
+TEST_F(FourierProcessorTest, FFTPlanTest) {
+    const auto plan = FourierProcessor::FFTPlan::get(12, false);
+    EXPECT_EQ(plan, FourierProcessor::FFTPlan::get(12, false));
+    EXPECT_NE(plan, FourierProcessor::FFTPlan::get(12, true));
+    EXPECT_EQ(12, plan->length());
+    EXPECT_FALSE(plan->isInverse());
+
+    // Plans requested concurrently are built once and agree with a direct DFT
+    for (const int length: {16, 45, 19}) {
+        std::vector<std::shared_ptr<const FourierProcessor::FFTPlan> > plans(4);
+        std::vector<std::thread> threads;
+        for (auto &threadPlan: plans) {
+            threads.emplace_back([&threadPlan, length] {
+                threadPlan = FourierProcessor::FFTPlan::get(length, false);
+            });
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+        for (const auto &threadPlan: plans) {
+            EXPECT_EQ(plans[0], threadPlan);
+        }
+
+        std::vector<std::complex<double> > data(length);
+        for (int k = 0; k < length; k++) {
+            data[k] = std::complex<double>((k * 37) % 11, (k * 5) % 7);
+        }
+        const std::vector<std::complex<double> > input = data;
+        std::vector<std::complex<double> > scratch(plans[0]->scratchSize());
+        plans[0]->execute(data.data(), scratch.data());
+        for (int u = 0; u < length; u++) {
+            std::complex<double> expected;
+            for (int k = 0; k < length; k++) {
+                expected += input[k] * std::polar(1.0, -2 * std::numbers::pi * u * k / length);
+            }
+            EXPECT_NEAR(expected.real(), data[u].real(), 1e-9) << "Mismatch at frequency " << u << " of " << length;
+            EXPECT_NEAR(expected.imag(), data[u].imag(), 1e-9) << "Mismatch at frequency " << u << " of " << length;
+        }
+    }
+}
+
+TEST_F(FourierProcessorTest, RealFastFourierTransformTest) {
+    for (const auto &[rows, cols]: std::vector<std::pair<int, int> >{{8, 16}, {15, 14}, {11, 9}, {1, 17}, {6, 1}}) {
+        const cv::Mat image = createImage(rows, cols);
+        const FourierProcessor::HalfSpectrum halfSpectrum = FourierProcessor::realFastFourierTransform(image);
+        ASSERT_EQ(rows, halfSpectrum.values.rows);
+        ASSERT_EQ(cols / 2 + 1, halfSpectrum.values.cols);
+        EXPECT_EQ(cols, halfSpectrum.cols);
+
+        const cv::Mat expected = FourierProcessor::fastFourierTransform(image);
+        const cv::Mat spectrum = FourierProcessor::expandHalfSpectrum(halfSpectrum);
+        for (int u = 0; u < rows; u++) {
+            for (int v = 0; v < cols; v++) {
+                EXPECT_NEAR(expected.at<cv::Vec2d>(u, v)[0], spectrum.at<cv::Vec2d>(u, v)[0], 1e-6)
+                    << "Mismatch at frequency (" << u << ", " << v << ") of " << rows << "x" << cols;
+                EXPECT_NEAR(expected.at<cv::Vec2d>(u, v)[1], spectrum.at<cv::Vec2d>(u, v)[1], 1e-6)
+                    << "Mismatch at frequency (" << u << ", " << v << ") of " << rows << "x" << cols;
+            }
+        }
+
+        const cv::Mat reconstructed = FourierProcessor::inverseRealFastFourierTransform(halfSpectrum);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                EXPECT_EQ(image.at<uchar>(x, y), reconstructed.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") of " << rows << "x" << cols;
+            }
+        }
+    }
+
+    const cv::Mat image = createImage(23, 31);
+    const FourierProcessor::HalfSpectrum padded = FourierProcessor::realFastFourierTransform(image, true);
+    EXPECT_EQ(24, padded.values.rows);
+    EXPECT_EQ(32, padded.cols);
+    const cv::Mat reconstructed = FourierProcessor::inverseRealFastFourierTransform(padded, image.size());
+    ASSERT_EQ(image.size(), reconstructed.size());
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            EXPECT_EQ(image.at<uchar>(x, y), reconstructed.at<uchar>(x, y))
+                << "Mismatch at pixel (" << x << ", " << y << ")";
+        }
+    }
+}
+
+TEST_F(FourierProcessorTest, BatchedRealFastFourierTransformTest) {
+    // Odd row counts make row pairs span two channels, the last case is padded
+    for (const auto &[rows, cols, pad]: {std::tuple(8, 16, false), std::tuple(15, 14, false),
+                                         std::tuple(1, 17, false), std::tuple(23, 31, true)}) {
+        std::vector<cv::Mat> channels;
+        for (int c = 0; c < 3; c++) {
+            cv::Mat channel = createImage(rows, cols);
+            for (int x = 0; x < rows; x++) {
+                for (int y = 0; y < cols; y++) {
+                    channel.at<uchar>(x, y) = static_cast<uchar>(channel.at<uchar>(x, y) + 71 * c);
+                }
+            }
+            channels.push_back(channel);
+        }
+
+        const std::vector<FourierProcessor::HalfSpectrum> spectra =
+                FourierProcessor::realFastFourierTransform(channels, pad);
+        ASSERT_EQ(channels.size(), spectra.size());
+        for (size_t c = 0; c < channels.size(); c++) {
+            const FourierProcessor::HalfSpectrum expected =
+                    FourierProcessor::realFastFourierTransform(channels[c], pad);
+            const cv::Mat &values = spectra[c].values;
+            ASSERT_EQ(expected.values.size(), values.size());
+            EXPECT_EQ(expected.cols, spectra[c].cols);
+            for (int u = 0; u < values.rows; u++) {
+                for (int v = 0; v < values.cols; v++) {
+                    EXPECT_NEAR(expected.values.at<cv::Vec2d>(u, v)[0], values.at<cv::Vec2d>(u, v)[0], 1e-6)
+                        << "Mismatch at frequency (" << u << ", " << v << ") of channel " << c;
+                    EXPECT_NEAR(expected.values.at<cv::Vec2d>(u, v)[1], values.at<cv::Vec2d>(u, v)[1], 1e-6)
+                        << "Mismatch at frequency (" << u << ", " << v << ") of channel " << c;
+                }
+            }
+        }
+
+        const std::vector<cv::Mat> reconstructed =
+                FourierProcessor::inverseRealFastFourierTransform(spectra, channels.front().size());
+        ASSERT_EQ(channels.size(), reconstructed.size());
+        for (size_t c = 0; c < channels.size(); c++) {
+            ASSERT_EQ(channels[c].size(), reconstructed[c].size());
+            for (int x = 0; x < rows; x++) {
+                for (int y = 0; y < cols; y++) {
+                    EXPECT_EQ(channels[c].at<uchar>(x, y), reconstructed[c].at<uchar>(x, y))
+                        << "Mismatch at pixel (" << x << ", " << y << ") of channel " << c;
+                }
+            }
+        }
+    }
+
+    EXPECT_THROW(FourierProcessor::realFastFourierTransform(std::vector{createImage(4, 4), createImage(4, 5)}),
+                 std::invalid_argument);
+}
+
+TEST_F(FourierProcessorTest, HalfSpectrumFilterTest) {
+    using Filter = std::function<cv::Mat(const cv::Mat &)>;
+    using HalfFilter = std::function<FourierProcessor::HalfSpectrum(const FourierProcessor::HalfSpectrum &)>;
+    const std::vector<std::pair<Filter, HalfFilter> > filters = {
+        {
+            [](const cv::Mat &spectrum) { return FourierProcessor::fftLowPass(spectrum, 6); },
+            [](const FourierProcessor::HalfSpectrum &spectrum) { return FourierProcessor::fftLowPass(spectrum, 6); }
+        },
+        {
+            [](const cv::Mat &spectrum) { return FourierProcessor::fftHighPass(spectrum, 4); },
+            [](const FourierProcessor::HalfSpectrum &spectrum) { return FourierProcessor::fftHighPass(spectrum, 4); }
+        },
+        {
+            [](const cv::Mat &spectrum) { return FourierProcessor::fftBandPass(spectrum, 2, 9); },
+            [](const FourierProcessor::HalfSpectrum &spectrum) {
+                return FourierProcessor::fftBandPass(spectrum, 2, 9);
+            }
+        },
+        {
+            [](const cv::Mat &spectrum) { return FourierProcessor::fftBandCut(spectrum, 3, 7); },
+            [](const FourierProcessor::HalfSpectrum &spectrum) {
+                return FourierProcessor::fftBandCut(spectrum, 3, 7);
+            }
+        },
+        {
+            [](const cv::Mat &spectrum) {
+                return FourierProcessor::fftLowPass(spectrum, 5, FourierProcessor::FilterShape::BUTTERWORTH, 3);
+            },
+            [](const FourierProcessor::HalfSpectrum &spectrum) {
+                return FourierProcessor::fftLowPass(spectrum, 5, FourierProcessor::FilterShape::BUTTERWORTH, 3);
+            }
+        },
+        {
+            [](const cv::Mat &spectrum) {
+                return FourierProcessor::fftBandCut(spectrum, 3, 7, FourierProcessor::FilterShape::GAUSSIAN);
+            },
+            [](const FourierProcessor::HalfSpectrum &spectrum) {
+                return FourierProcessor::fftBandCut(spectrum, 3, 7, FourierProcessor::FilterShape::GAUSSIAN);
+            }
+        }
+    };
+
+    for (const auto &[rows, cols]: std::vector<std::pair<int, int> >{{20, 24}, {17, 21}}) {
+        const cv::Mat image = createImage(rows, cols);
+        for (size_t i = 0; i < filters.size(); i++) {
+            const cv::Mat expected = FourierProcessor::inverseFastFourierTransform(
+                filters[i].first(FourierProcessor::fastFourierTransform(image)));
+            const cv::Mat filtered = FourierProcessor::inverseRealFastFourierTransform(
+                filters[i].second(FourierProcessor::realFastFourierTransform(image)));
+            for (int x = 0; x < rows; x++) {
+                for (int y = 0; y < cols; y++) {
+                    // Both paths round the same value, which can only differ in the last bits
+                    EXPECT_NEAR(expected.at<uchar>(x, y), filtered.at<uchar>(x, y), 1)
+                        << "Mismatch of filter " << i << " at pixel (" << x << ", " << y << ") of "
+                        << rows << "x" << cols;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(FourierProcessorTest, FilterMaskTest) {
+    using FourierProcessor::FilterShape;
+    using FourierProcessor::FilterType;
+    constexpr int rows = 16;
+    constexpr int cols = 20;
+    // Gain at distance 5 = cutoff (frequency (rows / 2 + 3, cols / 2 + 4) of the shifted spectrum)
+    const std::vector<std::pair<FourierProcessor::FrequencyFilter, double> > filters = {
+        {{FilterType::LOW_PASS, FilterShape::IDEAL, 5}, 0.0},
+        {{FilterType::LOW_PASS, FilterShape::BUTTERWORTH, 5, 0, 3}, 0.5},
+        {{FilterType::LOW_PASS, FilterShape::GAUSSIAN, 5}, std::exp(-0.5)},
+        {{FilterType::HIGH_PASS, FilterShape::IDEAL, 5}, 0.0},
+        {{FilterType::HIGH_PASS, FilterShape::BUTTERWORTH, 5, 0, 1}, 0.5},
+        {{FilterType::HIGH_PASS, FilterShape::GAUSSIAN, 5}, 1.0 - std::exp(-0.5)},
+        {{FilterType::BAND_CUT, FilterShape::IDEAL, 5, 6}, 0.0},
+    };
+
+    for (const auto &[filter, gain]: filters) {
+        const cv::Mat mask = FourierProcessor::filterMask(filter, rows, cols, false);
+        ASSERT_EQ(mask.type(), CV_64FC1);
+        ASSERT_EQ(mask.rows, rows);
+        ASSERT_EQ(mask.cols, cols);
+        EXPECT_NEAR(mask.at<double>(rows / 2 + 3, cols / 2 + 4), gain, 1e-12);
+        // High-pass and band-cut filters keep the mean brightness too
+        EXPECT_EQ(mask.at<double>(rows / 2, cols / 2), 1.0);
+
+        // The half spectrum mask holds the same gains at unshifted positions (u = -3 is row rows - 3)
+        const cv::Mat halfMask = FourierProcessor::filterMask(filter, rows, cols, true);
+        ASSERT_EQ(halfMask.cols, cols / 2 + 1);
+        EXPECT_NEAR(halfMask.at<double>(rows - 3, 4), gain, 1e-12);
+
+        // Masks are computed once and shared
+        EXPECT_EQ(FourierProcessor::filterMask(filter, rows, cols, false).data, mask.data);
+    }
+
+    EXPECT_THROW(FourierProcessor::filterMask({FilterType::LOW_PASS, FilterShape::BUTTERWORTH, 5, 0, 0}, rows, cols,
+                     false), std::invalid_argument);
+}
+
+TEST_F(FourierProcessorTest, HighPassDirectionTest) {
+    constexpr int rows = 24;
+    constexpr int cols = 30;
+    // Horizontal stripes (edges at 0 degrees), vertical stripes (edges at 90 degrees) and diagonal stripes
+    const auto horizontalStripes = [](const int x) { return 40 * std::cos(2 * std::numbers::pi * 4 * x / rows); };
+    const auto verticalStripes = [](const int y) { return 30 * std::cos(2 * std::numbers::pi * 5 * y / cols); };
+    cv::Mat image(rows, cols, CV_8UC1);
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            const double diagonalStripes = 20 * std::cos(2 * std::numbers::pi * (3.0 * x / rows + 3.0 * y / cols));
+            image.at<uchar>(x, y) = static_cast<uchar>(std::round(
+                128 + horizontalStripes(x) + verticalStripes(y) + diagonalStripes));
+        }
+    }
+
+    const std::vector<std::vector<cv::Mat> > directions =
+            FourierProcessor::highPassDirections({image}, 2, {0, 90}, 20);
+    ASSERT_EQ(2, directions.size());
+    const std::vector filtered = {directions[0].front(), directions[1].front()};
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            // The mean brightness is kept, rounding the input adds up to one level of error
+            EXPECT_NEAR(128 + horizontalStripes(x), filtered[0].at<uchar>(x, y), 1.5)
+                << "Mismatch at pixel (" << x << ", " << y << ") of horizontal edges";
+            EXPECT_NEAR(128 + verticalStripes(y), filtered[1].at<uchar>(x, y), 1.5)
+                << "Mismatch at pixel (" << x << ", " << y << ") of vertical edges";
+        }
+    }
+
+    // Every orientation matches the single angle filter and the mask is symmetric, so the image stays real
+    const FourierProcessor::HalfSpectrum spectrum = FourierProcessor::realFastFourierTransform(image);
+    const cv::Mat single = FourierProcessor::inverseRealFastFourierTransform(
+        FourierProcessor::fftHighPassDirection(spectrum, 2, 90, 20));
+    const cv::Mat full = FourierProcessor::inverseFastFourierTransform(
+        FourierProcessor::fftHighPassDirection(FourierProcessor::fastFourierTransform(image), 2, 90, 20));
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            EXPECT_EQ(filtered[1].at<uchar>(x, y), single.at<uchar>(x, y));
+            EXPECT_NEAR(single.at<uchar>(x, y), full.at<uchar>(x, y), 1);
+        }
+    }
+
+    // The shape and the order of the high-pass part are passed through
+    const cv::Mat gaussian = FourierProcessor::inverseRealFastFourierTransform(
+        FourierProcessor::fftHighPassDirection(spectrum, 4, 90, 20, FourierProcessor::FilterShape::GAUSSIAN));
+    const std::vector<std::vector<cv::Mat> > shaped = FourierProcessor::highPassDirections(
+        {image}, 4, {90}, 20, FourierProcessor::FilterShape::GAUSSIAN);
+    ASSERT_EQ(1, shaped.size());
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            EXPECT_EQ(gaussian.at<uchar>(x, y), shaped.front().front().at<uchar>(x, y));
+        }
+    }
+
+    // Channels transformed in one batch match the channels filtered one by one
+    const cv::Mat other = createImage(rows, cols);
+    const std::vector<std::vector<cv::Mat> > batch =
+            FourierProcessor::highPassDirections({other, image}, 2, {0, 90}, 20);
+    const std::vector<std::vector<cv::Mat> > otherDirections =
+            FourierProcessor::highPassDirections({other}, 2, {0, 90}, 20);
+    ASSERT_EQ(2, batch.size());
+    for (size_t a = 0; a < batch.size(); a++) {
+        ASSERT_EQ(2, batch[a].size());
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                EXPECT_NEAR(otherDirections[a].front().at<uchar>(x, y), batch[a][0].at<uchar>(x, y), 1);
+                EXPECT_NEAR(filtered[a].at<uchar>(x, y), batch[a][1].at<uchar>(x, y), 1);
+            }
+        }
+    }
+}
+
+TEST_F(FourierProcessorTest, TiledFilterTest) {
+    using FourierProcessor::FilterShape;
+    using FourierProcessor::FilterType;
+    const FourierProcessor::FrequencyFilter lowPass = {FilterType::LOW_PASS, FilterShape::GAUSSIAN, 6};
+    const FourierProcessor::FrequencyFilter highPass = {FilterType::HIGH_PASS, FilterShape::BUTTERWORTH, 5, 0, 2};
+
+    // A kernel covering the whole image is the exact impulse response, so the tiles reproduce the whole-image filter
+    const cv::Mat image = createImage(45, 37);
+    for (const auto precision: {FourierProcessor::FFTPrecision::DOUBLE, FourierProcessor::FFTPrecision::FLOAT}) {
+        const cv::Mat expected = FourierProcessor::inverseRealFastFourierTransform(
+            FourierProcessor::applyFilter(FourierProcessor::realFastFourierTransform(image), lowPass));
+        const cv::Mat tiled = FourierProcessor::tiledFilter(image, lowPass, 100, 16, precision);
+        for (int x = 0; x < image.rows; x++) {
+            for (int y = 0; y < image.cols; y++) {
+                EXPECT_NEAR(expected.at<uchar>(x, y), tiled.at<uchar>(x, y), 1)
+                    << "Mismatch at pixel (" << x << ", " << y << ")";
+            }
+        }
+    }
+
+    // With a truncated kernel the tiles compute the circular convolution with it, including the ragged last tiles
+    const cv::Mat largeImage = createImage(70, 90);
+    for (const auto &filter: {lowPass, highPass}) {
+        const cv::Mat kernel = FourierProcessor::filterKernel(filter, largeImage.size(), 4);
+        ASSERT_EQ(9, kernel.rows);
+        ASSERT_EQ(9, kernel.cols);
+        const cv::Mat tiled = FourierProcessor::tiledFilter(largeImage, filter, 4, 16);
+        for (int x = 0; x < largeImage.rows; x++) {
+            for (int y = 0; y < largeImage.cols; y++) {
+                double expected = 0;
+                for (int i = -4; i <= 4; i++) {
+                    for (int j = -4; j <= 4; j++) {
+                        expected += kernel.at<double>(i + 4, j + 4) * largeImage.at<uchar>(
+                            (x - i + largeImage.rows) % largeImage.rows, (y - j + largeImage.cols) % largeImage.cols);
+                    }
+                }
+                EXPECT_NEAR(std::clamp(std::abs(expected), 0.0, 255.0), tiled.at<uchar>(x, y), 0.5 + 1e-6)
+                    << "Mismatch at pixel (" << x << ", " << y << ")";
+            }
+        }
+    }
+
+    EXPECT_THROW(FourierProcessor::tiledFilter(cv::Mat(4, 4, CV_8UC3), lowPass, 2), std::invalid_argument);
+    EXPECT_THROW(FourierProcessor::tiledFilter(image, lowPass, -1), std::invalid_argument);
+    EXPECT_THROW(FourierProcessor::tiledFilter(image, lowPass, 2, 0), std::invalid_argument);
+}
+
+TEST_F(FourierProcessorTest, FloatPrecisionTest) {
+    // Radix-4 stages wide enough for every vector width, mixed radix, Bluestein and odd sizes
+    for (const auto &[rows, cols]: std::vector<std::pair<int, int> >{{16, 64}, {15, 14}, {13, 17}, {33, 36}}) {
+        const cv::Mat image = createImage(rows, cols);
+        const cv::Mat expected = FourierProcessor::fastFourierTransform(image);
+        const cv::Mat spectrum = FourierProcessor::fastFourierTransform(image, false,
+                                                                        FourierProcessor::FFTPrecision::FLOAT);
+        ASSERT_EQ(CV_32FC2, spectrum.type());
+        // Single precision errors are relative to the largest coefficient, the sum of all pixels
+        const double tolerance = 1e-5 * std::abs(expected.at<cv::Vec2d>(rows / 2, cols / 2)[0]);
+        for (int u = 0; u < rows; u++) {
+            for (int v = 0; v < cols; v++) {
+                EXPECT_NEAR(expected.at<cv::Vec2d>(u, v)[0], spectrum.at<cv::Vec2f>(u, v)[0], tolerance)
+                    << "Mismatch at frequency (" << u << ", " << v << ") of " << rows << "x" << cols;
+                EXPECT_NEAR(expected.at<cv::Vec2d>(u, v)[1], spectrum.at<cv::Vec2f>(u, v)[1], tolerance)
+                    << "Mismatch at frequency (" << u << ", " << v << ") of " << rows << "x" << cols;
+            }
+        }
+
+        const cv::Mat reconstructed = FourierProcessor::inverseFastFourierTransform(spectrum);
+        const cv::Mat lowPass = FourierProcessor::inverseRealFastFourierTransform(FourierProcessor::fftLowPass(
+            FourierProcessor::realFastFourierTransform(image, false, FourierProcessor::FFTPrecision::FLOAT), 5));
+        const cv::Mat expectedLowPass = FourierProcessor::inverseRealFastFourierTransform(
+            FourierProcessor::fftLowPass(FourierProcessor::realFastFourierTransform(image), 5));
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                EXPECT_EQ(image.at<uchar>(x, y), reconstructed.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") of " << rows << "x" << cols;
+                EXPECT_NEAR(expectedLowPass.at<uchar>(x, y), lowPass.at<uchar>(x, y), 1)
+                    << "Mismatch at pixel (" << x << ", " << y << ") of " << rows << "x" << cols;
+            }
+        }
+    }
+
+    // Every radix-4 kernel the library was built with and the processor supports has to match the scalar one,
+    // also for strides which leave a tail after the last full vector
+    constexpr int groupCount = 3;
+    for (const int stride: {1, 5, 6, 8}) {
+        std::vector<std::complex<float> > source(4 * groupCount * stride);
+        std::vector<std::complex<float> > twiddles(3 * stride);
+        for (size_t i = 0; i < source.size(); i++) {
+            source[i] = std::complex<float>(static_cast<float>(i * 37 % 23), static_cast<float>(i * 11 % 17));
+        }
+        for (size_t i = 0; i < twiddles.size(); i++) {
+            twiddles[i] = std::polar(1.0f, static_cast<float>(i) * 0.3f);
+        }
+        const auto *sourceFloats = reinterpret_cast<const float *>(source.data());
+        const auto *twiddleFloats = reinterpret_cast<const float *>(twiddles.data());
+        for (const bool inverse: {false, true}) {
+            std::vector<std::complex<float> > expected(source.size());
+            FFTKernels::scalarRadix4Function()(sourceFloats, reinterpret_cast<float *>(expected.data()),
+                                               twiddleFloats, groupCount, stride, inverse);
+            for (const auto &[level, radix4] : {
+                     std::pair(CpuFeatures::SimdLevel::SSE4, FFTKernels::sse4Radix4Function()),
+                     std::pair(CpuFeatures::SimdLevel::AVX2, FFTKernels::avx2Radix4Function())
+                 }) {
+                if (radix4 == nullptr || CpuFeatures::simdLevel() < level) {
+                    continue;
+                }
+                // Offsets beyond the stage have to stay untouched
+                std::vector<std::complex<float> > actual(source.size() + 1, std::complex<float>(-1.0f, -1.0f));
+                radix4(sourceFloats, reinterpret_cast<float *>(actual.data()), twiddleFloats, groupCount, stride,
+                       inverse);
+                for (size_t i = 0; i < source.size(); i++) {
+                    EXPECT_NEAR(expected[i].real(), actual[i].real(), 1e-4) << "Mismatch at value " << i;
+                    EXPECT_NEAR(expected[i].imag(), actual[i].imag(), 1e-4) << "Mismatch at value " << i;
+                }
+                EXPECT_EQ(std::complex<float>(-1.0f, -1.0f), actual.back());
+            }
+        }
+    }
+}
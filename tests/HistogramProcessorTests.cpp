@@ -68,6 +68,24 @@ TEST_F(HistogramProcessorTest, HistogramEqualizationTest) {
     EXPECT_EQ(255, imageAfterModification.at<uchar>(1, 1));
 }
 
+TEST_F(HistogramProcessorTest, TransformHistogramTest) {
+    blackImageGrayscale.at<uchar>(0, 0) = 1;
+    blackImageGrayscale.at<uchar>(0, 1) = 1;
+    blackImageGrayscale.at<uchar>(1, 0) = 254;
+    const std::array<uint, UCHAR_MAX + 1> histogram = HistogramProcessor::computeHistogram(blackImageGrayscale);
+    const std::array<uchar, UCHAR_MAX + 1> lookupTable = HistogramProcessor::equalizationLookupTable(histogram, 255, 0);
+
+    const std::array<uint, UCHAR_MAX + 1> transformedHistogram =
+            HistogramProcessor::transformHistogram(histogram, lookupTable);
+    const cv::Mat equalizedImage = HistogramProcessor::histogramEqualization(blackImageGrayscale, histogram, 255, 0);
+    const std::array<uint, UCHAR_MAX + 1> expectedHistogram = HistogramProcessor::computeHistogram(equalizedImage);
+    for (int i = 0; i <= UCHAR_MAX; i++) {
+        EXPECT_EQ(expectedHistogram[i], transformedHistogram[i]) << "Mismatch at intensity " << i;
+    }
+    EXPECT_EQ(0, HistogramProcessor::minimumIntensity(histogram));
+    EXPECT_EQ(254, HistogramProcessor::maximumIntensity(histogram));
+}
+
 TEST_F(HistogramProcessorTest, MeanTest) {
     blackImageGrayscale.at<uchar>(0, 0) = 10;
     blackImageGrayscale.at<uchar>(0, 1) = 20;
@@ -117,3 +117,13 @@ TEST_F(ImageComparerTest, IdenticalMixedPixelTest) {
     EXPECT_EQ(ImageComparer::meanSquareError(image1, image1), 0);
     EXPECT_EQ(ImageComparer::maximumDifference(image1, image1), 0);
 }
+
+TEST_F(ImageComparerTest, NonSquareImageTest) {
+    cv::Mat wideBlackImage = cv::Mat::zeros(cv::Size(5, 2), CV_8UC1);
+    cv::Mat wideWhiteImage(cv::Size(5, 2), CV_8UC1, cv::Scalar(UCHAR_MAX));
+    wideBlackImage.at<uchar>(1, 4) = 55;
+
+    EXPECT_DOUBLE_EQ((9 * pow(255, 2) + pow(200, 2)) / 10, ImageComparer::meanSquareError(wideWhiteImage, wideBlackImage));
+    EXPECT_EQ(255, ImageComparer::maximumDifference(wideWhiteImage, wideBlackImage));
+    EXPECT_EQ(55, ImageComparer::maximumDifference(wideBlackImage, cv::Mat::zeros(cv::Size(5, 2), CV_8UC1)));
+}
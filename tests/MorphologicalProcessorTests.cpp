@@ -3,6 +3,7 @@
 //
 
 #include <gtest/gtest.h>
+#include <queue>
 
 #include "image-processing-lib/MorphologicalProcessor.h"
 
@@ -13,6 +14,47 @@ protected:
         whiteImageGrayscale = cv::Mat(cv::Size(imageWidth, imageHeight), CV_8UC1, cv::Scalar(UCHAR_MAX));
     }
 
+    /**
+     * Dilation or erosion by definition: a white field matches 255 and a black field 0, pixels outside
+     * of the image are 0.
+     */
+    static cv::Mat referenceMorphology(const cv::Mat &image, const std::vector<std::vector<FieldType> > &mask,
+                                       const bool isDilation) {
+        int markerX = 0, markerY = 0;
+        for (int i = static_cast<int>(mask.size()) - 1; i >= 0; i--) {
+            for (int j = static_cast<int>(mask[i].size()) - 1; j >= 0; j--) {
+                if (mask[i][j] == FieldType::WHITE_MARKER || mask[i][j] == FieldType::BLACK_MARKER) {
+                    markerX = i;
+                    markerY = j;
+                }
+            }
+        }
+        cv::Mat result(image.size(), CV_8UC1);
+        for (int x = 0; x < image.rows; x++) {
+            for (int y = 0; y < image.cols; y++) {
+                bool allMatch = true;
+                bool anyMatch = false;
+                for (int i = 0; i < mask.size(); i++) {
+                    for (int j = 0; j < mask[i].size(); j++) {
+                        if (mask[i][j] == FieldType::INACTIVE) {
+                            continue;
+                        }
+                        const int imageX = x + i - markerX;
+                        const int imageY = y + j - markerY;
+                        const bool isInside = imageX >= 0 && imageX < image.rows && imageY >= 0 && imageY < image.cols;
+                        const uchar pixel = isInside ? image.at<uchar>(imageX, imageY) : 0;
+                        const bool isWhite = mask[i][j] == FieldType::WHITE || mask[i][j] == FieldType::WHITE_MARKER;
+                        const bool matches = isWhite ? pixel == 255 : pixel == 0;
+                        allMatch = allMatch && matches;
+                        anyMatch = anyMatch || matches;
+                    }
+                }
+                result.at<uchar>(x, y) = (isDilation ? anyMatch : allMatch) ? 255 : 0;
+            }
+        }
+        return result;
+    }
+
     cv::Mat blackImageGrayscale;
     cv::Mat whiteImageGrayscale;
 
@@ -250,4 +292,229 @@ TEST_F(ImageProcessorTest, HmtTest) {
                 << "Mismatch at pixel (" << x << ", " << y << ")";
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_F(ImageProcessorTest, BitImageTest) {
+    // The masks of Masks.h written out as grids, so that the reference resolves their markers on its own
+    constexpr FieldType W = FieldType::WHITE, B = FieldType::BLACK, WM = FieldType::WHITE_MARKER,
+            BM = FieldType::BLACK_MARKER, I = FieldType::INACTIVE;
+    const std::vector<std::vector<std::vector<FieldType> > > maskGrids = {
+        {{WM, W}},
+        {{WM}, {W}},
+        {{W, W, W}, {W, WM, W}, {W, W, W}},
+        {{I, W, I}, {W, WM, W}, {I, W, I}},
+        {{WM, W}, {W, I}},
+        {{BM, W}, {W, I}},
+        {{W, WM, W}},
+        {{W, BM, W}},
+        {{W, WM}, {W, I}},
+        {{W, W}, {WM, I}}
+    };
+    const std::vector<std::vector<std::vector<FieldType> > > hmtGrids = {
+        {{W, I, I}, {W, BM, I}, {W, I, I}},
+        {{W, W, W}, {I, BM, I}, {I, I, I}},
+        {{I, I, W}, {I, BM, W}, {I, I, W}},
+        {{I, I, I}, {I, BM, I}, {W, W, W}},
+        {{B, B, B}, {I, WM, I}, {W, W, W}},
+        {{I, B, B}, {W, WM, B}, {W, W, I}},
+        {{W, I, B}, {W, WM, B}, {W, I, B}},
+        {{W, W, I}, {W, WM, B}, {I, B, B}},
+        {{W, W, W}, {I, WM, I}, {B, B, B}},
+        {{I, W, W}, {B, WM, W}, {B, B, I}},
+        {{B, I, W}, {B, WM, W}, {B, I, W}},
+        {{B, B, I}, {B, WM, W}, {I, W, W}}
+    };
+
+    // Widths around the word size, so that shifted rows cross word boundaries
+    for (const int cols: {5, 64, 130}) {
+        cv::Mat image(9, cols, CV_8UC1);
+        for (int x = 0; x < image.rows; x++) {
+            for (int y = 0; y < image.cols; y++) {
+                image.at<uchar>(x, y) = (x * 7 + y * 13 + x * y) % 5 < 3 ? 255 : 0;
+            }
+        }
+        const BitImage packed = BitImage::fromMat(image);
+        ASSERT_EQ(image.rows, packed.rows());
+        ASSERT_EQ(cols, packed.cols());
+        EXPECT_TRUE(MorphologicalProcessor::areEqual(image, packed.toMat()));
+
+        for (int maskNumber = 1; maskNumber <= 10; maskNumber++) {
+            const auto &mask = maskGrids[maskNumber - 1];
+            EXPECT_TRUE(MorphologicalProcessor::areEqual(referenceMorphology(image, mask, true),
+                MorphologicalProcessor::dilation(packed, maskNumber).toMat()))
+                << "Dilation mismatch of mask " << maskNumber << " for width " << cols;
+            EXPECT_TRUE(MorphologicalProcessor::areEqual(referenceMorphology(image, mask, false),
+                MorphologicalProcessor::erosion(packed, maskNumber).toMat()))
+                << "Erosion mismatch of mask " << maskNumber << " for width " << cols;
+            EXPECT_TRUE(MorphologicalProcessor::areEqual(
+                referenceMorphology(referenceMorphology(image, mask, false), mask, true),
+                MorphologicalProcessor::opening(packed, maskNumber).toMat()))
+                << "Opening mismatch of mask " << maskNumber << " for width " << cols;
+        }
+        const BitImage complemented = MorphologicalProcessor::complement(packed);
+        for (int maskNumber = 1; maskNumber <= 12; maskNumber++) {
+            // The complement mask swaps white and black fields
+            auto complementMask = hmtGrids[maskNumber - 1];
+            for (auto &row: complementMask) {
+                for (auto &field: row) {
+                    field = field == W ? B : field == B ? W : field == WM ? BM : field == BM ? WM : field;
+                }
+            }
+            const cv::Mat foreground = referenceMorphology(image, hmtGrids[maskNumber - 1], false);
+            const cv::Mat background = referenceMorphology(complemented.toMat(), complementMask, false);
+            const cv::Mat transformed = MorphologicalProcessor::hmt(packed, maskNumber).toMat();
+            for (int x = 0; x < image.rows; x++) {
+                for (int y = 0; y < image.cols; y++) {
+                    EXPECT_EQ(foreground.at<uchar>(x, y) & background.at<uchar>(x, y), transformed.at<uchar>(x, y))
+                        << "HMT mismatch of mask " << maskNumber << " at pixel (" << x << ", " << y << ")";
+                }
+            }
+        }
+
+        // The padding bits stay clear, so a pixel and its complement cover the image exactly once
+        EXPECT_TRUE(MorphologicalProcessor::areEqual(packed, MorphologicalProcessor::complement(complemented)));
+        const BitImage all = MorphologicalProcessor::imagesUnion(packed, complemented);
+        EXPECT_TRUE(MorphologicalProcessor::areEqual(BitImage::fromMat(cv::Mat(image.size(), CV_8UC1, cv::Scalar(255))),
+                                                     all));
+        EXPECT_FALSE(MorphologicalProcessor::areEqual(packed, complemented));
+    }
+
+    EXPECT_THROW(BitImage::fromMat(cv::Mat(2, 2, CV_8UC3)), std::invalid_argument);
+    EXPECT_THROW(MorphologicalProcessor::dilation(BitImage(), 1), std::invalid_argument);
+    EXPECT_THROW(MorphologicalProcessor::imagesUnion(BitImage(2, 3), BitImage(3, 2)), std::invalid_argument);
+}
+
+TEST_F(ImageProcessorTest, StructuringElementTest) {
+    // Offsets are relative to the marker, which does not have to be the first field
+    constexpr Masks::StructuringElement element = maskMap[8];
+    static_assert(element.size == 3);
+    static_assert(element.offsets[0].row == 0 && element.offsets[0].col == -1 && !element.offsets[0].isBlack);
+    static_assert(element.offsets[1].row == 0 && element.offsets[1].col == 0 && !element.offsets[1].isBlack);
+    static_assert(element.offsets[2].row == 1 && element.offsets[2].col == -1 && !element.offsets[2].isBlack);
+    static_assert(hmtMaskMap[0].size == 4 && hmtMaskMap[0].offsets[2].row == 0 && hmtMaskMap[0].offsets[2].col == 0
+                  && hmtMaskMap[0].offsets[2].isBlack);
+
+    // Sets other than those of Masks.h run through the generic kernel
+    static constexpr FieldType customFields[2][4] = {
+        {FieldType::WHITE, FieldType::INACTIVE, FieldType::INACTIVE, FieldType::WHITE},
+        {FieldType::INACTIVE, FieldType::BLACK_MARKER, FieldType::INACTIVE, FieldType::INACTIVE}
+    };
+    static constexpr std::array<Masks::StructuringElement, 2> customMasks = {
+        Masks::makeStructuringElement(customFields),
+        maskMap[2]
+    };
+    const std::vector<std::vector<FieldType> > customGrid = {
+        {customFields[0], customFields[0] + 4},
+        {customFields[1], customFields[1] + 4}
+    };
+    cv::Mat image(7, 70, CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = (x * 3 + y * 5 + x * y) % 7 < 3 ? 255 : 0;
+        }
+    }
+    const BitImage packed = BitImage::fromMat(image);
+    EXPECT_TRUE(MorphologicalProcessor::areEqual(referenceMorphology(image, customGrid, true),
+        MorphologicalProcessor::dilation(packed, 1, customMasks).toMat()));
+    EXPECT_TRUE(MorphologicalProcessor::areEqual(referenceMorphology(image, customGrid, false),
+        MorphologicalProcessor::erosion(image, 1, customMasks)));
+    EXPECT_TRUE(MorphologicalProcessor::areEqual(MorphologicalProcessor::erosion(packed, 3),
+        MorphologicalProcessor::erosion(packed, 2, customMasks)));
+    EXPECT_THROW(MorphologicalProcessor::dilation(packed, 3, customMasks), std::out_of_range);
+}
+
+TEST_F(ImageProcessorTest, ConnectedComponentsTest) {
+    // A "V" whose arms only meet at the bottom, a diagonal line and a single pixel
+    const std::vector<std::string> rows = {
+        "#...#..#",
+        ".#.#..#.",
+        "..#..#..",
+        "........",
+        ".......#",
+    };
+    cv::Mat image = cv::Mat::zeros(static_cast<int>(rows.size()), static_cast<int>(rows[0].size()), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = rows[x][y] == '#' ? 255 : 0;
+        }
+    }
+
+    std::vector<MorphologicalProcessor::ComponentStats> stats;
+    cv::Mat labels = MorphologicalProcessor::connectedComponents(image, stats);
+    ASSERT_EQ(CV_32SC1, labels.type());
+    ASSERT_EQ(3, stats.size());
+    EXPECT_EQ(1, labels.at<int>(0, 0));
+    EXPECT_EQ(1, labels.at<int>(0, 4));
+    EXPECT_EQ(1, labels.at<int>(2, 2));
+    EXPECT_EQ(2, labels.at<int>(0, 7));
+    EXPECT_EQ(2, labels.at<int>(2, 5));
+    EXPECT_EQ(3, labels.at<int>(4, 7));
+    EXPECT_EQ(0, labels.at<int>(3, 3));
+
+    EXPECT_EQ(5, stats[0].area);
+    EXPECT_EQ(0, stats[0].top);
+    EXPECT_EQ(0, stats[0].left);
+    EXPECT_EQ(3, stats[0].height);
+    EXPECT_EQ(5, stats[0].width);
+    EXPECT_DOUBLE_EQ(0.8, stats[0].centroidX);
+    EXPECT_DOUBLE_EQ(2.0, stats[0].centroidY);
+    EXPECT_EQ(3, stats[1].area);
+    EXPECT_DOUBLE_EQ(6.0, stats[1].centroidY);
+    EXPECT_EQ(1, stats[2].area);
+
+    // Compare with a breadth-first flood fill, labels are numbered in the raster order of the components
+    cv::Mat noise(131, 77, CV_8UC1);
+    unsigned int seed = 12345;
+    for (int x = 0; x < noise.rows; x++) {
+        for (int y = 0; y < noise.cols; y++) {
+            seed = seed * 1103515245 + 12345;
+            noise.at<uchar>(x, y) = (seed >> 16) % 100 < 45 ? 255 : 0;
+        }
+    }
+    cv::Mat expected = cv::Mat::zeros(noise.size(), CV_32SC1);
+    int expectedCount = 0;
+    for (int x = 0; x < noise.rows; x++) {
+        for (int y = 0; y < noise.cols; y++) {
+            if (noise.at<uchar>(x, y) == 0 || expected.at<int>(x, y) != 0) {
+                continue;
+            }
+            expected.at<int>(x, y) = ++expectedCount;
+            std::queue<std::pair<int, int> > queue;
+            queue.emplace(x, y);
+            while (!queue.empty()) {
+                const auto [px, py] = queue.front();
+                queue.pop();
+                for (int nx = std::max(0, px - 1); nx <= std::min(noise.rows - 1, px + 1); nx++) {
+                    for (int ny = std::max(0, py - 1); ny <= std::min(noise.cols - 1, py + 1); ny++) {
+                        if (noise.at<uchar>(nx, ny) != 0 && expected.at<int>(nx, ny) == 0) {
+                            expected.at<int>(nx, ny) = expectedCount;
+                            queue.emplace(nx, ny);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    labels = MorphologicalProcessor::connectedComponents(noise, stats);
+    ASSERT_EQ(expectedCount, stats.size());
+    int totalArea = 0;
+    for (const auto &componentStats : stats) {
+        totalArea += componentStats.area;
+    }
+    int foregroundArea = 0;
+    for (int x = 0; x < noise.rows; x++) {
+        for (int y = 0; y < noise.cols; y++) {
+            foregroundArea += noise.at<uchar>(x, y) != 0;
+        }
+    }
+    EXPECT_EQ(foregroundArea, totalArea);
+    for (int x = 0; x < noise.rows; x++) {
+        for (int y = 0; y < noise.cols; y++) {
+            EXPECT_EQ(expected.at<int>(x, y), labels.at<int>(x, y))
+            << "Mismatch at pixel (" << x << ", " << y << ")";
+        }
+    }
+
+    EXPECT_THROW(MorphologicalProcessor::connectedComponents(cv::Mat(), stats), std::invalid_argument);
+}
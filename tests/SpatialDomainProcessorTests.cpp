@@ -3,7 +3,11 @@
 //
 
 #include <gtest/gtest.h>
+#include <sstream>
+#include <image-processing-lib/CpuFeatures.h>
 #include <image-processing-lib/SpatialDomainProcessor.h>
+#include <image-processing-lib/StencilKernels.h>
+#include <image-processing-lib/Threading.h>
 
 class SpatialDomainProcessorTest : public testing::Test {
 protected:
@@ -219,6 +223,34 @@ TEST_F(SpatialDomainProcessorTest, NegativeTest) {
     }
 }
 
+TEST_F(SpatialDomainProcessorTest, ComposeLookupTablesTest) {
+    cv::Mat image(cv::Size(16, 16), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>(x * image.cols + y);
+        }
+    }
+
+    cv::Mat sequentialImage = SpatialDomainProcessor::modifyBrightness(image, 30);
+    sequentialImage = SpatialDomainProcessor::modifyContrastGamma(sequentialImage, 0.7f);
+    sequentialImage = SpatialDomainProcessor::negative(sequentialImage);
+
+    std::array<uchar, UCHAR_MAX + 1> lookupTable = SpatialDomainProcessor::composeLookupTables(
+        SpatialDomainProcessor::brightnessLookupTable(30),
+        SpatialDomainProcessor::contrastGammaLookupTable(0.7f));
+    lookupTable = SpatialDomainProcessor::composeLookupTables(lookupTable,
+                                                              SpatialDomainProcessor::negativeLookupTable());
+    cv::Mat fusedImage = SpatialDomainProcessor::applyLookupTable(image, lookupTable);
+    ASSERT_FALSE(fusedImage.empty()) << "The fusedImage should not be empty.";
+
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            EXPECT_EQ(sequentialImage.at<uchar>(x, y), fusedImage.at<uchar>(x, y))
+                << "Mismatch at pixel (" << x << ", " << y << ")";
+        }
+    }
+}
+
 TEST_F(SpatialDomainProcessorTest, HorizontalFlipTest) {
     blackImageGrayscale.at<uchar>(0, 0) = 1;
     cv::Mat imageAfterFlip = SpatialDomainProcessor::flipHorizontally(blackImageGrayscale);
@@ -265,6 +297,58 @@ TEST_F(SpatialDomainProcessorTest, DiagonalFlipTest) {
     }
 }
 
+TEST_F(SpatialDomainProcessorTest, GeometricTransformTest) {
+    using SpatialDomainProcessor::GeometricTransform;
+    cv::Mat image(cv::Size(70, 45), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>((x * 31 + y * 7) % 256);
+        }
+    }
+    auto expectEqualImages = [](const cv::Mat &expected, const cv::Mat &actual) {
+        ASSERT_EQ(expected.rows, actual.rows);
+        ASSERT_EQ(expected.cols, actual.cols);
+        for (int x = 0; x < expected.rows; x++) {
+            for (int y = 0; y < expected.cols; y++) {
+                EXPECT_EQ(expected.at<uchar>(x, y), actual.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ")";
+            }
+        }
+    };
+
+    cv::Mat transposed = SpatialDomainProcessor::transpose(image);
+    cv::Mat rotated = SpatialDomainProcessor::rotate(image, 90);
+    ASSERT_EQ(image.cols, transposed.rows);
+    ASSERT_EQ(image.rows, transposed.cols);
+    ASSERT_EQ(image.cols, rotated.rows);
+    ASSERT_EQ(image.rows, rotated.cols);
+    for (int x = 0; x < transposed.rows; x++) {
+        for (int y = 0; y < transposed.cols; y++) {
+            EXPECT_EQ(image.at<uchar>(y, x), transposed.at<uchar>(x, y))
+                << "Mismatch at pixel (" << x << ", " << y << ")";
+            EXPECT_EQ(image.at<uchar>(image.rows - 1 - y, x), rotated.at<uchar>(x, y))
+                << "Mismatch at pixel (" << x << ", " << y << ")";
+        }
+    }
+    expectEqualImages(SpatialDomainProcessor::rotate(image, 270), SpatialDomainProcessor::rotate(image, -90));
+    expectEqualImages(SpatialDomainProcessor::flipDiagonally(image), SpatialDomainProcessor::rotate(image, 180));
+    EXPECT_TRUE(GeometricTransform::rotation(360).isIdentity());
+    EXPECT_THROW(GeometricTransform::rotation(45), std::invalid_argument);
+
+    std::vector<GeometricTransform> transforms;
+    for (int i = 0; i < 8; i++) {
+        transforms.push_back({(i & 4) != 0, (i & 2) != 0, (i & 1) != 0});
+    }
+    for (const auto &first : transforms) {
+        for (const auto &second : transforms) {
+            const cv::Mat sequential = SpatialDomainProcessor::applyGeometricTransform(
+                SpatialDomainProcessor::applyGeometricTransform(image, first), second);
+            expectEqualImages(sequential,
+                              SpatialDomainProcessor::applyGeometricTransform(image, first.then(second)));
+        }
+    }
+}
+
 TEST_F(SpatialDomainProcessorTest, ResizeTest) {
     blackImageGrayscale.at<uchar>(0, 0) = 1;
     constexpr float factor = 2;
@@ -294,6 +378,99 @@ TEST_F(SpatialDomainProcessorTest, ResizeTest) {
     }
 }
 
+TEST_F(SpatialDomainProcessorTest, ResizeMethodsTest) {
+    using SpatialDomainProcessor::InterpolationMethod;
+    const cv::Mat constantImage(cv::Size(7, 5), CV_8UC1, cv::Scalar(123));
+    for (const auto method : {InterpolationMethod::NEAREST, InterpolationMethod::BILINEAR,
+                              InterpolationMethod::BICUBIC, InterpolationMethod::LANCZOS, InterpolationMethod::AREA}) {
+        for (const float factor : {0.25f, 0.5f, 1.5f, 3.0f}) {
+            cv::Mat resized = SpatialDomainProcessor::resize(constantImage, factor, method);
+            ASSERT_EQ(static_cast<int>(5 * factor), resized.rows);
+            ASSERT_EQ(static_cast<int>(7 * factor), resized.cols);
+            for (int x = 0; x < resized.rows; x++) {
+                for (int y = 0; y < resized.cols; y++) {
+                    EXPECT_EQ(123, resized.at<uchar>(x, y))
+                        << "Mismatch at pixel (" << x << ", " << y << ") for factor " << factor;
+                }
+            }
+        }
+    }
+
+    cv::Mat image(cv::Size(4, 4), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>(x * 50 + y * 13 + (x * y) % 3);
+        }
+    }
+    cv::Mat areaImage = SpatialDomainProcessor::resize(image, 0.5f, InterpolationMethod::AREA);
+    for (int x = 0; x < areaImage.rows; x++) {
+        for (int y = 0; y < areaImage.cols; y++) {
+            const int sum = image.at<uchar>(2 * x, 2 * y) + image.at<uchar>(2 * x, 2 * y + 1)
+                            + image.at<uchar>(2 * x + 1, 2 * y) + image.at<uchar>(2 * x + 1, 2 * y + 1);
+            EXPECT_EQ((sum + 2) / 4, areaImage.at<uchar>(x, y))
+                << "Mismatch at pixel (" << x << ", " << y << ")";
+        }
+    }
+
+    // A thousand taps per output pixel, the rounding remainder must not pile up on one of them
+    cv::Mat stripes(cv::Size(3000, 1000), CV_8UC1);
+    for (int x = 0; x < stripes.rows; x++) {
+        for (int y = 0; y < stripes.cols; y++) {
+            stripes.at<uchar>(x, y) = static_cast<uchar>(y % 7 * 40);
+        }
+    }
+    cv::Mat shrunkStripes = SpatialDomainProcessor::resize(stripes, 0.001f, InterpolationMethod::AREA);
+    ASSERT_EQ(1, shrunkStripes.rows);
+    ASSERT_EQ(3, shrunkStripes.cols);
+    for (int y = 0; y < shrunkStripes.cols; y++) {
+        double sum = 0;
+        for (int i = y * 1000; i < (y + 1) * 1000; i++) {
+            sum += stripes.at<uchar>(0, i);
+        }
+        EXPECT_NEAR(sum / 1000, shrunkStripes.at<uchar>(0, y), 1) << "Mismatch at column " << y;
+    }
+
+    // A step edge is not averaged out like the stripes, each block has to match its exact box average
+    cv::Mat step(cv::Size(3000, 2000), CV_8UC1);
+    for (int x = 0; x < step.rows; x++) {
+        for (int y = 0; y < step.cols; y++) {
+            step.at<uchar>(x, y) = x < 1310 && y < 1096 ? 255 : 0;
+        }
+    }
+    cv::Mat shrunkStep = SpatialDomainProcessor::resize(step, 0.001f, InterpolationMethod::AREA);
+    ASSERT_EQ(2, shrunkStep.rows);
+    ASSERT_EQ(3, shrunkStep.cols);
+    for (int x = 0; x < shrunkStep.rows; x++) {
+        for (int y = 0; y < shrunkStep.cols; y++) {
+            double sum = 0;
+            for (int i = x * 1000; i < (x + 1) * 1000; i++) {
+                for (int j = y * 1000; j < (y + 1) * 1000; j++) {
+                    sum += step.at<uchar>(i, j);
+                }
+            }
+            EXPECT_NEAR(sum / 1e6, shrunkStep.at<uchar>(x, y), 0.5) << "Mismatch at pixel (" << x << ", " << y << ")";
+        }
+    }
+
+    cv::Mat ramp(cv::Size(4, 2), CV_8UC1);
+    for (int x = 0; x < ramp.rows; x++) {
+        for (int y = 0; y < ramp.cols; y++) {
+            ramp.at<uchar>(x, y) = static_cast<uchar>(y * 40);
+        }
+    }
+    constexpr std::array<int, 8> expectedRamp = {0, 10, 30, 50, 70, 90, 110, 120};
+    cv::Mat bilinearRamp = SpatialDomainProcessor::resize(ramp, 2, InterpolationMethod::BILINEAR);
+    cv::Mat bicubicRamp = SpatialDomainProcessor::resize(ramp, 2, InterpolationMethod::BICUBIC);
+    for (int y = 0; y < bilinearRamp.cols; y++) {
+        EXPECT_EQ(expectedRamp[y], bilinearRamp.at<uchar>(0, y)) << "Mismatch at column " << y;
+        EXPECT_EQ(bilinearRamp.at<uchar>(0, y), bilinearRamp.at<uchar>(3, y)) << "Mismatch at column " << y;
+    }
+    for (int y = 3; y < bicubicRamp.cols - 3; y++) {
+        EXPECT_EQ(expectedRamp[y], bicubicRamp.at<uchar>(1, y)) << "Mismatch at column " << y;
+    }
+    EXPECT_THROW(SpatialDomainProcessor::resize(image, 0), std::invalid_argument);
+}
+
 TEST_F(SpatialDomainProcessorTest, MidpointFilterTest) {
     blackImageGrayscale.at<uchar>(0, 0) = 10;
     cv::Mat imageAfterModification = SpatialDomainProcessor::midpointFilter(blackImageGrayscale, 2);
@@ -305,6 +482,42 @@ TEST_F(SpatialDomainProcessorTest, MidpointFilterTest) {
         << "Mismatch at pixel (" << 0 << ", " << 0 << ")";
 }
 
+TEST_F(SpatialDomainProcessorTest, MinimumMaximumMidpointFilterTest) {
+    cv::Mat image(cv::Size(11, 8), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>((x * 53 + y * 29 + x * y * 7) % 256);
+        }
+    }
+
+    for (int kernelSize = 1; kernelSize <= 6; kernelSize++) {
+        cv::Mat minImage = SpatialDomainProcessor::minimumFilter(image, kernelSize);
+        cv::Mat maxImage = SpatialDomainProcessor::maximumFilter(image, kernelSize);
+        cv::Mat midImage = SpatialDomainProcessor::midpointFilter(image, kernelSize);
+
+        for (int x = 0; x < image.rows; x++) {
+            for (int y = 0; y < image.cols; y++) {
+                int min = UCHAR_MAX;
+                int max = 0;
+                for (int i = std::max(0, x - (kernelSize - 1) / 2); i <= std::min(image.rows - 1, x + kernelSize / 2); i++) {
+                    for (int j = std::max(0, y - (kernelSize - 1) / 2); j <= std::min(image.cols - 1, y + kernelSize / 2); j++) {
+                        min = std::min(min, static_cast<int>(image.at<uchar>(i, j)));
+                        max = std::max(max, static_cast<int>(image.at<uchar>(i, j)));
+                    }
+                }
+                EXPECT_EQ(min, minImage.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") for kernel size " << kernelSize;
+                EXPECT_EQ(max, maxImage.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") for kernel size " << kernelSize;
+                EXPECT_EQ((min + max) / 2, midImage.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") for kernel size " << kernelSize;
+            }
+        }
+    }
+    EXPECT_THROW(SpatialDomainProcessor::minimumFilter(image, 0), std::invalid_argument);
+    EXPECT_THROW(SpatialDomainProcessor::maximumFilter(image, 0), std::invalid_argument);
+}
+
 TEST_F(SpatialDomainProcessorTest, ArithmeticMeanFilterTest) {
     blackImageGrayscale.at<uchar>(0, 0) = 10;
     blackImageGrayscale.at<uchar>(0, 1) = 10;
@@ -317,6 +530,130 @@ TEST_F(SpatialDomainProcessorTest, ArithmeticMeanFilterTest) {
         << "Mismatch at pixel (" << 0 << ", " << 0 << ")";
 }
 
+TEST_F(SpatialDomainProcessorTest, ArithmeticMeanFilterBorderTest) {
+    cv::Mat image(cv::Size(9, 7), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>((x * 37 + y * 91) % 256);
+        }
+    }
+
+    for (int kernelSize = 1; kernelSize <= 5; kernelSize++) {
+        cv::Mat imageAfterModification = SpatialDomainProcessor::arithmeticMeanFilter(image, kernelSize);
+        ASSERT_FALSE(imageAfterModification.empty()) << "The imageAfterModification should not be empty.";
+
+        for (int x = 0; x < image.rows; x++) {
+            for (int y = 0; y < image.cols; y++) {
+                int sum = 0;
+                int count = 0;
+                for (int i = x - (kernelSize - 1) / 2; i <= x + kernelSize / 2; i++) {
+                    for (int j = y - (kernelSize - 1) / 2; j <= y + kernelSize / 2; j++) {
+                        if (i >= 0 && i < image.rows && j >= 0 && j < image.cols) {
+                            sum += image.at<uchar>(i, j);
+                            count++;
+                        }
+                    }
+                }
+                EXPECT_EQ(sum / count, imageAfterModification.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") for kernel size " << kernelSize;
+            }
+        }
+    }
+    EXPECT_THROW(SpatialDomainProcessor::arithmeticMeanFilter(image, 0), std::invalid_argument);
+}
+
+TEST_F(SpatialDomainProcessorTest, ConvolveTest) {
+    auto referenceIndex = [](int position, const int length, const SpatialDomainProcessor::BorderType borderType) {
+        switch (borderType) {
+            case SpatialDomainProcessor::BorderType::CONSTANT:
+                return position >= 0 && position < length ? position : -1;
+            case SpatialDomainProcessor::BorderType::REPLICATE:
+                return std::clamp(position, 0, length - 1);
+            case SpatialDomainProcessor::BorderType::REFLECT:
+                while (position < 0 || position >= length) {
+                    position = position < 0 ? -position : 2 * (length - 1) - position;
+                }
+                return position;
+            case SpatialDomainProcessor::BorderType::WRAP:
+            default:
+                return (position % length + length) % length;
+        }
+    };
+    auto referenceConvolve = [&](const cv::Mat &image, const cv::Mat &kernel,
+                                 const SpatialDomainProcessor::BorderType borderType) {
+        cv::Mat result(image.rows, image.cols, CV_8UC1);
+        for (int x = 0; x < image.rows; x++) {
+            for (int y = 0; y < image.cols; y++) {
+                double sum = 0;
+                for (int i = 0; i < kernel.rows; i++) {
+                    for (int j = 0; j < kernel.cols; j++) {
+                        const int srcX = referenceIndex(x + kernel.rows / 2 - i, image.rows, borderType);
+                        const int srcY = referenceIndex(y + kernel.cols / 2 - j, image.cols, borderType);
+                        if (srcX >= 0 && srcY >= 0) {
+                            sum += kernel.at<double>(i, j) * image.at<uchar>(srcX, srcY);
+                        }
+                    }
+                }
+                result.at<uchar>(x, y) = static_cast<uchar>(std::clamp(std::round(sum), 0.0, 255.0));
+            }
+        }
+        return result;
+    };
+    auto expectEqualImages = [](const cv::Mat &expected, const cv::Mat &actual, const std::string &name) {
+        ASSERT_EQ(expected.rows, actual.rows);
+        ASSERT_EQ(expected.cols, actual.cols);
+        for (int x = 0; x < expected.rows; x++) {
+            for (int y = 0; y < expected.cols; y++) {
+                EXPECT_EQ(expected.at<uchar>(x, y), actual.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") for " << name;
+            }
+        }
+    };
+
+    cv::Mat image(cv::Size(13, 9), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>((x * 41 + y * 17 + x * y) % 64);
+        }
+    }
+    std::istringstream sobelStream("1 0 -1\n2 0 -2\n1 0 -1\n");
+    const cv::Mat separableKernel = SpatialDomainProcessor::parseKernel(sobelStream);
+    std::istringstream asymmetricStream("0 1\n\n2 -1\n1 0\n");
+    const cv::Mat asymmetricKernel = SpatialDomainProcessor::parseKernel(asymmetricStream);
+    ASSERT_EQ(3, asymmetricKernel.rows);
+    ASSERT_EQ(2, asymmetricKernel.cols);
+
+    for (const auto borderType : {SpatialDomainProcessor::BorderType::CONSTANT,
+                                  SpatialDomainProcessor::BorderType::REPLICATE,
+                                  SpatialDomainProcessor::BorderType::REFLECT,
+                                  SpatialDomainProcessor::BorderType::WRAP}) {
+        expectEqualImages(referenceConvolve(image, separableKernel, borderType),
+                          SpatialDomainProcessor::convolve(image, separableKernel, borderType), "separable kernel");
+        expectEqualImages(referenceConvolve(image, asymmetricKernel, borderType),
+                          SpatialDomainProcessor::convolve(image, asymmetricKernel, borderType), "asymmetric kernel");
+    }
+
+    cv::Mat largeImage(cv::Size(64, 48), CV_8UC1);
+    for (int x = 0; x < largeImage.rows; x++) {
+        for (int y = 0; y < largeImage.cols; y++) {
+            largeImage.at<uchar>(x, y) = static_cast<uchar>((x * 13 + y * 7 + x * y * 3) % 100);
+        }
+    }
+    cv::Mat largeKernel = cv::Mat::zeros(31, 31, CV_64FC1);
+    largeKernel.at<double>(0, 0) = 1;
+    largeKernel.at<double>(30, 12) = 2;
+    largeKernel.at<double>(15, 15) = -1;
+    largeKernel.at<double>(7, 29) = 1;
+    expectEqualImages(referenceConvolve(largeImage, largeKernel, SpatialDomainProcessor::BorderType::REFLECT),
+                      SpatialDomainProcessor::convolve(largeImage, largeKernel,
+                                                       SpatialDomainProcessor::BorderType::REFLECT), "large kernel");
+
+    std::istringstream raggedStream("1 2\n3\n");
+    EXPECT_THROW(SpatialDomainProcessor::parseKernel(raggedStream), std::invalid_argument);
+    std::istringstream invalidStream("1 x\n");
+    EXPECT_THROW(SpatialDomainProcessor::parseKernel(invalidStream), std::invalid_argument);
+}
+
 TEST_F(SpatialDomainProcessorTest, LaplacianFilterGrayscaleTest) {
     largerBlackImageGrayscale.at<uchar>(0, 1) = 20;
     largerBlackImageGrayscale.at<uchar>(1, 0) = 20;
@@ -410,6 +747,76 @@ TEST_F(SpatialDomainProcessorTest, RobertsOperator1GrayscaleTest) {
     EXPECT_EQ(0, imageAfterModification.at<uchar>(2, 2));
 }
 
+TEST_F(SpatialDomainProcessorTest, EdgeStencilsTest) {
+    cv::Mat image(cv::Size(70, 37), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>((x * 73 + y * 151 + x * y * 7) % 256);
+        }
+    }
+    auto pixel = [&image](const int x, const int y) {
+        return x >= 0 && x < image.rows && y >= 0 && y < image.cols ? image.at<uchar>(x, y) : 0;
+    };
+
+    for (int maskNumber = 0; maskNumber < 3; maskNumber++) {
+        const auto &mask = StencilKernels::LAPLACIAN_MASKS[maskNumber];
+        const cv::Mat filtered = SpatialDomainProcessor::laplacianFilter(image, maskNumber);
+        for (int x = 0; x < image.rows; x++) {
+            for (int y = 0; y < image.cols; y++) {
+                int sum = 0;
+                for (int i = -1; i <= 1; i++) {
+                    for (int j = -1; j <= 1; j++) {
+                        sum += mask[i + 1][j + 1] * pixel(x + i, y + j);
+                    }
+                }
+                EXPECT_EQ(std::min(std::abs(sum), 255), filtered.at<uchar>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") for mask " << maskNumber;
+            }
+        }
+    }
+
+    const cv::Mat roberts = SpatialDomainProcessor::robertsOperator1(image);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            int expected = image.at<uchar>(x, y);
+            if (x + 1 < image.rows && y + 1 < image.cols) {
+                const int diff1 = pixel(x, y) - pixel(x + 1, y + 1);
+                const int diff2 = pixel(x, y + 1) - pixel(x + 1, y);
+                expected = std::min(static_cast<int>(std::round(std::sqrt(diff1 * diff1 + diff2 * diff2))), 255);
+            }
+            EXPECT_EQ(expected, roberts.at<uchar>(x, y)) << "Mismatch at pixel (" << x << ", " << y << ")";
+        }
+    }
+
+    // Every kernel the library was built with and the processor supports has to match the scalar one
+    for (const auto type : {StencilKernels::StencilType::LAPLACIAN_0, StencilKernels::StencilType::LAPLACIAN_1,
+                            StencilKernels::StencilType::LAPLACIAN_2, StencilKernels::StencilType::ROBERTS_CROSS}) {
+        const auto scalarRow = StencilKernels::detail::rowFunction<StencilKernels::detail::ScalarLanes>(type);
+        for (const auto &[level, simdRow] : {
+                 std::pair(CpuFeatures::SimdLevel::SSE4, StencilKernels::sse4RowFunction(type)),
+                 std::pair(CpuFeatures::SimdLevel::AVX2, StencilKernels::avx2RowFunction(type))
+             }) {
+            if (simdRow == nullptr || CpuFeatures::simdLevel() < level) {
+                continue;
+            }
+            std::vector<uchar> expected(image.cols);
+            std::vector<uchar> actual(image.cols);
+            // Whole rows and rows shorter than a single vector step
+            for (const int end : {image.cols - 1, 6}) {
+                for (int x = 1; x + 1 < image.rows; x++) {
+                    scalarRow(image.ptr<uchar>(x - 1), image.ptr<uchar>(x), image.ptr<uchar>(x + 1),
+                              expected.data(), 1, end);
+                    simdRow(image.ptr<uchar>(x - 1), image.ptr<uchar>(x), image.ptr<uchar>(x + 1), actual.data(),
+                            1, end);
+                    for (int y = 1; y < end; y++) {
+                        EXPECT_EQ(expected[y], actual[y]) << "Mismatch at pixel (" << x << ", " << y << ")";
+                    }
+                }
+            }
+        }
+    }
+}
+
 TEST_F(SpatialDomainProcessorTest, RegionGrowingGrayscaleTest) {
     cv::Mat image = cv::Mat::zeros(cv::Size(40, 40), CV_8UC1);
     image.at<uchar>(20, 19) = 99;
@@ -421,11 +828,11 @@ TEST_F(SpatialDomainProcessorTest, RegionGrowingGrayscaleTest) {
         for (int x = 0; x < image.rows; x++) {
             for (int y = 0; y < image.cols; y++) {
                 if ((x == 20 && y == 20) || (x == 20 && y == 19)) {
-                    EXPECT_EQ(2, segmentationMasks.at<uchar>(x, y));
+                    EXPECT_EQ(2, segmentationMasks.at<int>(x, y));
                 } else if (x == 20 && y == 21) {
-                    EXPECT_EQ(0, segmentationMasks.at<uchar>(x, y));
+                    EXPECT_EQ(0, segmentationMasks.at<int>(x, y));
                 } else {
-                    EXPECT_EQ(1, segmentationMasks.at<uchar>(x, y));
+                    EXPECT_EQ(1, segmentationMasks.at<int>(x, y));
                 }
             }
         }
@@ -443,13 +850,87 @@ TEST_F(SpatialDomainProcessorTest, RegionGrowingTest) {
         for (int x = 0; x < image.rows; x++) {
             for (int y = 0; y < image.cols; y++) {
                 if ((x == 20 && y == 20) || (x == 20 && y == 19)) {
-                    EXPECT_EQ(2, segmentationMasks.at<uchar>(x, y));
+                    EXPECT_EQ(2, segmentationMasks.at<int>(x, y));
                 } else if (x == 20 && y == 21) {
-                    EXPECT_EQ(0, segmentationMasks.at<uchar>(x, y));
+                    EXPECT_EQ(0, segmentationMasks.at<int>(x, y));
                 } else {
-                    EXPECT_EQ(1, segmentationMasks.at<uchar>(x, y));
+                    EXPECT_EQ(1, segmentationMasks.at<int>(x, y));
+                }
+            }
+        }
+    }
+}
+
+TEST_F(SpatialDomainProcessorTest, RegionGrowingStripesTest) {
+    cv::Mat image(cv::Size(200, 200), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>(y / 20 * 25 + (x + y) % 3);
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        cv::Mat segmentationMasks = SpatialDomainProcessor::regionGrowing<uchar>(image, i);
+        ASSERT_EQ(CV_32SC1, segmentationMasks.type());
+        for (int x = 0; x < image.rows; x++) {
+            for (int y = 0; y < image.cols; y++) {
+                const int expectedLabel = y / 20 < 9 ? y / 20 : 0;
+                EXPECT_EQ(expectedLabel, segmentationMasks.at<int>(x, y))
+                    << "Mismatch at pixel (" << x << ", " << y << ") for criterion " << i;
+            }
+        }
+    }
+    EXPECT_THROW(SpatialDomainProcessor::regionGrowing<uchar>(image, 3), std::invalid_argument);
+
+    const cv::Mat smallImage = cv::Mat::zeros(cv::Size(5, 5), CV_8UC1);
+    cv::Mat smallMasks = SpatialDomainProcessor::regionGrowing<uchar>(smallImage, 1);
+    EXPECT_EQ(1, smallMasks.at<int>(0, 0));
+    EXPECT_EQ(1, smallMasks.at<int>(4, 4));
+}
+
+TEST_F(SpatialDomainProcessorTest, ApplyColorMapTest) {
+    cv::Mat labels(1, 4, CV_32SC1);
+    labels.at<int>(0, 0) = 0;
+    labels.at<int>(0, 1) = 1;
+    labels.at<int>(0, 2) = 2;
+    labels.at<int>(0, 3) = 3;
+    const std::vector colorMap = {cv::Vec3b(0, 0, 0), cv::Vec3b(10, 20, 30), cv::Vec3b(40, 50, 60)};
+
+    const cv::Mat colorMask = SpatialDomainProcessor::applyColorMap(labels, colorMap);
+    EXPECT_EQ(colorMap[0], colorMask.at<cv::Vec3b>(0, 0));
+    EXPECT_EQ(colorMap[1], colorMask.at<cv::Vec3b>(0, 1));
+    EXPECT_EQ(colorMap[2], colorMask.at<cv::Vec3b>(0, 2));
+    // Labels beyond the color map skip the background color
+    EXPECT_EQ(colorMap[1], colorMask.at<cv::Vec3b>(0, 3));
+
+    EXPECT_THROW(SpatialDomainProcessor::applyColorMap(labels, {cv::Vec3b(0, 0, 0)}), std::invalid_argument);
+    EXPECT_THROW(SpatialDomainProcessor::applyColorMap(labels, {}), std::invalid_argument);
+}
+
+TEST_F(SpatialDomainProcessorTest, RegionGrowingThreadCountTest) {
+    // Tall enough for more strips than seed rows
+    cv::Mat image(cv::Size(173, 411), CV_8UC1);
+    for (int x = 0; x < image.rows; x++) {
+        for (int y = 0; y < image.cols; y++) {
+            image.at<uchar>(x, y) = static_cast<uchar>((x / 15 * 37 + y / 23 * 53 + (x * y) % 7) % 256);
+        }
+    }
+
+    const int threadCount = Threading::getThreadCount();
+    for (int i = 0; i < 3; i++) {
+        Threading::setThreadCount(1);
+        const cv::Mat expected = SpatialDomainProcessor::regionGrowing<uchar>(image, i);
+        for (const int threads: {2, 3, 8}) {
+            Threading::setThreadCount(threads);
+            const cv::Mat segmentationMasks = SpatialDomainProcessor::regionGrowing<uchar>(image, i);
+            for (int x = 0; x < image.rows; x++) {
+                for (int y = 0; y < image.cols; y++) {
+                    EXPECT_EQ(expected.at<int>(x, y), segmentationMasks.at<int>(x, y))
+                        << "Mismatch at pixel (" << x << ", " << y << ") for criterion " << i << " and "
+                        << threads << " threads";
                 }
             }
         }
     }
+    Threading::setThreadCount(threadCount);
 }
@@ -0,0 +1,149 @@
+//
+// Created by gluckasz on 10/18/26.
+//
+
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include <operations/channel-operations/BandCutOperation.h>
+#include <operations/channel-operations/FusedSpectralOperation.h>
+#include <operations/channel-operations/HighPassDirectionOperation.h>
+#include <operations/channel-operations/HighPassOperation.h>
+#include <operations/channel-operations/LowPassOperation.h>
+#include <operations/channel-operations/NegativeOperation.h>
+#include <operations/channel-operations/PhaseShiftOperation.h>
+
+class SpectralOperationTest : public testing::Test {
+protected:
+    static constexpr auto precision = FourierProcessor::FFTPrecision::DOUBLE;
+
+    static cv::Mat createImage(const int rows, const int cols, const int seed) {
+        cv::Mat image(rows, cols, CV_8UC1);
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < cols; y++) {
+                image.at<uchar>(x, y) = static_cast<uchar>((x * 37 + y * 91 + x * y * (13 + seed)) % 256);
+            }
+        }
+        return image;
+    }
+
+    static int maxDifference(const cv::Mat &first, const cv::Mat &second) {
+        EXPECT_EQ(first.size(), second.size());
+        int difference = 0;
+        for (int x = 0; x < first.rows; x++) {
+            for (int y = 0; y < first.cols; y++) {
+                difference = std::max(difference, std::abs(first.at<uchar>(x, y) - second.at<uchar>(x, y)));
+            }
+        }
+        return difference;
+    }
+};
+
+TEST_F(SpectralOperationTest, FusedFullSpectrumChainTest) {
+    const cv::Mat image = createImage(21, 34, 0);
+
+    std::vector<std::unique_ptr<SpectralOperation> > operations;
+    operations.emplace_back(
+        std::make_unique<BandCutOperation>(4, 9, FourierProcessor::FilterShape::IDEAL, 2, precision));
+    operations.emplace_back(std::make_unique<PhaseShiftOperation>(3, 5, precision));
+    const FusedSpectralOperation fused(std::move(operations), precision);
+    cv::Mat result = image.clone();
+    fused.apply(result);
+
+    // Both stages modify the same spectrum, which is transformed back (and quantized) once
+    cv::Mat spectrum = FourierProcessor::fastFourierTransform(image, false, precision);
+    spectrum = FourierProcessor::fftBandCut(spectrum, 4, 9);
+    spectrum = FourierProcessor::fftPhaseModifying(spectrum, 3, 5);
+    const cv::Mat expected = FourierProcessor::inverseFastFourierTransform(spectrum);
+
+    EXPECT_EQ(0, maxDifference(expected, result));
+}
+
+TEST_F(SpectralOperationTest, FusedHalfSpectrumChainTest) {
+    const cv::Mat image = createImage(21, 34, 0);
+
+    std::vector<std::unique_ptr<SpectralOperation> > operations;
+    operations.emplace_back(
+        std::make_unique<LowPassOperation>(12, FourierProcessor::FilterShape::BUTTERWORTH, 2, precision));
+    operations.emplace_back(
+        std::make_unique<HighPassOperation>(3, FourierProcessor::FilterShape::GAUSSIAN, 2, precision));
+    const FusedSpectralOperation fused(std::move(operations), precision);
+    cv::Mat result = image.clone();
+    fused.apply(result);
+
+    FourierProcessor::HalfSpectrum spectrum = FourierProcessor::realFastFourierTransform(image, false, precision);
+    spectrum = FourierProcessor::fftLowPass(spectrum, 12, FourierProcessor::FilterShape::BUTTERWORTH, 2);
+    spectrum = FourierProcessor::fftHighPass(spectrum, 3, FourierProcessor::FilterShape::GAUSSIAN, 2);
+    const cv::Mat expected = FourierProcessor::inverseRealFastFourierTransform(spectrum);
+
+    EXPECT_EQ(0, maxDifference(expected, result));
+}
+
+TEST_F(SpectralOperationTest, HalfSpectrumBatchMatchesFullSpectrumTest) {
+    const std::vector channels = {createImage(21, 34, 0), createImage(21, 34, 1), createImage(21, 34, 2)};
+
+    const LowPassOperation lowPass(12, FourierProcessor::FilterShape::BUTTERWORTH, 2, precision);
+    const BandCutOperation bandCut(4, 9, FourierProcessor::FilterShape::IDEAL, 2, precision);
+    ASSERT_FALSE(lowPass.needsFullSpectrum());
+    ASSERT_FALSE(bandCut.needsFullSpectrum());
+    std::vector<cv::Mat> result = {channels[0].clone(), channels[1].clone(), channels[2].clone()};
+    SpectralOperation::applyInFrequencyDomain(result, {&lowPass, &bandCut}, precision);
+
+    ASSERT_EQ(channels.size(), result.size());
+    for (size_t i = 0; i < channels.size(); i++) {
+        cv::Mat spectrum = FourierProcessor::fastFourierTransform(channels[i], false, precision);
+        spectrum = FourierProcessor::fftLowPass(spectrum, 12, FourierProcessor::FilterShape::BUTTERWORTH, 2);
+        spectrum = FourierProcessor::fftBandCut(spectrum, 4, 9);
+        const cv::Mat expected = FourierProcessor::inverseFastFourierTransform(spectrum);
+        EXPECT_LE(maxDifference(expected, result[i]), 1) << "channel " << i;
+    }
+}
+
+TEST_F(SpectralOperationTest, HighPassDirectionOperationTest) {
+    const std::vector channels = {createImage(21, 34, 0), createImage(21, 34, 1)};
+
+    // A single angle is a half spectrum operation and matches the batched directional filter
+    const HighPassDirectionOperation highPassDirection(2, 30, 20, FourierProcessor::FilterShape::BUTTERWORTH, 3,
+                                                       precision);
+    ASSERT_FALSE(highPassDirection.needsFullSpectrum());
+    std::vector<cv::Mat> result = {channels[0].clone(), channels[1].clone()};
+    highPassDirection.applyToChannels(result);
+
+    const std::vector<std::vector<cv::Mat> > expected =
+            FourierProcessor::highPassDirections(channels, 2, {30}, 20, FourierProcessor::FilterShape::BUTTERWORTH, 3,
+                                                 precision);
+    ASSERT_EQ(1, expected.size());
+    for (size_t c = 0; c < channels.size(); c++) {
+        EXPECT_LE(maxDifference(expected.front()[c], result[c]), 1) << "channel " << c;
+    }
+}
+
+TEST_F(SpectralOperationTest, FuseConsecutiveOperationsTest) {
+    std::vector<std::unique_ptr<ImageOperation> > operations;
+    operations.emplace_back(
+        std::make_unique<BandCutOperation>(4, 9, FourierProcessor::FilterShape::IDEAL, 2, precision));
+    operations.emplace_back(std::make_unique<PhaseShiftOperation>(3, 5, precision));
+    operations.emplace_back(std::make_unique<NegativeOperation>());
+    operations.emplace_back(
+        std::make_unique<LowPassOperation>(12, FourierProcessor::FilterShape::IDEAL, 2, precision));
+    operations.emplace_back(
+        std::make_unique<HighPassOperation>(3, FourierProcessor::FilterShape::IDEAL, 2, precision));
+    operations.emplace_back(std::make_unique<BandCutOperation>(1, 2, FourierProcessor::FilterShape::IDEAL, 2,
+                                                               precision));
+    operations.emplace_back(std::make_unique<NegativeOperation>());
+    operations.emplace_back(std::make_unique<PhaseShiftOperation>(1, 1, precision));
+
+    const std::vector<std::unique_ptr<ImageOperation> > fused = FusedSpectralOperation::fuse(std::move(operations));
+
+    ASSERT_EQ(5, fused.size());
+    const auto *first = dynamic_cast<const FusedSpectralOperation *>(fused[0].get());
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(2, first->size());
+    EXPECT_NE(nullptr, dynamic_cast<const NegativeOperation *>(fused[1].get()));
+    const auto *second = dynamic_cast<const FusedSpectralOperation *>(fused[2].get());
+    ASSERT_NE(nullptr, second);
+    EXPECT_EQ(3, second->size());
+    EXPECT_NE(nullptr, dynamic_cast<const NegativeOperation *>(fused[3].get()));
+    // A single spectral operation is kept as it is
+    EXPECT_NE(nullptr, dynamic_cast<const PhaseShiftOperation *>(fused[4].get()));
+}